@@ -29,6 +29,9 @@ FlipWorldApp::FlipWorldApp()
         FURI_LOG_E(TAG, "Failed to allocate FlipperHTTP");
         return;
     }
+#ifdef FLIPPER_HTTP_BENCHMARK
+    flipper_http_rx_benchmark(64 * 1024, nullptr, nullptr);
+#endif
 
     createAppDataPath(APP_ID);
     createAppDataPath("flipper_http");
@@ -275,6 +278,32 @@ bool FlipWorldApp::httpRequestAsync(
     return true;
 }
 
+bool FlipWorldApp::httpRequestQueued(
+    const char *saveLocation,
+    const char *url,
+    FlipperHTTPRequestCallback callback,
+    void *context,
+    HTTPMethod method,
+    const char *headers,
+    const char *payload,
+    uint32_t timeoutMs)
+{
+    if (!flipperHttp)
+    {
+        FURI_LOG_E(TAG, "FlipWorldApp::httpRequestQueued: FlipperHTTP is NULL");
+        return false;
+    }
+    char file_path[HTTP_QUEUE_PATH_SIZE];
+    snprintf(file_path, sizeof(file_path), STORAGE_EXT_PATH_PREFIX "/apps_data/%s/data/%s", APP_ID, saveLocation);
+    if (!flipper_http_queue_request(flipperHttp, method, url, headers, payload, file_path,
+                                    HTTP_RESPONSE_RAM_SIZE, timeoutMs, callback, context))
+    {
+        FURI_LOG_E(TAG, "FlipWorldApp::httpRequestQueued: Failed to queue HTTP request");
+        return false;
+    }
+    return true;
+}
+
 bool FlipWorldApp::isBoardConnected()
 {
     if (!flipperHttp)
@@ -304,11 +333,16 @@ bool FlipWorldApp::isBoardConnected()
 
 bool FlipWorldApp::loadChar(const char *path_name, char *value, size_t value_size, const char *appId)
 {
-    Storage *storage = static_cast<Storage *>(furi_record_open(RECORD_STORAGE));
-    File *file = storage_file_alloc(storage);
     char file_path[256];
     snprintf(file_path, sizeof(file_path), STORAGE_EXT_PATH_PREFIX "/apps_data/%s/data/%s.txt", appId, path_name);
-    if (!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING))
+    return loadFile(file_path, value, value_size);
+}
+
+bool FlipWorldApp::loadFile(const char *filePath, char *value, size_t value_size)
+{
+    Storage *storage = static_cast<Storage *>(furi_record_open(RECORD_STORAGE));
+    File *file = storage_file_alloc(storage);
+    if (!storage_file_open(file, filePath, FSAM_READ, FSOM_OPEN_EXISTING))
     {
         storage_file_free(file);
         furi_record_close(RECORD_STORAGE);
@@ -334,6 +368,31 @@ bool FlipWorldApp::loadChar(const char *path_name, char *value, size_t value_siz
     return strlen(value) > 0;
 }
 
+bool FlipWorldApp::loadJsonFile(const char *filePath, JsonStream *stream)
+{
+    Storage *storage = static_cast<Storage *>(furi_record_open(RECORD_STORAGE));
+    File *file = storage_file_alloc(storage);
+    if (!storage_file_open(file, filePath, FSAM_READ, FSOM_OPEN_EXISTING))
+    {
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    // the parser keeps its own state, so only one small chunk is ever in RAM
+    char chunk[64];
+    bool ok = true;
+    size_t read_count;
+    while (ok && (read_count = storage_file_read(file, chunk, sizeof(chunk))) > 0)
+    {
+        ok = json_stream_feed(stream, chunk, read_count);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok && json_stream_finish(stream);
+}
+
 bool FlipWorldApp::loadFileChunk(const char *filePath, char *buffer, size_t sizeOfChunk, uint8_t iteration)
 {
     if (!filePath || !buffer || sizeOfChunk == 0)
@@ -414,6 +473,35 @@ bool FlipWorldApp::loadFileChunk(const char *filePath, char *buffer, size_t size
     return read_count > 0;
 }
 
+bool FlipWorldApp::loadResponse(const FlipperHTTPResponse *response, char *value, size_t value_size)
+{
+    if (!response || !value || value_size == 0 || response->result != FlipperHTTPRequestOk)
+    {
+        return false;
+    }
+    if (response->body)
+    {
+        size_t count = response->body_len < value_size - 1 ? response->body_len : value_size - 1;
+        memcpy(value, response->body, count);
+        value[count] = '\0';
+        return count > 0;
+    }
+    return loadFile(response->file_path, value, value_size);
+}
+
+bool FlipWorldApp::loadResponseJson(const FlipperHTTPResponse *response, JsonStream *stream)
+{
+    if (!response || !stream || response->result != FlipperHTTPRequestOk)
+    {
+        return false;
+    }
+    if (response->body)
+    {
+        return json_stream_feed(stream, response->body, response->body_len) && json_stream_finish(stream);
+    }
+    return loadJsonFile(response->file_path, stream);
+}
+
 void FlipWorldApp::runDispatcher()
 {
     view_dispatcher_run(viewDispatcher);
@@ -547,6 +635,16 @@ bool FlipWorldApp::websocketSend(const char *message)
     return flipper_http_send_data(flipperHttp, message);
 }
 
+FlipperHTTPTxStatus FlipWorldApp::websocketSendAsync(const char *message)
+{
+    if (!flipperHttp)
+    {
+        FURI_LOG_E(TAG, "FlipperHTTP is not initialized");
+        return FlipperHTTPTxRejected;
+    }
+    return flipper_http_send_data_async(flipperHttp, message);
+}
+
 bool FlipWorldApp::websocketStart(const char *url)
 {
     if (!flipperHttp)
@@ -2,6 +2,7 @@
 #include "font/font.h"
 #include "easy_flipper/easy_flipper.h"
 #include "flipper_http/flipper_http.h"
+#include "jsmn/jsmn_stream.h"
 #include "run/run.hpp"
 #include "settings/settings.hpp"
 #include "about/about.hpp"
@@ -10,6 +11,8 @@
 #define VERSION "1.0.2"
 #define VERSION_TAG TAG " " VERSION
 #define APP_ID "flip_world"
+#define HTTP_RESPONSE_RAM_SIZE 2048 // queued responses announced smaller than this are received into RAM instead of their file
+#define HTTP_REQUEST_TIMEOUT_MS 5000 // silence after which a queued request fails
 
 typedef enum
 {
@@ -40,6 +43,8 @@ private:
     static uint32_t callbackExitApp(void *context);                    // Callback to exit the app
     void callbackSubmenuChoices(uint32_t index);                       // Callback for submenu choices
     void createAppDataPath(const char *appId = APP_ID);                // Create the app data path in storage
+    bool loadFile(const char *filePath, char *value, size_t value_size);          // Read a stored response into value
+    bool loadJsonFile(const char *filePath, JsonStream *stream);                  // Feed a stored file through a streaming parser in small chunks
     void settingsItemSelected(uint32_t index);                         // Handle settings item selection
     static void submenuChoicesCallback(void *context, uint32_t index); // Callback for submenu choices
     static void timerCallback(void *context);                          // Timer callback for run updates
@@ -71,16 +76,34 @@ public:
         HTTPMethod method = GET,                                                                                // HTTP method to use (GET, POST, etc.)
         const char *headers = "{\"Content-Type\": \"application/json\"}",                                       // Headers to include in the request
         const char *payload = nullptr);                                                                         // Payload to send with the request (for POST, PUT, etc.)
+    void httpCancel(void *context) noexcept { if (flipperHttp) flipper_http_queue_cancel(flipperHttp, context); } // drop the callbacks of queued requests made with context
+    size_t httpPoll() noexcept { return flipperHttp ? flipper_http_queue_poll(flipperHttp) : 0; }               // run the callbacks of finished queued requests (call once per frame)
+    bool httpRequestQueued(                                                                                     // queued HTTP request (sent as soon as the previous one ends; the callback runs from httpPoll)
+        const char *saveLocation,                                                                               // location to save the response (filename) when it is not kept in RAM
+        const char *url,                                                                                        // URL to send the request to
+        FlipperHTTPRequestCallback callback,                                                                    // called with the response (may be NULL)
+        void *context,                                                                                          // context for the callback
+        HTTPMethod method = GET,                                                                                // HTTP method to use (GET, POST, PUT or DELETE)
+        const char *headers = "{\"Content-Type\": \"application/json\"}",                                       // Headers to include in the request
+        const char *payload = nullptr,                                                                          // Payload to send with the request (for POST, PUT, etc.)
+        uint32_t timeoutMs = HTTP_REQUEST_TIMEOUT_MS);                                                          // silence after which the request fails
     bool isBoardConnected();                                                                                    // check if the board is connected
     bool loadChar(const char *path_name, char *value, size_t value_size, const char *appId = APP_ID);           // load a string from storage
     bool loadFileChunk(const char *filePath, char *buffer, size_t sizeOfChunk, uint8_t iteration);              // Load a file chunk from storage
+    bool loadResponse(const FlipperHTTPResponse *response, char *value, size_t value_size);                    // load the body of a queued request's response
+    bool loadResponseJson(const FlipperHTTPResponse *response, JsonStream *stream);                            // feed the body of a queued request's response through a streaming parser
     void runDispatcher();                                                                                       // run the app's view dispatcher to handle views and events
     bool saveChar(const char *path_name, const char *value, const char *appId = APP_ID);                        // save a string to storage
     bool setHttpState(HTTPState state = IDLE) noexcept;                                                         // set the HTTP state
     bool sendWiFiCredentials(const char *ssid, const char *password);                                           // send WiFi credentials to the board
     static void viewPortDraw(Canvas *canvas, void *context);                                                    // draw callback for the ViewPort (used in run instance)
     static void viewPortInput(InputEvent *event, void *context);                                                // input callback for the ViewPort (used in run instance)
+    uint32_t uartTxBusyMs() const noexcept { return flipperHttp ? flipper_http_tx_busy_ms(flipperHttp) : 0; } // total time spent writing to the UART
+    uint32_t websocketDroppedLines() const noexcept { return flipperHttp ? flipper_http_websocket_dropped_lines(flipperHttp) : 0; } // incoming lines lost to a full ring
+    size_t websocketReadLine(char *out, size_t size) noexcept { return flipperHttp ? flipper_http_websocket_read_line(flipperHttp, out, size) : 0; } // take the oldest queued incoming line (0 if none)
+    size_t websocketTxPending() const noexcept { return flipperHttp ? flipper_http_tx_pending(flipperHttp) : 0; } // bytes queued for the UART but not yet written
     bool websocketSend(const char *message);                                                                    // send a message over the WebSocket connection
+    FlipperHTTPTxStatus websocketSendAsync(const char *message);                                                // queue a message for the UART; FlipperHTTPTxFull means retry later
     bool websocketStart(const char *url);                                                                       // start a WebSocket connection to the given URL
     bool websocketStop();                                                                                       // stop the WebSocket connection
 };
\ No newline at end of file
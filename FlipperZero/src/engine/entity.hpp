@@ -61,6 +61,8 @@ public:
     bool is_active;                // Indicates if the entity is active.
     bool is_visible;               // Indicates if the entity is visible (for rendering)
     EntityType type;               // Type of the entity
+    uint16_t net_id = 0;           // Network id, assigned when added to a level (0: not networked)
+    uint8_t net_seq = 0;           // Last update sequence sent (local entity) or applied (remote entity); 0: none yet
 
     // 3D Sprite properties
     Sprite3D *sprite_3d;         // 3D sprite representation (can be null for 2D entities)
@@ -52,6 +52,28 @@ void Level::clear()
     delete[] entities;
     entities = nullptr;
     entity_count = 0;
+
+    // Forget the net ids; a repopulated level numbers its entities from the start again
+    for (int i = 0; i < LEVEL_NET_MAP_SIZE; i++)
+    {
+        net_map[i].net_id = 0;
+        net_map[i].entity = nullptr;
+    }
+    net_map_count = 0;
+    next_net_id = 1;
+}
+
+// Remove spawned entities (enemies, NPCs) but keep the players
+void Level::clear_spawned()
+{
+    for (int i = entity_count - 1; i >= 0; i--)
+    {
+        if (entities[i] != nullptr && entities[i]->type != ENTITY_PLAYER)
+        {
+            entity_remove(entities[i]);
+        }
+    }
+    next_net_id = 1;
 }
 
 // Get list of collisions for a given entity
@@ -111,11 +133,42 @@ void Level::entity_add(Entity *entity)
     entities = newEntities;
     entity_count++;
 
+    // Non-player entities are numbered in spawn order; players arrive with an id derived from their name
+    if (entity->net_id == 0 && entity->type != ENTITY_PLAYER)
+    {
+        entity->net_id = next_net_id++;
+    }
+    if (entity->net_id != 0)
+    {
+        net_map_insert(entity);
+    }
+
     // Start the new entity
     entity->start(this->gameRef);
     entity->is_active = true;
 }
 
+// Home slot of a net id (Fibonacci hashing spreads sequential ids)
+static int net_map_home(uint16_t net_id)
+{
+    return (int)(((uint32_t)net_id * 40503u) >> 10) & (LEVEL_NET_MAP_SIZE - 1);
+}
+
+// Find a networked entity by its net id
+Entity *Level::entity_find(uint16_t net_id) const
+{
+    if (net_id == 0)
+        return nullptr;
+    for (int i = net_map_home(net_id), probes = 0; probes < LEVEL_NET_MAP_SIZE; i = (i + 1) & (LEVEL_NET_MAP_SIZE - 1), probes++)
+    {
+        if (net_map[i].net_id == 0)
+            return nullptr;
+        if (net_map[i].net_id == net_id)
+            return net_map[i].entity;
+    }
+    return nullptr;
+}
+
 // Remove an entity from the level
 void Level::entity_remove(Entity *entity)
 {
@@ -134,6 +187,11 @@ void Level::entity_remove(Entity *entity)
     if (remove_index == -1)
         return;
 
+    if (entity->net_id != 0)
+    {
+        net_map_erase(entity->net_id);
+    }
+
     // Stop and delete the entity (only if it's not a player - players are managed externally)
     entities[remove_index]->stop(this->gameRef);
     if (!entities[remove_index]->is_player)
@@ -328,3 +386,54 @@ void Level::update(Game *game)
         }
     }
 }
+
+// Index an entity under its net id (replacing any entity that had the same id)
+void Level::net_map_insert(Entity *entity)
+{
+    int i = net_map_home(entity->net_id);
+    while (net_map[i].net_id != 0 && net_map[i].net_id != entity->net_id)
+    {
+        i = (i + 1) & (LEVEL_NET_MAP_SIZE - 1);
+    }
+    if (net_map[i].net_id == 0)
+    {
+        if (net_map_count >= LEVEL_NET_MAP_MAX_LOAD)
+        {
+            FURI_LOG_E("Level", "Net id map full, entity %u is not indexed", entity->net_id);
+            return;
+        }
+        net_map_count++;
+    }
+    net_map[i].net_id = entity->net_id;
+    net_map[i].entity = entity;
+}
+
+// Remove a net id, shifting later entries of its probe run back so lookups never stop early
+void Level::net_map_erase(uint16_t net_id)
+{
+    int i = net_map_home(net_id);
+    while (net_map[i].net_id != net_id)
+    {
+        if (net_map[i].net_id == 0)
+            return;
+        i = (i + 1) & (LEVEL_NET_MAP_SIZE - 1);
+    }
+    int j = i;
+    while (true)
+    {
+        j = (j + 1) & (LEVEL_NET_MAP_SIZE - 1);
+        if (net_map[j].net_id == 0)
+            break;
+        int home = net_map_home(net_map[j].net_id);
+        // move j into the hole at i unless its home lies cyclically in (i, j]
+        bool homeBetween = i <= j ? (home > i && home <= j) : (home > i || home <= j);
+        if (!homeBetween)
+        {
+            net_map[i] = net_map[j];
+            i = j;
+        }
+    }
+    net_map[i].net_id = 0;
+    net_map[i].entity = nullptr;
+    net_map_count--;
+}
@@ -1,5 +1,9 @@
 #pragma once
 #include "engine/vector.hpp"
+#include <stdint.h>
+
+#define LEVEL_NET_MAP_SIZE 64                           // Open-addressing slots for net id lookup (power of two)
+#define LEVEL_NET_MAP_MAX_LOAD (LEVEL_NET_MAP_SIZE * 3 / 4) // Networked entities a level can index
 
 // Forward declarations
 class Game;
@@ -38,8 +42,10 @@ public:
 
     // Member Functions
     void clear();
+    void clear_spawned(); // Remove every non-player entity; spawn numbering starts over
     Entity **collision_list(Entity *entity, int &count) const;
     void entity_add(Entity *entity);
+    Entity *entity_find(uint16_t net_id) const; // Look up a networked entity by net id (nullptr if none)
     void entity_remove(Entity *entity);
     bool has_collided(Entity *entity) const;
     bool is_collision(const Entity *a, const Entity *b) const;
@@ -59,6 +65,17 @@ private:
     Vector size;
     int entity_count;
     Entity **entities;
+    // Net id index: linear probing, id 0 marks an empty slot, deletions shift back (no tombstones)
+    struct NetMapSlot
+    {
+        uint16_t net_id;
+        Entity *entity;
+    };
+    NetMapSlot net_map[LEVEL_NET_MAP_SIZE] = {};
+    int net_map_count = 0;
+    uint16_t next_net_id = 1; // spawn order id for non-player entities (same on every device for the same level)
+    void net_map_erase(uint16_t net_id);
+    void net_map_insert(Entity *entity);
     // Callback Functions
     void (*_start)(Level &);
     void (*_stop)(Level &);
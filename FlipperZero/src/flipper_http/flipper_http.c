@@ -4,6 +4,366 @@
 // File: flipper_http.c
 #include <flipper_http/flipper_http.h>
 
+/**
+ * @brief      Write out the sink's buffered bytes.
+ * @return     true if the bytes were written, false otherwise.
+ * @param      sink      The response sink.
+ */
+static bool flipper_http_sink_flush(FlipperHTTPFileSink *sink)
+{
+    if (sink->buffer_len > 0 && storage_file_write(sink->file, sink->buffer, sink->buffer_len) != sink->buffer_len)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
+        sink->failed = true;
+    }
+    sink->buffer_len = 0;
+    return !sink->failed;
+}
+
+/**
+ * @brief      Flush and close the response file, if one is open.
+ * @return     true if every byte of the response reached the file, false otherwise.
+ * @param      sink      The response sink.
+ */
+static bool flipper_http_sink_close(FlipperHTTPFileSink *sink)
+{
+    if (!sink->file)
+    {
+        return true;
+    }
+    bool ok = !sink->failed && flipper_http_sink_flush(sink);
+    storage_file_close(sink->file);
+    storage_file_free(sink->file);
+    furi_record_close(RECORD_STORAGE);
+    sink->file = NULL;
+    sink->storage = NULL;
+    return ok;
+}
+
+/**
+ * @brief      Create the response file and keep it open for the rest of the response.
+ * @return     true if the file was opened, false otherwise.
+ * @param      sink      The response sink.
+ * @param      file_path The path to the file.
+ */
+static bool flipper_http_sink_open(FlipperHTTPFileSink *sink, const char *file_path)
+{
+    flipper_http_sink_close(sink); // a previous response that never ended
+    sink->buffer_len = 0;
+    sink->failed = false;
+    sink->storage = furi_record_open(RECORD_STORAGE);
+    sink->file = storage_file_alloc(sink->storage);
+    // FSOM_CREATE_ALWAYS truncates, so an old response never has to be deleted first
+    if (!storage_file_open(sink->file, file_path, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to open file for writing: %s", file_path);
+        storage_file_free(sink->file);
+        furi_record_close(RECORD_STORAGE);
+        sink->file = NULL;
+        sink->storage = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief      Append data to the response file, writing to storage in whole sectors.
+ * @return     true if the data was accepted, false if no file is open or a write failed.
+ * @param      sink      The response sink.
+ * @param      data      The data to append.
+ * @param      data_size The size of the data.
+ */
+static bool flipper_http_sink_write(FlipperHTTPFileSink *sink, const void *data, size_t data_size)
+{
+    if (!sink->file || sink->failed)
+    {
+        return false;
+    }
+    const uint8_t *bytes = (const uint8_t *)data;
+    while (data_size > 0)
+    {
+        if (sink->buffer_len == 0 && data_size >= SINK_SECTOR_SIZE)
+        {
+            // whole sectors go straight to the card
+            size_t direct = data_size - data_size % SINK_SECTOR_SIZE;
+            if (storage_file_write(sink->file, bytes, direct) != direct)
+            {
+                FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
+                sink->failed = true;
+                return false;
+            }
+            bytes += direct;
+            data_size -= direct;
+            continue;
+        }
+        size_t room = SINK_SECTOR_SIZE - sink->buffer_len;
+        size_t take = data_size < room ? data_size : room;
+        memcpy(&sink->buffer[sink->buffer_len], bytes, take);
+        sink->buffer_len += take;
+        bytes += take;
+        data_size -= take;
+        if (sink->buffer_len == SINK_SECTOR_SIZE && !flipper_http_sink_flush(sink))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief      Write every queued outgoing byte to the UART (worker thread only).
+ * @return     void
+ * @param      fhttp     The FlipperHTTP context.
+ */
+static void flipper_http_tx_drain(FlipperHTTP *fhttp)
+{
+    uint8_t chunk[TX_CHUNK_SIZE];
+    size_t len;
+    while ((len = furi_stream_buffer_receive(fhttp->tx_stream, chunk, sizeof(chunk), 0)) > 0)
+    {
+        uint32_t start = furi_get_tick();
+        furi_hal_serial_tx(fhttp->serial_handle, chunk, len);
+        furi_hal_serial_tx_wait_complete(fhttp->serial_handle);
+        __atomic_store_n(&fhttp->tx_busy_ms, fhttp->tx_busy_ms + (furi_get_tick() - start), __ATOMIC_RELAXED);
+        // counted only once on the wire, so a flush waits for the last byte
+        __atomic_store_n(&fhttp->tx_written, fhttp->tx_written + (uint32_t)len, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief      Feed a block of received bytes to the file buffer and the line callback.
+ * @return     void
+ * @param      fhttp     The FlipperHTTP context.
+ * @param      data      The received bytes.
+ * @param      len       Number of bytes in data.
+ * @note       The block is walked one line at a time, so a callback that starts or stops
+ *             saving bytes takes effect from the byte after its line, as before.
+ */
+static void flipper_http_rx_process(FlipperHTTP *fhttp, const uint8_t *data, size_t len)
+{
+    fhttp->bytes_received += len;
+    while (len > 0)
+    {
+        const uint8_t *newline = (const uint8_t *)memchr(data, '\n', len);
+        size_t segment = newline ? (size_t)(newline - data) + 1 : len;
+
+        // Append the segment (newline included) to the file if saving is enabled
+        if (fhttp->save_bytes)
+        {
+            size_t copied = 0;
+            while (copied < segment)
+            {
+                size_t room = FILE_BUFFER_SIZE - fhttp->file_buffer_len;
+                size_t take = segment - copied < room ? segment - copied : room;
+                memcpy(&fhttp->file_buffer[fhttp->file_buffer_len], data + copied, take);
+                fhttp->file_buffer_len += take;
+                copied += take;
+                // Write to file if buffer is full
+                if (fhttp->file_buffer_len >= FILE_BUFFER_SIZE)
+                {
+                    // the response file was opened on [*/SUCCESS]; a full buffer is whole sectors
+                    flipper_http_sink_write(&fhttp->sink, fhttp->file_buffer, fhttp->file_buffer_len);
+                    fhttp->file_buffer_len = 0;
+                    fhttp->just_started_bytes = false;
+                }
+            }
+        }
+
+        // Handle line buffering only if callback is set (text data)
+        if (fhttp->handle_rx_line_cb)
+        {
+            size_t text = newline ? segment - 1 : segment;
+            size_t copied = 0;
+            while (copied < text)
+            {
+                size_t room = RX_LINE_BUFFER_SIZE - 1 - fhttp->rx_line_pos;
+                size_t take = text - copied < room ? text - copied : room;
+                memcpy(&fhttp->rx_line_buffer[fhttp->rx_line_pos], data + copied, take);
+                fhttp->rx_line_pos += take;
+                copied += take;
+                if (fhttp->rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
+                {
+                    // Line too long: hand over what fits and keep going
+                    fhttp->rx_line_buffer[fhttp->rx_line_pos] = '\0';
+                    fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+                    fhttp->rx_line_pos = 0;
+                }
+            }
+            if (newline)
+            {
+                fhttp->rx_line_buffer[fhttp->rx_line_pos] = '\0'; // Null-terminate the line
+
+                // Invoke the callback with the complete line
+                fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+
+                // Reset the line buffer position
+                fhttp->rx_line_pos = 0;
+            }
+        }
+
+        data += segment;
+        len -= segment;
+    }
+}
+
+/**
+ * @brief      Whether a request still needs the line (queued, in flight or draining a late answer).
+ * @return     true while a direct request or a websocket must not be started.
+ * @param      fhttp     The FlipperHTTP context.
+ * @note       Call with queue_mutex held.
+ */
+static bool flipper_http_queue_busy(const FlipperHTTP *fhttp)
+{
+    return fhttp->line_busy || fhttp->queue_sent < fhttp->queue_count || fhttp->queue_draining;
+}
+
+/**
+ * @brief      Whether the line is free for the next queued request.
+ * @return     false while a direct request is answered or a websocket is open.
+ * @param      fhttp     The FlipperHTTP context.
+ * @note       Call with queue_mutex held.
+ */
+static bool flipper_http_queue_can_send(const FlipperHTTP *fhttp)
+{
+    return !__atomic_load_n(&fhttp->websocket_active, __ATOMIC_ACQUIRE) && !fhttp->line_busy;
+}
+
+/**
+ * @brief      End the request in flight and let the worker send the next queued one.
+ * @return     void
+ * @param      fhttp     The FlipperHTTP context.
+ * @param      result    How the request ended.
+ * @note       Worker thread only; does nothing when no request owns the line.
+ */
+static void flipper_http_queue_finish(FlipperHTTP *fhttp, FlipperHTTPRequestResult result)
+{
+    FlipperHTTPRequest *request = fhttp->queue_current;
+    if (!request)
+    {
+        // a direct request's answer ended: hand the line back to the queue
+        furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+        bool released = fhttp->line_busy;
+        fhttp->line_busy = false;
+        if (released && result == FlipperHTTPRequestTimedOut)
+        {
+            fhttp->queue_draining = true;
+            fhttp->queue_drain_tick = furi_get_tick();
+        }
+        furi_mutex_release(fhttp->queue_mutex);
+        if (released)
+        {
+            furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
+        }
+        return;
+    }
+    flipper_http_sink_close(&fhttp->sink);
+    request->result = result;
+    request->status_code = fhttp->status_code;
+    if (fhttp->ram_active && result == FlipperHTTPRequestOk)
+    {
+        request->body_len = fhttp->ram_len;
+    }
+    else
+    {
+        // the body is in the file (or incomplete)
+        free(request->body);
+        request->body = NULL;
+        request->body_len = 0;
+    }
+
+    // direct requests go back to their file and the default timeout
+    fhttp->ram_active = false;
+    fhttp->ram_len = 0;
+    fhttp->ram_buffer = NULL;
+    fhttp->ram_size = 0;
+    fhttp->timeout_ticks = TIMEOUT_DURATION_TICKS;
+
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    fhttp->queue_current = NULL;
+    fhttp->line_busy = false;
+    if (result == FlipperHTTPRequestTimedOut)
+    {
+        // the board may still answer; that answer must not be taken for the next request's
+        fhttp->queue_draining = true;
+        fhttp->queue_drain_tick = furi_get_tick();
+    }
+    furi_mutex_release(fhttp->queue_mutex);
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
+}
+
+/**
+ * @brief      Send the next queued request if none is in flight.
+ * @return     void
+ * @param      fhttp     The FlipperHTTP context.
+ * @note       Worker thread only.
+ */
+static void flipper_http_queue_dispatch(FlipperHTTP *fhttp)
+{
+    while (!fhttp->queue_current)
+    {
+        FlipperHTTPRequest *request = NULL;
+        furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+        if (fhttp->queue_draining && furi_get_tick() - fhttp->queue_drain_tick >= furi_ms_to_ticks(HTTP_QUEUE_DRAIN_MS))
+        {
+            // the late answer never came
+            fhttp->queue_draining = false;
+        }
+        bool skipped = false;
+        if (!fhttp->queue_draining && fhttp->queue_sent < fhttp->queue_count && flipper_http_queue_can_send(fhttp))
+        {
+            request = &fhttp->queue[(fhttp->queue_head + fhttp->queue_sent) % HTTP_QUEUE_SIZE];
+            fhttp->queue_sent++;
+            if (request->cancelled)
+            {
+                // never sent; the poll just removes it
+                free(request->command);
+                request->command = NULL;
+                request->result = FlipperHTTPRequestFailed;
+                skipped = true;
+            }
+            else
+            {
+                fhttp->queue_current = request;
+                // claim the line before a direct request can
+                fhttp->line_busy = true;
+            }
+        }
+        furi_mutex_release(fhttp->queue_mutex);
+        if (!request)
+        {
+            return;
+        }
+        if (skipped)
+        {
+            continue;
+        }
+
+        // the response handlers work on the single-request fields, so point them at this request
+        snprintf(fhttp->file_path, sizeof(fhttp->file_path), "%s", request->file_path);
+        fhttp->method = request->method;
+        fhttp->save_received_data = true;
+        fhttp->is_bytes_request = false;
+        fhttp->status_code = 0;
+        fhttp->ram_active = false;
+        fhttp->ram_len = 0;
+        fhttp->ram_buffer = NULL;
+        fhttp->ram_size = 0;
+        fhttp->timeout_ticks = furi_ms_to_ticks(request->timeout_ms);
+
+        bool sent = flipper_http_send_data(fhttp, request->command);
+        free(request->command);
+        request->command = NULL;
+        if (!sent)
+        {
+            fhttp->state = ISSUE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
+            continue;
+        }
+        // also ends a request that gets no answer at all
+        furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
+    }
+}
+
 /**
  * @brief      Worker thread to handle UART data asynchronously.
  * @return     0
@@ -23,82 +383,174 @@ static int32_t flipper_http_worker(void *context)
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
         return -1;
     }
-    size_t rx_line_pos = 0;
 
     while (1)
     {
         uint32_t events = furi_thread_flags_wait(
-            WorkerEvtStop | WorkerEvtRxDone, FuriFlagWaitAny, FuriWaitForever);
+            WorkerEvtStop | WorkerEvtRxDone | WorkerEvtTxPending | WorkerEvtRxTimeout | WorkerEvtQueue, FuriFlagWaitAny, RX_IDLE_POLL_MS);
+        if (events & FuriFlagError)
+        {
+            // Timed out: pick up a tail the ISR did not signal
+            if (furi_stream_buffer_is_empty(fhttp->flipper_http_stream))
+            {
+                if (fhttp->queue_draining)
+                {
+                    flipper_http_queue_dispatch(fhttp); // sends once the line stayed quiet long enough
+                }
+                continue;
+            }
+            events = WorkerEvtRxDone;
+        }
         if (events & WorkerEvtStop)
         {
             break;
         }
+        if (events & WorkerEvtTxPending)
+        {
+            flipper_http_tx_drain(fhttp);
+        }
         if (events & WorkerEvtRxDone)
         {
-            // Continuously read from the stream buffer until it's empty
-            while (!furi_stream_buffer_is_empty(fhttp->flipper_http_stream))
+            // Read whole blocks until the stream buffer is empty
+            size_t received;
+            while ((received = furi_stream_buffer_receive(fhttp->flipper_http_stream, fhttp->rx_block, sizeof(fhttp->rx_block), 0)) > 0)
             {
-                // Read one byte at a time
-                char c = 0;
-                size_t received = furi_stream_buffer_receive(fhttp->flipper_http_stream, &c, 1, 0);
-
-                if (received == 0)
-                {
-                    // No more data to read
-                    break;
-                }
-
-                fhttp->bytes_received += received;
-
-                // print amount of bytes received
-                // FURI_LOG_I(HTTP_TAG, "Bytes received: %d", fhttp->bytes_received);
+                flipper_http_rx_process(fhttp, fhttp->rx_block, received);
+            }
+        }
+        if (events & WorkerEvtRxTimeout)
+        {
+            // the response never ended: keep what arrived and release the file
+            if (fhttp->save_bytes && fhttp->file_buffer_len > 0)
+            {
+                flipper_http_sink_write(&fhttp->sink, fhttp->file_buffer, fhttp->file_buffer_len);
+            }
+            fhttp->file_buffer_len = 0;
+            fhttp->save_bytes = false;
+            flipper_http_sink_close(&fhttp->sink);
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestTimedOut);
+        }
+        if (events & (WorkerEvtQueue | WorkerEvtRxDone | WorkerEvtRxTimeout))
+        {
+            // also picks up requests that waited for a direct request to end
+            flipper_http_queue_dispatch(fhttp);
+        }
+    }
 
-                // Append the received byte to the file if saving is enabled
-                if (fhttp->save_bytes)
-                {
-                    // Add byte to the buffer
-                    fhttp->file_buffer[fhttp->file_buffer_len++] = c;
-                    // Write to file if buffer is full
-                    if (fhttp->file_buffer_len >= FILE_BUFFER_SIZE)
-                    {
-                        if (!flipper_http_append_to_file(
-                                fhttp->file_buffer,
-                                fhttp->file_buffer_len,
-                                fhttp->just_started_bytes,
-                                fhttp->file_path))
-                        {
-                            FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
-                        }
-                        fhttp->file_buffer_len = 0;
-                        fhttp->just_started_bytes = false;
-                    }
-                }
+    return 0;
+}
 
-                // Handle line buffering only if callback is set (text data)
-                if (fhttp->handle_rx_line_cb)
-                {
-                    // Handle line buffering
-                    if (c == '\n' || rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
-                    {
-                        fhttp->rx_line_buffer[rx_line_pos] = '\0'; // Null-terminate the line
+#ifdef FLIPPER_HTTP_BENCHMARK
+static void flipper_http_benchmark_line(const char *line, void *context)
+{
+    UNUSED(line);
+    (*(uint32_t *)context)++;
+}
 
-                        // Invoke the callback with the complete line
-                        fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+// The worker loop before block reads: one stream call and one branch per byte
+static void flipper_http_benchmark_bytewise(FlipperHTTP *scratch, FuriStreamBuffer *stream)
+{
+    while (!furi_stream_buffer_is_empty(stream))
+    {
+        char c = 0;
+        if (furi_stream_buffer_receive(stream, &c, 1, 0) == 0)
+        {
+            break;
+        }
+        scratch->bytes_received++;
+        if (c == '\n' || scratch->rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
+        {
+            scratch->rx_line_buffer[scratch->rx_line_pos] = '\0';
+            scratch->handle_rx_line_cb(scratch->rx_line_buffer, scratch->callback_context);
+            scratch->rx_line_pos = 0;
+        }
+        else
+        {
+            scratch->rx_line_buffer[scratch->rx_line_pos++] = c;
+        }
+    }
+}
 
-                        // Reset the line buffer position
-                        rx_line_pos = 0;
-                    }
-                    else
-                    {
-                        fhttp->rx_line_buffer[rx_line_pos++] = c; // Add character to the line buffer
-                    }
-                }
+static uint32_t flipper_http_benchmark_run(FlipperHTTP *scratch, FuriStreamBuffer *stream, size_t total_bytes, bool bytewise)
+{
+    uint8_t block[RX_BLOCK_SIZE];
+    uint8_t line[64];
+    memset(line, 'a', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\n';
+
+    // 1 ms ticks cannot time one buffer's worth, so count CPU cycles with the DWT counter
+    size_t done = 0;
+    uint64_t busy_cycles = 0;
+    while (done < total_bytes)
+    {
+        // refill outside the timed part, the way the ISR would have
+        size_t fill = 0;
+        while (fill < RX_BUF_SIZE / 2 && done + fill < total_bytes)
+        {
+            furi_stream_buffer_send(stream, line, sizeof(line), 0);
+            fill += sizeof(line);
+        }
+        uint32_t start = DWT->CYCCNT;
+        if (bytewise)
+        {
+            flipper_http_benchmark_bytewise(scratch, stream);
+        }
+        else
+        {
+            size_t received;
+            while ((received = furi_stream_buffer_receive(stream, block, sizeof(block), 0)) > 0)
+            {
+                flipper_http_rx_process(scratch, block, received);
             }
         }
+        busy_cycles += (uint32_t)(DWT->CYCCNT - start);
+        done += fill;
     }
+    uint64_t busy_us = busy_cycles / furi_hal_cortex_instructions_per_microsecond();
+    return (uint32_t)((uint64_t)done * 1000000 / (busy_us ? busy_us : 1));
+}
 
-    return 0;
+bool flipper_http_rx_benchmark(size_t total_bytes, uint32_t *block_bytes_per_sec, uint32_t *byte_bytes_per_sec)
+{
+    FlipperHTTP *scratch = (FlipperHTTP *)malloc(sizeof(FlipperHTTP));
+    FuriStreamBuffer *stream = furi_stream_buffer_alloc(RX_BUF_SIZE, 1);
+    if (!scratch || !stream)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate benchmark buffers.");
+        free(scratch);
+        if (stream)
+        {
+            furi_stream_buffer_free(stream);
+        }
+        return false;
+    }
+    uint32_t block_lines = 0;
+    uint32_t byte_lines = 0;
+    memset(scratch, 0, sizeof(FlipperHTTP));
+    scratch->handle_rx_line_cb = flipper_http_benchmark_line;
+
+    scratch->callback_context = &block_lines;
+    uint32_t block_rate = flipper_http_benchmark_run(scratch, stream, total_bytes, false);
+    scratch->rx_line_pos = 0;
+    scratch->callback_context = &byte_lines;
+    uint32_t byte_rate = flipper_http_benchmark_run(scratch, stream, total_bytes, true);
+    FURI_LOG_I(HTTP_TAG, "RX loop: %lu B/s in blocks (%lu lines), %lu B/s per byte (%lu lines)",
+               (unsigned long)block_rate, (unsigned long)block_lines,
+               (unsigned long)byte_rate, (unsigned long)byte_lines);
+    if (block_bytes_per_sec)
+    {
+        *block_bytes_per_sec = block_rate;
+    }
+    if (byte_bytes_per_sec)
+    {
+        *byte_bytes_per_sec = byte_rate;
+    }
+
+    furi_stream_buffer_free(stream);
+    free(scratch);
+    return block_lines == byte_lines;
 }
+#endif
 
 // UART RX Handler Callback (Interrupt Context)
 /**
@@ -120,10 +572,22 @@ static void _flipper_http_rx_callback(
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
         return;
     }
-    if (event == FuriHalSerialRxEventData)
+    bool wake = false;
+    if (event & FuriHalSerialRxEventData)
     {
         uint8_t data = furi_hal_serial_async_rx(handle);
         furi_stream_buffer_send(fhttp->flipper_http_stream, &data, 1, 0);
+        // wake the worker once per line or RX_SIGNAL_THRESHOLD bytes instead of once per byte
+        fhttp->rx_unsignalled++;
+        wake = data == '\n' || fhttp->rx_unsignalled >= RX_SIGNAL_THRESHOLD;
+    }
+    if (event & FuriHalSerialRxEventIdle)
+    {
+        wake = true; // the sender paused, so hand over the tail too
+    }
+    if (wake && fhttp->rx_unsignalled > 0)
+    {
+        fhttp->rx_unsignalled = 0;
         furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtRxDone);
     }
 }
@@ -148,10 +612,74 @@ static void get_timeout_timer_callback(void *context)
     // Reset the state
     fhttp->started_receiving = false;
 
+    // The response file belongs to the worker thread, so it closes it
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtRxTimeout);
+
     // Update UART state
     fhttp->state = ISSUE;
 }
 
+// Websocket line ring (single producer: UART worker, single consumer: game thread)
+static void line_ring_copy_in(FlipperHTTPLineRing *ring, uint32_t pos, const void *src, size_t len)
+{
+    const uint8_t *bytes = (const uint8_t *)src;
+    for (size_t i = 0; i < len; i++)
+    {
+        ring->data[(pos + i) & (WS_LINE_RING_SIZE - 1)] = bytes[i];
+    }
+}
+
+static void line_ring_copy_out(const FlipperHTTPLineRing *ring, uint32_t pos, void *dst, size_t len)
+{
+    uint8_t *bytes = (uint8_t *)dst;
+    for (size_t i = 0; i < len; i++)
+    {
+        bytes[i] = ring->data[(pos + i) & (WS_LINE_RING_SIZE - 1)];
+    }
+}
+
+static bool line_ring_push(FlipperHTTPLineRing *ring, const char *line, size_t len)
+{
+    uint32_t head = ring->head; // only this thread writes head
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (len == 0 || len > WS_LINE_MAX || (head - tail) + 2 + len > WS_LINE_RING_SIZE)
+    {
+        __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    uint16_t length = (uint16_t)len;
+    line_ring_copy_in(ring, head, &length, sizeof(length));
+    line_ring_copy_in(ring, head + 2, line, len);
+    // publish the record only after its bytes are written
+    __atomic_store_n(&ring->head, head + 2 + (uint32_t)len, __ATOMIC_RELEASE);
+    return true;
+}
+
+static size_t line_ring_pop(FlipperHTTPLineRing *ring, char *out, size_t out_size)
+{
+    uint32_t tail = ring->tail; // only this thread writes tail
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (head == tail || out_size == 0)
+    {
+        return 0;
+    }
+    uint16_t length;
+    line_ring_copy_out(ring, tail, &length, sizeof(length));
+    size_t copy = length < out_size - 1 ? length : out_size - 1;
+    line_ring_copy_out(ring, tail + 2, out, copy);
+    out[copy] = '\0';
+    // release the space only after the bytes are read
+    __atomic_store_n(&ring->tail, tail + 2 + length, __ATOMIC_RELEASE);
+    return copy;
+}
+
+static void line_ring_reset(FlipperHTTPLineRing *ring)
+{
+    // only valid while the producer is not pushing (websocket_active is false)
+    ring->tail = ring->head;
+    ring->dropped = 0;
+}
+
 static void flipper_http_rx_callback(const char *line, void *context); // forward declaration
 
 // UART initialization function
@@ -281,6 +809,41 @@ FlipperHTTP *flipper_http_alloc()
     }
     memset(fhttp->last_response, 0, RX_BUF_SIZE); // Initialize last_response
 
+    // Outgoing data is queued here and written by the worker, so senders never wait on the UART
+    fhttp->tx_stream = furi_stream_buffer_alloc(TX_BUF_SIZE, 1);
+    fhttp->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    fhttp->queue_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    if (!fhttp->tx_stream || !fhttp->tx_mutex || !fhttp->queue_mutex)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate UART TX queue.");
+        // Cleanup resources
+        if (fhttp->tx_stream)
+        {
+            furi_stream_buffer_free(fhttp->tx_stream);
+        }
+        if (fhttp->tx_mutex)
+        {
+            furi_mutex_free(fhttp->tx_mutex);
+        }
+        if (fhttp->queue_mutex)
+        {
+            furi_mutex_free(fhttp->queue_mutex);
+        }
+        free(fhttp->last_response);
+        furi_timer_free(fhttp->get_timeout_timer);
+        furi_hal_serial_async_rx_stop(fhttp->serial_handle);
+        furi_hal_serial_disable_direction(fhttp->serial_handle, FuriHalSerialDirectionRx);
+        furi_hal_serial_control_release(fhttp->serial_handle);
+        furi_hal_serial_deinit(fhttp->serial_handle);
+        furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtStop);
+        furi_thread_join(fhttp->rx_thread);
+        furi_thread_free(fhttp->rx_thread);
+        furi_stream_buffer_free(fhttp->flipper_http_stream);
+        free(fhttp);
+        return NULL;
+    }
+
+    fhttp->timeout_ticks = TIMEOUT_DURATION_TICKS;
     fhttp->state = IDLE;
 
     // FURI_LOG_I(HTTP_TAG, "UART initialized successfully.");
@@ -306,6 +869,12 @@ void flipper_http_free(FlipperHTTP *fhttp)
         FURI_LOG_E(HTTP_TAG, "UART handle is NULL. Already deinitialized?");
         return;
     }
+    // Let the worker write what is still queued (e.g. a websocket stop)
+    if (!flipper_http_tx_flush(fhttp, TX_FLUSH_ON_FREE_MS))
+    {
+        FURI_LOG_W(HTTP_TAG, "Dropping %zu unsent bytes.", flipper_http_tx_pending(fhttp));
+    }
+
     // Stop asynchronous RX
     furi_hal_serial_async_rx_stop(fhttp->serial_handle);
 
@@ -321,8 +890,21 @@ void flipper_http_free(FlipperHTTP *fhttp)
     // Free the thread resources
     furi_thread_free(fhttp->rx_thread);
 
-    // Free the stream buffer
+    // Close a response file left open by an unfinished request
+    flipper_http_sink_close(&fhttp->sink);
+
+    // Drop queued requests nobody collected
+    for (size_t i = 0; i < HTTP_QUEUE_SIZE; i++)
+    {
+        free(fhttp->queue[i].command);
+        free(fhttp->queue[i].body);
+    }
+    furi_mutex_free(fhttp->queue_mutex);
+
+    // Free the stream buffers
     furi_stream_buffer_free(fhttp->flipper_http_stream);
+    furi_stream_buffer_free(fhttp->tx_stream);
+    furi_mutex_free(fhttp->tx_mutex);
 
     // Free the timer
     if (fhttp->get_timeout_timer)
@@ -800,41 +1382,28 @@ bool flipper_http_process_response_async(FlipperHTTP *fhttp, bool (*http_request
     }
     return true;
 }
-
-/**
- * @brief      Send a request to the specified URL.
- * @return     true if the request was successful, false otherwise.
- * @param      fhttp The FlipperHTTP context
- * @param      method The HTTP method to use.
- * @param      url  The URL to send the request to.
- * @param      headers  The headers to send with the request.
- * @param      payload  The data to send with the request.
- * @note       The received data will be handled asynchronously via the callback.
- */
-bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url, const char *headers, const char *payload)
-{
-    if (!fhttp)
-    {
-        FURI_LOG_E("FlipperHTTP", "Failed to get context.");
-        return false;
-    }
-    if (!url)
-    {
-        FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
-        return false;
-    }
-
-    // Prepare request command
-    char command[512];
+
+/**
+ * @brief      Build the request line FlipperHTTP sends for a request.
+ * @return     true if the line was built, false if an argument is missing or it does not fit.
+ * @param      method The HTTP method to use.
+ * @param      url  The URL to send the request to.
+ * @param      headers  The headers to send with the request.
+ * @param      payload  The data to send with the request.
+ * @param      command  Buffer for the request line.
+ * @param      command_size  Size of command.
+ */
+static bool flipper_http_format_request(HTTPMethod method, const char *url, const char *headers, const char *payload, char *command, size_t command_size)
+{
     int ret = 0;
 
     switch (method)
     {
     case GET:
         if (headers && strlen(headers) > 0)
-            ret = snprintf(command, sizeof(command), "[GET/HTTP]{\"url\":\"%s\",\"headers\":%s}", url, headers);
+            ret = snprintf(command, command_size, "[GET/HTTP]{\"url\":\"%s\",\"headers\":%s}", url, headers);
         else
-            ret = snprintf(command, sizeof(command), "[GET]%s", url);
+            ret = snprintf(command, command_size, "[GET]%s", url);
         break;
     case POST:
         if (!headers || !payload)
@@ -842,7 +1411,7 @@ bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url
             FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
             return false;
         }
-        ret = snprintf(command, sizeof(command), "[POST/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
+        ret = snprintf(command, command_size, "[POST/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
         break;
     case PUT:
         if (!headers || !payload)
@@ -850,7 +1419,7 @@ bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url
             FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
             return false;
         }
-        ret = snprintf(command, sizeof(command), "[PUT/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
+        ret = snprintf(command, command_size, "[PUT/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
         break;
     case DELETE:
         if (!headers || !payload)
@@ -858,7 +1427,7 @@ bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url
             FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
             return false;
         }
-        ret = snprintf(command, sizeof(command), "[DELETE/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
+        ret = snprintf(command, command_size, "[DELETE/HTTP]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
         break;
     case BYTES:
         if (!headers)
@@ -866,14 +1435,7 @@ bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url
             FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
             return false;
         }
-        if (strlen(fhttp->file_path) == 0)
-        {
-            FURI_LOG_E("FlipperHTTP", "File path is not set.");
-            return false;
-        }
-        fhttp->save_received_data = false;
-        fhttp->is_bytes_request = true;
-        ret = snprintf(command, sizeof(command), "[GET/BYTES]{\"url\":\"%s\",\"headers\":%s}", url, headers);
+        ret = snprintf(command, command_size, "[GET/BYTES]{\"url\":\"%s\",\"headers\":%s}", url, headers);
         break;
     case BYTES_POST:
         if (!headers || !payload)
@@ -881,29 +1443,90 @@ bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url
             FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
             return false;
         }
+        ret = snprintf(command, command_size, "[POST/BYTES]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
+        break;
+    }
+
+    // check if ret is valid
+    if (ret < 0 || ret >= (int)command_size)
+    {
+        FURI_LOG_E("FlipperHTTP", "Failed to format request command.");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief      Send a request to the specified URL.
+ * @return     true if the request was successful, false otherwise.
+ * @param      fhttp The FlipperHTTP context
+ * @param      method The HTTP method to use.
+ * @param      url  The URL to send the request to.
+ * @param      headers  The headers to send with the request.
+ * @param      payload  The data to send with the request.
+ * @note       The received data will be handled asynchronously via the callback.
+ */
+bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url, const char *headers, const char *payload)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E("FlipperHTTP", "Failed to get context.");
+        return false;
+    }
+    if (!url)
+    {
+        FURI_LOG_E("FlipperHTTP", "Invalid arguments provided to flipper_http_request.");
+        return false;
+    }
+
+    // Bytes requests stream straight into file_path
+    if (method == BYTES || method == BYTES_POST)
+    {
         if (strlen(fhttp->file_path) == 0)
         {
             FURI_LOG_E("FlipperHTTP", "File path is not set.");
             return false;
         }
-        fhttp->save_received_data = false;
-        fhttp->is_bytes_request = true;
-        ret = snprintf(command, sizeof(command), "[POST/BYTES]{\"url\":\"%s\",\"headers\":%s,\"payload\":%s}", url, headers, payload);
-        break;
     }
 
-    // check if ret is valid
-    if (ret < 0 || ret >= (int)sizeof(command))
+    // Prepare request command
+    char command[512];
+    if (!flipper_http_format_request(method, url, headers, payload, command, sizeof(command)))
     {
-        FURI_LOG_E("FlipperHTTP", "Failed to format request command.");
         return false;
     }
 
+    // the queue shares the single-request state below, so wait for it to empty
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    if (flipper_http_queue_busy(fhttp))
+    {
+        furi_mutex_release(fhttp->queue_mutex);
+        FURI_LOG_E("FlipperHTTP", "Another request is still outstanding.");
+        return false;
+    }
+    fhttp->line_busy = true; // keeps the worker from dispatching a queued request over this one
+    furi_mutex_release(fhttp->queue_mutex);
+
+    if (method == BYTES || method == BYTES_POST)
+    {
+        fhttp->save_received_data = false;
+        fhttp->is_bytes_request = true;
+    }
+
     // set method
     fhttp->method = method;
 
     // Send request via UART
-    return flipper_http_send_data(fhttp, command);
+    if (!flipper_http_send_data(fhttp, command))
+    {
+        furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+        fhttp->line_busy = false;
+        furi_mutex_release(fhttp->queue_mutex);
+        return false;
+    }
+    // also releases the line if the board never answers
+    furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
+    return true;
 }
 
 /**
@@ -981,56 +1604,285 @@ bool flipper_http_send_command(FlipperHTTP *fhttp, HTTPCommand command)
 }
 
 /**
- * @brief      Send data over UART with newline termination.
- * @return     true if the data was sent successfully, false otherwise.
+ * @brief      Queue data for the UART with newline termination.
+ * @return     true if the data was queued, false otherwise.
  * @param fhttp The FlipperHTTP context
  * @param      data  The data to send over UART.
- * @note       The data will be sent over UART with a newline character appended.
+ * @note       Never blocks; the worker thread writes the data.
  */
 bool flipper_http_send_data(FlipperHTTP *fhttp, const char *data)
+{
+    FlipperHTTPTxStatus status = flipper_http_send_data_async(fhttp, data);
+    if (status == FlipperHTTPTxFull)
+    {
+        FURI_LOG_E("FlipperHTTP", "UART TX queue full, data not sent.");
+    }
+    return status == FlipperHTTPTxQueued;
+}
+
+/**
+ * @brief      Queue data for the UART with newline termination.
+ * @return     FlipperHTTPTxQueued, FlipperHTTPTxFull if the queue has no room for it yet, FlipperHTTPTxRejected otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param      data  The data to send over UART.
+ * @note       Never blocks; a line is queued whole or not at all.
+ */
+FlipperHTTPTxStatus flipper_http_send_data_async(FlipperHTTP *fhttp, const char *data)
 {
     if (!fhttp)
     {
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
-        return false;
+        return FlipperHTTPTxRejected;
     }
 
-    size_t data_length = strlen(data);
+    size_t data_length = data ? strlen(data) : 0;
     if (data_length == 0)
     {
         FURI_LOG_E("FlipperHTTP", "Attempted to send empty data.");
-        return false;
+        return FlipperHTTPTxRejected;
     }
 
-    // Create a buffer with data + '\n'
     size_t send_length = data_length + 1; // +1 for '\n'
-    if (send_length > 512)
-    { // Ensure buffer size is sufficient
+    if (send_length > TX_BUF_SIZE)
+    {
         FURI_LOG_E("FlipperHTTP", "Data too long to send over FHTTP->");
-        return false;
+        return FlipperHTTPTxRejected;
     }
 
-    char send_buffer[513]; // 512 + 1 for safety
-    strncpy(send_buffer, data, 512);
-    send_buffer[data_length] = '\n';     // Append newline
-    send_buffer[data_length + 1] = '\0'; // Null-terminate
-
-    if (fhttp->state == INACTIVE && ((strstr(send_buffer, "[PING]") == NULL) &&
-                                     (strstr(send_buffer, "[WIFI/CONNECT]") == NULL)))
+    if (fhttp->state == INACTIVE && ((strstr(data, "[PING]") == NULL) &&
+                                     (strstr(data, "[WIFI/CONNECT]") == NULL)))
     {
         FURI_LOG_E("FlipperHTTP", "Cannot send data while INACTIVE.");
         fhttp->last_response = "Cannot send data while INACTIVE.";
-        return false;
+        return FlipperHTTPTxRejected;
+    }
+
+    // the stream has a single reader (the worker); the mutex keeps writers from interleaving lines
+    if (furi_mutex_acquire(fhttp->tx_mutex, FuriWaitForever) != FuriStatusOk)
+    {
+        return FlipperHTTPTxRejected;
+    }
+    if (furi_stream_buffer_spaces_available(fhttp->tx_stream) < send_length)
+    {
+        furi_mutex_release(fhttp->tx_mutex);
+        return FlipperHTTPTxFull;
     }
+    furi_stream_buffer_send(fhttp->tx_stream, data, data_length, 0);
+    furi_stream_buffer_send(fhttp->tx_stream, "\n", 1, 0);
+    __atomic_store_n(&fhttp->tx_queued, fhttp->tx_queued + (uint32_t)send_length, __ATOMIC_RELEASE);
+    furi_mutex_release(fhttp->tx_mutex);
 
-    fhttp->state = SENDING;
-    furi_hal_serial_tx(fhttp->serial_handle, (const uint8_t *)send_buffer, send_length);
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtTxPending);
 
-    // FURI_LOG_I("FlipperHTTP", "Sent data over UART: %s", send_buffer);
+    // FURI_LOG_I("FlipperHTTP", "Queued data for UART: %s", data);
     fhttp->state = IDLE;
+    return FlipperHTTPTxQueued;
+}
+
+/**
+ * @brief      Wait until every queued byte has been written to the UART.
+ * @return     true if the queue drained, false on timeout.
+ * @param fhttp The FlipperHTTP context
+ * @param      timeout_ms  Longest time to wait.
+ */
+bool flipper_http_tx_flush(FlipperHTTP *fhttp, uint32_t timeout_ms)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    uint32_t start = furi_get_tick();
+    while (flipper_http_tx_pending(fhttp) > 0)
+    {
+        if (furi_get_tick() - start >= timeout_ms)
+        {
+            return false;
+        }
+        furi_delay_ms(1);
+    }
+    return true;
+}
+
+/**
+ * @brief      Bytes queued but not yet written to the UART.
+ * @return     The number of pending bytes.
+ * @param fhttp The FlipperHTTP context
+ */
+size_t flipper_http_tx_pending(FlipperHTTP *fhttp)
+{
+    if (!fhttp)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&fhttp->tx_queued, __ATOMIC_ACQUIRE) - __atomic_load_n(&fhttp->tx_written, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief      Time the worker has spent writing to the UART since alloc.
+ * @return     The busy time in milliseconds (free-running).
+ * @param fhttp The FlipperHTTP context
+ */
+uint32_t flipper_http_tx_busy_ms(FlipperHTTP *fhttp)
+{
+    return fhttp ? __atomic_load_n(&fhttp->tx_busy_ms, __ATOMIC_RELAXED) : 0;
+}
+
+/**
+ * @brief      Queue a request; the worker sends it as soon as the request before it ends.
+ * @return     true if the request was queued, false if the queue is full or the request is invalid.
+ * @param fhttp The FlipperHTTP context
+ * @param      method     GET, POST, PUT or DELETE (bytes requests are not queued).
+ * @param      url        The URL to send the request to.
+ * @param      headers    The headers to send with the request.
+ * @param      payload    The data to send with the request (NULL for GET).
+ * @param      file_path  Where the body is written when it is not kept in RAM.
+ * @param      ram_limit  The body is kept in RAM when its Content-Length is below this (0: always the file).
+ * @param      timeout_ms Silence after which the request times out.
+ * @param      callback   Called from flipper_http_queue_poll once the request ends (may be NULL).
+ * @param      context    Context for the callback.
+ */
+bool flipper_http_queue_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url, const char *headers, const char *payload,
+                                const char *file_path, size_t ram_limit, uint32_t timeout_ms,
+                                FlipperHTTPRequestCallback callback, void *context)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    if (!url || !file_path || method == BYTES || method == BYTES_POST)
+    {
+        FURI_LOG_E(HTTP_TAG, "Invalid arguments provided to flipper_http_queue_request.");
+        return false;
+    }
+    if (strlen(file_path) >= HTTP_QUEUE_PATH_SIZE)
+    {
+        FURI_LOG_E(HTTP_TAG, "File path too long: %s", file_path);
+        return false;
+    }
+
+    char command[512];
+    if (!flipper_http_format_request(method, url, headers, payload, command, sizeof(command)))
+    {
+        return false;
+    }
+    char *line = (char *)malloc(strlen(command) + 1);
+    if (!line)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate memory for the request.");
+        return false;
+    }
+    strcpy(line, command);
+
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    if (fhttp->queue_count >= HTTP_QUEUE_SIZE)
+    {
+        furi_mutex_release(fhttp->queue_mutex);
+        FURI_LOG_E(HTTP_TAG, "Request queue full.");
+        free(line);
+        return false;
+    }
+    FlipperHTTPRequest *request = &fhttp->queue[(fhttp->queue_head + fhttp->queue_count) % HTTP_QUEUE_SIZE];
+    memset(request, 0, sizeof(FlipperHTTPRequest));
+    request->command = line;
+    request->method = method;
+    snprintf(request->file_path, sizeof(request->file_path), "%s", file_path);
+    request->ram_limit = ram_limit;
+    request->timeout_ms = timeout_ms;
+    request->callback = callback;
+    request->context = context;
+    fhttp->queue_count++;
+    furi_mutex_release(fhttp->queue_mutex);
+
+    // the worker sends it right away if nothing is in flight
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
     return true;
 }
 
+/**
+ * @brief      Hand finished queued requests to their callbacks, oldest first.
+ * @return     The number of requests handed over.
+ * @param fhttp The FlipperHTTP context
+ */
+size_t flipper_http_queue_poll(FlipperHTTP *fhttp)
+{
+    if (!fhttp)
+    {
+        return 0;
+    }
+    size_t handled = 0;
+    while (true)
+    {
+        FlipperHTTPRequest finished;
+        bool found = false;
+        furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+        FlipperHTTPRequest *oldest = &fhttp->queue[fhttp->queue_head];
+        if (fhttp->queue_sent > 0 && oldest != fhttp->queue_current)
+        {
+            finished = *oldest;
+            memset(oldest, 0, sizeof(FlipperHTTPRequest));
+            fhttp->queue_head = (fhttp->queue_head + 1) % HTTP_QUEUE_SIZE;
+            fhttp->queue_count--;
+            fhttp->queue_sent--;
+            found = true;
+        }
+        furi_mutex_release(fhttp->queue_mutex);
+        if (!found)
+        {
+            break;
+        }
+
+        // the callback runs outside the lock, so it may queue follow-up requests
+        if (finished.callback)
+        {
+            FlipperHTTPResponse response = {
+                .result = finished.result,
+                .status_code = finished.status_code,
+                .body = finished.body,
+                .body_len = finished.body_len,
+                .file_path = finished.file_path,
+            };
+            finished.callback(&response, finished.context);
+        }
+        free(finished.command);
+        free(finished.body);
+        handled++;
+    }
+    return handled;
+}
+
+/**
+ * @brief      Forget the callbacks of every queued request with the given context.
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ * @param      context   The context the requests were queued with (NULL does nothing).
+ * @note       Call before the context is destroyed.
+ */
+void flipper_http_queue_cancel(FlipperHTTP *fhttp, void *context)
+{
+    if (!fhttp || !context)
+    {
+        return;
+    }
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    for (uint8_t i = 0; i < fhttp->queue_count; i++)
+    {
+        FlipperHTTPRequest *request = &fhttp->queue[(fhttp->queue_head + i) % HTTP_QUEUE_SIZE];
+        if (request->context != context)
+        {
+            continue;
+        }
+        request->callback = NULL;
+        request->context = NULL;
+        if (i >= fhttp->queue_sent)
+        {
+            request->cancelled = true; // the worker skips it instead of sending it
+        }
+    }
+    furi_mutex_release(fhttp->queue_mutex);
+}
+
 // Function to set content length and status code
 static void set_header(FlipperHTTP *fhttp)
 {
@@ -1144,6 +1996,66 @@ static char *trim(const char *str)
     return trimmed_str;
 }
 
+/**
+ * @brief      Pick where the response that just started goes: the RAM sink if it fits, its file otherwise.
+ * @return     void
+ * @param      fhttp     The FlipperHTTP context (content_length already parsed).
+ */
+static void flipper_http_response_begin(FlipperHTTP *fhttp)
+{
+    fhttp->ram_active = false;
+    fhttp->ram_len = 0;
+    if (!fhttp->is_bytes_request && !fhttp->save_received_data)
+    {
+        return;
+    }
+    if (fhttp->queue_current && fhttp->content_length > 0 && fhttp->content_length < fhttp->queue_current->ram_limit)
+    {
+        // a queued request gets a buffer of exactly its announced size, handed to its callback
+        free(fhttp->queue_current->body);
+        fhttp->queue_current->body = (char *)malloc(fhttp->content_length + 1);
+        fhttp->ram_buffer = fhttp->queue_current->body;
+        fhttp->ram_size = fhttp->ram_buffer ? fhttp->content_length + 1 : 0;
+    }
+    // a small text response never touches storage; an unknown length goes to the file
+    if (!fhttp->is_bytes_request && fhttp->ram_buffer &&
+        fhttp->content_length > 0 && fhttp->content_length < fhttp->ram_size)
+    {
+        fhttp->ram_buffer[0] = '\0';
+        fhttp->ram_active = true;
+        return;
+    }
+    // open the response file once for the whole response
+    flipper_http_sink_open(&fhttp->sink, fhttp->file_path);
+}
+
+/**
+ * @brief      Append a received line to the current response.
+ * @return     true if the data was stored, false otherwise.
+ * @param      fhttp     The FlipperHTTP context.
+ * @param      data      The data to append.
+ * @param      data_size The size of the data.
+ */
+static bool flipper_http_response_write(FlipperHTTP *fhttp, const char *data, size_t data_size)
+{
+    if (!fhttp->ram_active)
+    {
+        return flipper_http_sink_write(&fhttp->sink, data, data_size);
+    }
+    if (fhttp->ram_len + data_size < fhttp->ram_size)
+    {
+        memcpy(&fhttp->ram_buffer[fhttp->ram_len], data, data_size);
+        fhttp->ram_len += data_size;
+        fhttp->ram_buffer[fhttp->ram_len] = '\0';
+        return true;
+    }
+    // longer than its Content-Length announced: carry on in the file
+    fhttp->ram_active = false;
+    return flipper_http_sink_open(&fhttp->sink, fhttp->file_path) &&
+           flipper_http_sink_write(&fhttp->sink, fhttp->ram_buffer, fhttp->ram_len) &&
+           flipper_http_sink_write(&fhttp->sink, data, data_size);
+}
+
 /**
  * @brief      Callback function to handle received data asynchronously.
  * @return     void
@@ -1176,10 +2088,30 @@ static void flipper_http_rx_callback(const char *line, void *context)
             strstr(trimmed_line, "[DELETE/END]") == NULL)
         {
             strncpy(fhttp->last_response, trimmed_line, RX_BUF_SIZE);
+
+            // queue websocket traffic so lines arriving between two consumer polls are not overwritten
+            if (__atomic_load_n(&fhttp->websocket_active, __ATOMIC_ACQUIRE))
+            {
+                line_ring_push(&fhttp->websocket_lines, trimmed_line, strlen(trimmed_line));
+            }
         }
     }
     free(trimmed_line); // Free the allocated memory for trimmed_line
 
+    if (fhttp->queue_draining)
+    {
+        // late answer to a timed-out queued request: store nothing, send the next request once it ends
+        fhttp->queue_drain_tick = furi_get_tick();
+        if (strstr(line, "/END]") != NULL || strstr(line, "[ERROR]") != NULL)
+        {
+            furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+            fhttp->queue_draining = false;
+            furi_mutex_release(fhttp->queue_mutex);
+            furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
+        }
+        return;
+    }
+
     if (fhttp->state != INACTIVE && fhttp->state != ISSUE)
     {
         fhttp->state = RECEIVING;
@@ -1192,7 +2124,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
     if (fhttp->started_receiving && (fhttp->method == GET || fhttp->method == BYTES))
     {
         // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_restart(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         if (strstr(line, "[GET/END]") != NULL)
         {
@@ -1201,7 +2133,6 @@ static void flipper_http_rx_callback(const char *line, void *context)
             furi_timer_stop(fhttp->get_timeout_timer);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
-            fhttp->state = IDLE;
             fhttp->save_bytes = false;
             fhttp->save_received_data = false;
 
@@ -1211,7 +2142,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
                 const char marker[] = "[GET/END]";
                 const size_t marker_len = sizeof(marker) - 1; // Exclude null terminator
 
-                for (size_t i = 0; i <= fhttp->file_buffer_len - marker_len; i++)
+                for (size_t i = 0; i + marker_len <= fhttp->file_buffer_len; i++)
                 {
                     // Check if the marker is found
                     if (memcmp(&fhttp->file_buffer[i], marker, marker_len) == 0)
@@ -1227,27 +2158,28 @@ static void flipper_http_rx_callback(const char *line, void *context)
                 // If there is data left in the buffer, append it to the file
                 if (fhttp->file_buffer_len > 0)
                 {
-                    if (!flipper_http_append_to_file(fhttp->file_buffer, fhttp->file_buffer_len, false, fhttp->file_path))
-                    {
-                        FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-                    }
+                    flipper_http_sink_write(&fhttp->sink, fhttp->file_buffer, fhttp->file_buffer_len);
                     fhttp->file_buffer_len = 0;
                 }
             }
 
+            // close before going idle, so a caller that sees IDLE reads the whole file
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->is_bytes_request = false;
+            fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestOk);
             return;
         }
 
-        // Append the new line to the existing data
+        // Append the new line to the response
         if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started, fhttp->file_path))
+            !flipper_http_response_write(fhttp, line, strlen(line)))
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
             fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
             return;
         }
 
@@ -1262,7 +2194,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
     else if (fhttp->started_receiving && (fhttp->method == POST || fhttp->method == BYTES_POST))
     {
         // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_restart(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         if (strstr(line, "[POST/END]") != NULL)
         {
@@ -1271,7 +2203,6 @@ static void flipper_http_rx_callback(const char *line, void *context)
             furi_timer_stop(fhttp->get_timeout_timer);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
-            fhttp->state = IDLE;
             fhttp->save_bytes = false;
             fhttp->save_received_data = false;
 
@@ -1281,7 +2212,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
                 const char marker[] = "[POST/END]";
                 const size_t marker_len = sizeof(marker) - 1; // Exclude null terminator
 
-                for (size_t i = 0; i <= fhttp->file_buffer_len - marker_len; i++)
+                for (size_t i = 0; i + marker_len <= fhttp->file_buffer_len; i++)
                 {
                     // Check if the marker is found
                     if (memcmp(&fhttp->file_buffer[i], marker, marker_len) == 0)
@@ -1297,27 +2228,28 @@ static void flipper_http_rx_callback(const char *line, void *context)
                 // If there is data left in the buffer, append it to the file
                 if (fhttp->file_buffer_len > 0)
                 {
-                    if (!flipper_http_append_to_file(fhttp->file_buffer, fhttp->file_buffer_len, false, fhttp->file_path))
-                    {
-                        FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-                    }
+                    flipper_http_sink_write(&fhttp->sink, fhttp->file_buffer, fhttp->file_buffer_len);
                     fhttp->file_buffer_len = 0;
                 }
             }
 
+            // close before going idle, so a caller that sees IDLE reads the whole file
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->is_bytes_request = false;
+            fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestOk);
             return;
         }
 
-        // Append the new line to the existing data
+        // Append the new line to the response
         if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started, fhttp->file_path))
+            !flipper_http_response_write(fhttp, line, strlen(line)))
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
             fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
             return;
         }
 
@@ -1332,7 +2264,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
     else if (fhttp->started_receiving && fhttp->method == PUT)
     {
         // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_restart(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         if (strstr(line, "[PUT/END]") != NULL)
         {
@@ -1341,22 +2273,24 @@ static void flipper_http_rx_callback(const char *line, void *context)
             furi_timer_stop(fhttp->get_timeout_timer);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
-            fhttp->state = IDLE;
             fhttp->save_bytes = false;
             fhttp->is_bytes_request = false;
             fhttp->save_received_data = false;
+            flipper_http_sink_close(&fhttp->sink);
+            fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestOk);
             return;
         }
 
-        // Append the new line to the existing data
+        // Append the new line to the response
         if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started, fhttp->file_path))
+            !flipper_http_response_write(fhttp, line, strlen(line)))
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
             fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
             return;
         }
 
@@ -1371,7 +2305,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
     else if (fhttp->started_receiving && fhttp->method == DELETE)
     {
         // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_restart(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         if (strstr(line, "[DELETE/END]") != NULL)
         {
@@ -1380,22 +2314,24 @@ static void flipper_http_rx_callback(const char *line, void *context)
             furi_timer_stop(fhttp->get_timeout_timer);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
-            fhttp->state = IDLE;
             fhttp->save_bytes = false;
             fhttp->is_bytes_request = false;
             fhttp->save_received_data = false;
+            flipper_http_sink_close(&fhttp->sink);
+            fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestOk);
             return;
         }
 
-        // Append the new line to the existing data
+        // Append the new line to the response
         if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started, fhttp->file_path))
+            !flipper_http_response_write(fhttp, line, strlen(line)))
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
+            flipper_http_sink_close(&fhttp->sink);
             fhttp->started_receiving = false;
             fhttp->just_started = false;
             fhttp->state = IDLE;
+            flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
             return;
         }
 
@@ -1423,7 +2359,7 @@ static void flipper_http_rx_callback(const char *line, void *context)
     else if (strstr(line, "[GET/SUCCESS]") != NULL)
     {
         // FURI_LOG_I(HTTP_TAG, "GET request succeeded.");
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         fhttp->started_receiving = true;
         fhttp->state = RECEIVING;
@@ -1435,12 +2371,13 @@ static void flipper_http_rx_callback(const char *line, void *context)
 
         // set header
         set_header(fhttp);
+        flipper_http_response_begin(fhttp);
         return;
     }
     else if (strstr(line, "[POST/SUCCESS]") != NULL)
     {
         // FURI_LOG_I(HTTP_TAG, "POST request succeeded.");
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         fhttp->started_receiving = true;
         fhttp->state = RECEIVING;
@@ -1452,30 +2389,33 @@ static void flipper_http_rx_callback(const char *line, void *context)
 
         // set header
         set_header(fhttp);
+        flipper_http_response_begin(fhttp);
         return;
     }
     else if (strstr(line, "[PUT/SUCCESS]") != NULL)
     {
         // FURI_LOG_I(HTTP_TAG, "PUT request succeeded.");
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         fhttp->started_receiving = true;
         fhttp->state = RECEIVING;
 
         // set header
         set_header(fhttp);
+        flipper_http_response_begin(fhttp);
         return;
     }
     else if (strstr(line, "[DELETE/SUCCESS]") != NULL)
     {
         // FURI_LOG_I(HTTP_TAG, "DELETE request succeeded.");
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        furi_timer_start(fhttp->get_timeout_timer, fhttp->timeout_ticks);
 
         fhttp->started_receiving = true;
         fhttp->state = RECEIVING;
 
         // set header
         set_header(fhttp);
+        flipper_http_response_begin(fhttp);
         return;
     }
     else if (strstr(line, "[DISCONNECTED]") != NULL)
@@ -1486,6 +2426,8 @@ static void flipper_http_rx_callback(const char *line, void *context)
     {
         FURI_LOG_E(HTTP_TAG, "Received error: %s", line);
         fhttp->state = ISSUE;
+        furi_timer_stop(fhttp->get_timeout_timer);
+        flipper_http_queue_finish(fhttp, FlipperHTTPRequestFailed);
         return;
     }
     else if (strstr(line, "[PONG]") != NULL)
@@ -1552,6 +2494,21 @@ bool flipper_http_websocket_start(FlipperHTTP *fhttp, const char *url, uint16_t
         return false;
     }
 
+    // queued requests would be written onto the socket, so they must be done first
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    if (flipper_http_queue_busy(fhttp))
+    {
+        furi_mutex_release(fhttp->queue_mutex);
+        FURI_LOG_E("FlipperHTTP", "Another request is still outstanding.");
+        return false;
+    }
+
+    // Start queueing incoming lines from an empty ring
+    __atomic_store_n(&fhttp->websocket_active, false, __ATOMIC_RELEASE);
+    line_ring_reset(&fhttp->websocket_lines);
+    __atomic_store_n(&fhttp->websocket_active, true, __ATOMIC_RELEASE);
+    furi_mutex_release(fhttp->queue_mutex);
+
     // Send WebSocket request via UART
     return flipper_http_send_data(fhttp, command);
 }
@@ -1569,5 +2526,36 @@ bool flipper_http_websocket_stop(FlipperHTTP *fhttp)
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
         return false;
     }
-    return flipper_http_send_data(fhttp, "[SOCKET/STOP]");
+    __atomic_store_n(&fhttp->websocket_active, false, __ATOMIC_RELEASE);
+    bool sent = flipper_http_send_data(fhttp, "[SOCKET/STOP]");
+    // requests queued while the socket was open go out behind the stop command
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
+    return sent;
+}
+
+/**
+ * @brief      Take the oldest queued websocket line.
+ * @return     The line length, or 0 if no line is queued.
+ * @param fhttp The FlipperHTTP context
+ * @param      out       Buffer for the NUL-terminated line (WS_LINE_MAX bytes always suffice).
+ * @param      out_size  Size of out; a longer line is truncated.
+ * @note       Lock-free; call from a single consumer thread only.
+ */
+size_t flipper_http_websocket_read_line(FlipperHTTP *fhttp, char *out, size_t out_size)
+{
+    if (!fhttp || !out)
+    {
+        return 0;
+    }
+    return line_ring_pop(&fhttp->websocket_lines, out, out_size);
+}
+
+/**
+ * @brief      Number of websocket lines dropped since the socket was started.
+ * @return     The dropped line count.
+ * @param fhttp The FlipperHTTP context
+ */
+uint32_t flipper_http_websocket_dropped_lines(FlipperHTTP *fhttp)
+{
+    return fhttp ? __atomic_load_n(&fhttp->websocket_lines.dropped, __ATOMIC_RELAXED) : 0;
 }
\ No newline at end of file
@@ -28,6 +28,18 @@ extern "C"
 #define RX_LINE_BUFFER_SIZE 2048          // UART RX line buffer size (increase for large responses)
 #define MAX_FILE_SHOW 2048                // Maximum data from file to show
 #define FILE_BUFFER_SIZE 512              // File buffer size
+#define WS_LINE_RING_SIZE 1024            // Websocket line ring size in bytes (power of two)
+#define WS_LINE_MAX 256                   // Longest websocket line kept in the ring
+#define TX_BUF_SIZE 1024                  // UART TX stream buffer size (bytes queued for the worker to write)
+#define TX_CHUNK_SIZE 64                  // Bytes the worker writes per UART call
+#define TX_FLUSH_ON_FREE_MS 100           // Time given to queued bytes before the UART is released
+#define HTTP_QUEUE_SIZE 4                 // Requests the request queue holds (waiting, in flight and finished)
+#define HTTP_QUEUE_PATH_SIZE 128          // Longest response file path of a queued request
+#define HTTP_QUEUE_DRAIN_MS 10000         // Quiet time after a timed-out request before the next one is sent
+#define SINK_SECTOR_SIZE 512              // Response file writes are gathered into blocks of this size
+#define RX_BLOCK_SIZE 128                 // Bytes the worker takes from the RX stream per call
+#define RX_SIGNAL_THRESHOLD 32            // Received bytes after which the ISR wakes the worker without waiting for a newline or idle line
+#define RX_IDLE_POLL_MS 50                // Worker poll for a tail the ISR did not signal (no idle interrupt)
 
     // Forward declaration for callback
     typedef void (*FlipperHTTP_Callback)(const char *line, void *context);
@@ -47,8 +59,19 @@ extern "C"
     {
         WorkerEvtStop = (1 << 0),
         WorkerEvtRxDone = (1 << 1),
+        WorkerEvtTxPending = (1 << 2),
+        WorkerEvtRxTimeout = (1 << 3),
+        WorkerEvtQueue = (1 << 4),
     } WorkerEvtFlags;
 
+    // Result of queueing data for the UART
+    typedef enum
+    {
+        FlipperHTTPTxQueued,   // Queued; the worker thread writes it
+        FlipperHTTPTxFull,     // Not enough room right now; try again later
+        FlipperHTTPTxRejected, // Never sendable (empty, longer than the buffer, or the UART is inactive)
+    } FlipperHTTPTxStatus;
+
     typedef enum
     {
         GET,    // GET request
@@ -73,6 +96,63 @@ extern "C"
         HTTP_CMD_PING
     } HTTPCommand; // list of non-input commands
 
+    // Lock-free single-producer (UART worker) / single-consumer (game thread) ring of websocket lines.
+    // Each line is stored as a 2-byte length followed by its bytes; head and tail are free-running.
+    typedef struct
+    {
+        uint8_t data[WS_LINE_RING_SIZE]; // line records
+        uint32_t head;                   // write position, only advanced by the producer
+        uint32_t tail;                   // read position, only advanced by the consumer
+        uint32_t dropped;                // lines dropped because the ring was full or the line too long
+    } FlipperHTTPLineRing;
+
+    // Response file kept open from [*/SUCCESS] to [*/END] (or the timeout); only the worker thread touches it
+    typedef struct
+    {
+        Storage *storage;                 // Storage record, held while the file is open
+        File *file;                       // Open response file (NULL when closed)
+        uint8_t buffer[SINK_SECTOR_SIZE]; // Write-behind buffer
+        size_t buffer_len;                // Bytes waiting in buffer
+        bool failed;                      // A write failed; the rest of the response is dropped
+    } FlipperHTTPFileSink;
+
+    // Outcome of a queued request
+    typedef enum
+    {
+        FlipperHTTPRequestOk,       // The response ended normally
+        FlipperHTTPRequestFailed,   // Not sent, answered with [ERROR], or the response could not be stored
+        FlipperHTTPRequestTimedOut, // Nothing arrived for the request's timeout
+    } FlipperHTTPRequestResult;
+
+    // Finished request, as handed to its callback
+    typedef struct
+    {
+        FlipperHTTPRequestResult result; // How the request ended
+        int status_code;                 // HTTP status code (0 if no header arrived)
+        const char *body;                // NUL-terminated body if it was kept in RAM, NULL if it is in file_path
+        size_t body_len;                 // Length of body
+        const char *file_path;           // File the body was written to when it was not kept in RAM
+    } FlipperHTTPResponse;
+
+    typedef void (*FlipperHTTPRequestCallback)(const FlipperHTTPResponse *response, void *context);
+
+    // One entry of the request queue
+    typedef struct
+    {
+        char *command;                         // Request line, freed once it is sent
+        HTTPMethod method;                     // HTTP method
+        char file_path[HTTP_QUEUE_PATH_SIZE];  // Response file when the body is not kept in RAM
+        size_t ram_limit;                      // The body stays in RAM when its Content-Length is below this (0: always the file)
+        uint32_t timeout_ms;                   // Silence after which the request times out
+        FlipperHTTPRequestCallback callback;   // Called from flipper_http_queue_poll once the request ends (may be NULL)
+        void *context;                         // Context for the callback
+        FlipperHTTPRequestResult result;       // Set by the worker when the request ends
+        int status_code;                       // Set by the worker when the request ends
+        char *body;                            // Body kept in RAM (allocated to its Content-Length by the worker)
+        size_t body_len;                       // Length of body
+        bool cancelled;                        // Dropped by flipper_http_queue_cancel before it was sent
+    } FlipperHTTPRequest;
+
     // FlipperHTTP Structure
     typedef struct
     {
@@ -95,10 +175,35 @@ extern "C"
         bool just_started_bytes;                  // Indicates if bytes data reception has just started
         size_t bytes_received;                    // Number of bytes received
         char rx_line_buffer[RX_LINE_BUFFER_SIZE]; // Buffer for received lines
+        uint8_t rx_block[RX_BLOCK_SIZE];          // Block the worker takes from the RX stream (kept off its 1 KB stack)
         uint8_t file_buffer[FILE_BUFFER_SIZE];    // Buffer for file data
         size_t file_buffer_len;                   // Length of the file buffer
         size_t content_length;                    // Length of the content received
         int status_code;                          // HTTP status code
+        bool websocket_active;                    // Lines are also queued in websocket_lines while a socket is open
+        FlipperHTTPLineRing websocket_lines;      // Incoming websocket lines for the consumer thread
+        FuriStreamBuffer *tx_stream;              // Outgoing bytes, written to the UART by the worker thread
+        FuriMutex *tx_mutex;                      // Keeps each queued line contiguous when several threads send
+        uint32_t tx_queued;                       // Bytes queued since alloc (free-running)
+        uint32_t tx_written;                      // Bytes written to the UART since alloc (free-running)
+        uint32_t tx_busy_ms;                      // Time the worker spent writing to the UART since alloc
+        size_t rx_line_pos;                       // Length of the line being assembled in rx_line_buffer
+        FlipperHTTPFileSink sink;                 // Response file of the request being received
+        char *ram_buffer;                         // Body buffer of the queued request being received (NULL: use the file)
+        size_t ram_size;                          // Size of ram_buffer
+        size_t ram_len;                           // Bytes of the response held in ram_buffer
+        bool ram_active;                          // The current (or last) response went to ram_buffer instead of the file
+        uint32_t timeout_ticks;                   // Silence allowed before the current request times out
+        FlipperHTTPRequest queue[HTTP_QUEUE_SIZE]; // Request queue, oldest at queue_head
+        FuriMutex *queue_mutex;                   // Guards the queue indices between the worker and the polling thread
+        uint8_t queue_head;                       // Oldest request not yet handed to its callback
+        uint8_t queue_count;                      // Requests in the queue (finished, in flight and waiting)
+        uint8_t queue_sent;                       // Requests from queue_head already sent (the newest of them may be in flight)
+        FlipperHTTPRequest *queue_current;        // Request being received (NULL when none)
+        bool line_busy;                           // A direct or queued request owns the line until its answer ends
+        bool queue_draining;                      // A request timed out; its late answer is discarded before the next is sent
+        uint32_t queue_drain_tick;                // Tick of the timeout or of the last discarded line
+        uint32_t rx_unsignalled;                  // Bytes the ISR queued since it last woke the worker (ISR only)
     } FlipperHTTP;
 
     /**
@@ -198,6 +303,7 @@ extern "C"
      * @param      headers  The headers to send with the request.
      * @param      payload  The data to send with the request.
      * @note       The received data will be handled asynchronously via the callback.
+     * @note       Fails while queued requests are waiting or in flight.
      */
     bool flipper_http_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url, const char *headers, const char *payload);
 
@@ -219,14 +325,111 @@ extern "C"
     bool flipper_http_send_command(FlipperHTTP *fhttp, HTTPCommand command);
 
     /**
-     * @brief      Send data over UART with newline termination.
-     * @return     true if the data was sent successfully, false otherwise.
+     * @brief      Queue data for the UART with newline termination.
+     * @return     true if the data was queued, false otherwise.
      * @param fhttp The FlipperHTTP context
      * @param      data  The data to send over UART.
-     * @note       The data will be sent over UART with a newline character appended.
+     * @note       Never blocks; the worker thread writes the data. Use flipper_http_send_data_async to tell a full queue from an error.
      */
     bool flipper_http_send_data(FlipperHTTP *fhttp, const char *data);
 
+    /**
+     * @brief      Queue data for the UART with newline termination.
+     * @return     FlipperHTTPTxQueued, FlipperHTTPTxFull if the queue has no room for it yet, FlipperHTTPTxRejected otherwise.
+     * @param fhttp The FlipperHTTP context
+     * @param      data  The data to send over UART (at most TX_BUF_SIZE - 1 bytes).
+     * @note       Never blocks; a line is queued whole or not at all.
+     */
+    FlipperHTTPTxStatus flipper_http_send_data_async(FlipperHTTP *fhttp, const char *data);
+
+    /**
+     * @brief      Wait until every queued byte has been written to the UART.
+     * @return     true if the queue drained, false on timeout.
+     * @param fhttp The FlipperHTTP context
+     * @param      timeout_ms  Longest time to wait.
+     */
+    bool flipper_http_tx_flush(FlipperHTTP *fhttp, uint32_t timeout_ms);
+
+    /**
+     * @brief      Bytes queued but not yet written to the UART.
+     * @return     The number of pending bytes.
+     * @param fhttp The FlipperHTTP context
+     */
+    size_t flipper_http_tx_pending(FlipperHTTP *fhttp);
+
+    /**
+     * @brief      Time the worker has spent writing to the UART since alloc.
+     * @return     The busy time in milliseconds (free-running).
+     * @param fhttp The FlipperHTTP context
+     */
+    uint32_t flipper_http_tx_busy_ms(FlipperHTTP *fhttp);
+
+    /**
+     * @brief      Queue a request; the worker sends it as soon as the request before it ends.
+     * @return     true if the request was queued, false if the queue is full or the request is invalid.
+     * @param fhttp The FlipperHTTP context
+     * @param      method     GET, POST, PUT or DELETE (bytes requests are not queued).
+     * @param      url        The URL to send the request to.
+     * @param      headers    The headers to send with the request.
+     * @param      payload    The data to send with the request (NULL for GET).
+     * @param      file_path  Where the body is written when it is not kept in RAM.
+     * @param      ram_limit  The body is kept in RAM when its Content-Length is below this (0: always the file).
+     * @param      timeout_ms Silence after which the request times out.
+     * @param      callback   Called from flipper_http_queue_poll once the request ends (may be NULL).
+     * @param      context    Context for the callback.
+     * @note       Waits while a direct request is answered or a websocket is open.
+     */
+    bool flipper_http_queue_request(FlipperHTTP *fhttp, HTTPMethod method, const char *url, const char *headers, const char *payload,
+                                    const char *file_path, size_t ram_limit, uint32_t timeout_ms,
+                                    FlipperHTTPRequestCallback callback, void *context);
+
+    /**
+     * @brief      Hand finished queued requests to their callbacks, oldest first.
+     * @return     The number of requests handed over.
+     * @param fhttp The FlipperHTTP context
+     * @note       Callbacks run in the calling thread; a body in RAM is freed when its callback returns.
+     */
+    size_t flipper_http_queue_poll(FlipperHTTP *fhttp);
+
+    /**
+     * @brief      Forget the callbacks of every queued request with the given context.
+     * @return     void
+     * @param fhttp The FlipperHTTP context
+     * @param      context   The context the requests were queued with (NULL does nothing).
+     * @note       Requests not yet sent are dropped; one in flight still ends normally but runs no callback.
+     */
+    void flipper_http_queue_cancel(FlipperHTTP *fhttp, void *context);
+
+#ifdef FLIPPER_HTTP_BENCHMARK
+    /**
+     * @brief      Measure the worker's receive loop, block reads against the old one-byte loop.
+     * @return     true if both loops ran and split the same number of lines.
+     * @param      total_bytes          Bytes of synthetic 64-byte lines to push through each loop.
+     * @param      block_bytes_per_sec  Throughput of the block loop (RX_BLOCK_SIZE reads, memchr line splitting).
+     * @param      byte_bytes_per_sec   Throughput of the previous worker loop (one stream call per byte).
+     * @note       Timed with the DWT cycle counter; uses its own stream buffer and context.
+     * @note       Add cdefines=["FLIPPER_HTTP_BENCHMARK"] to application.fam; the app runs it once at start and logs the rates.
+     */
+    bool flipper_http_rx_benchmark(size_t total_bytes, uint32_t *block_bytes_per_sec, uint32_t *byte_bytes_per_sec);
+#endif
+
+    /**
+     * @brief      Take the oldest queued websocket line.
+     * @return     The line length, or 0 if no line is queued.
+     * @param fhttp The FlipperHTTP context
+     * @param      out       Buffer for the NUL-terminated line (WS_LINE_MAX bytes always suffice).
+     * @param      out_size  Size of out; a longer line is truncated.
+     * @note       Lock-free; call from a single consumer thread only.
+     */
+    size_t flipper_http_websocket_read_line(FlipperHTTP *fhttp, char *out, size_t out_size);
+
+    /**
+     * @brief      Number of websocket lines dropped since the socket was started.
+     * @return     The dropped line count.
+     * @param fhttp The FlipperHTTP context
+     */
+    uint32_t flipper_http_websocket_dropped_lines(FlipperHTTP *fhttp);
+
     /**
      * @brief      Send a request to the specified URL to start a WebSocket connection.
      * @return     true if the request was successful, false otherwise.
@@ -235,6 +438,7 @@ extern "C"
      * @param port The port to connect to
      * @param headers The headers to send with the WebSocket request
      * @note       The received data will be handled asynchronously via the callback.
+     * @note       Fails while queued requests are waiting or in flight.
      */
     bool flipper_http_websocket_start(FlipperHTTP *fhttp, const char *url, uint16_t port, const char *headers);
 
@@ -445,6 +445,91 @@ int jsoneq(const char *json, jsmntok_t *tok, const char *s)
     return -1;
 }
 
+// Helper function to skip a token and all its descendants.
+// Returns the index of the next token after skipping this one.
+// On error or out of bounds, returns -1.
+static int skip_token(const jsmntok_t *tokens, int start, int total)
+{
+    if (start < 0 || start >= total)
+        return -1;
+
+    int i = start;
+    if (tokens[i].type == JSMN_OBJECT)
+    {
+        // For an object: size is number of key-value pairs
+        int pairs = tokens[i].size;
+        i++; // move to first key-value pair
+        for (int p = 0; p < pairs; p++)
+        {
+            // skip key (primitive/string)
+            i++;
+            if (i >= total)
+                return -1;
+            // skip value (which could be object/array and must be skipped recursively)
+            i = skip_token(tokens, i, total);
+            if (i == -1)
+                return -1;
+        }
+        return i; // i is now just past the object
+    }
+    else if (tokens[i].type == JSMN_ARRAY)
+    {
+        // For an array: size is number of elements
+        int elems = tokens[i].size;
+        i++; // move to first element
+        for (int e = 0; e < elems; e++)
+        {
+            i = skip_token(tokens, i, total);
+            if (i == -1)
+                return -1;
+        }
+        return i; // i is now just past the array
+    }
+    else
+    {
+        // Primitive or string token, just skip it
+        return i + 1;
+    }
+}
+
+// Depth-first search (in document order) for key in key position only, so a string
+// value that happens to equal the key is never matched. Returns the value token index or -1.
+static int find_key_token(const char *json, jsmntok_t *tokens, int tok, int total, const char *key)
+{
+    if (tok < 0 || tok >= total)
+        return -1;
+
+    if (tokens[tok].type == JSMN_OBJECT)
+    {
+        int i = tok + 1;
+        for (int p = 0; p < tokens[tok].size && i + 1 < total; p++)
+        {
+            if (jsoneq(json, &tokens[i], key) == 0)
+                return i + 1;
+            int found = find_key_token(json, tokens, i + 1, total, key);
+            if (found != -1)
+                return found;
+            i = skip_token(tokens, i + 1, total);
+            if (i == -1)
+                return -1;
+        }
+    }
+    else if (tokens[tok].type == JSMN_ARRAY)
+    {
+        int i = tok + 1;
+        for (int e = 0; e < tokens[tok].size && i < total; e++)
+        {
+            int found = find_key_token(json, tokens, i, total, key);
+            if (found != -1)
+                return found;
+            i = skip_token(tokens, i, total);
+            if (i == -1)
+                return -1;
+        }
+    }
+    return -1;
+}
+
 // Return the value of the key in the JSON data
 char *get_json_value(const char *key, const char *json_data)
 {
@@ -484,26 +569,24 @@ char *get_json_value(const char *key, const char *json_data)
             return NULL;
         }
 
-        // Loop through the tokens to find the key
-        for (int i = 1; i < ret; i++)
+        // Find the key (object keys only, values are never matched)
+        int value_token = find_key_token(json_data, tokens, 0, ret, key);
+        if (value_token != -1)
         {
-            if (jsoneq(json_data, &tokens[i], key) == 0)
+            // We found the key. Now, return the associated value.
+            int length = tokens[value_token].end - tokens[value_token].start;
+            char *value = malloc(length + 1);
+            if (value == NULL)
             {
-                // We found the key. Now, return the associated value.
-                int length = tokens[i + 1].end - tokens[i + 1].start;
-                char *value = malloc(length + 1);
-                if (value == NULL)
-                {
-                    FURI_LOG_E("JSMM.H", "Failed to allocate memory for value.");
-                    free(tokens);
-                    return NULL;
-                }
-                strncpy(value, json_data + tokens[i + 1].start, length);
-                value[length] = '\0'; // Null-terminate the string
-
-                free(tokens); // Free the token array
-                return value; // Return the extracted value
+                FURI_LOG_E("JSMM.H", "Failed to allocate memory for value.");
+                free(tokens);
+                return NULL;
             }
+            strncpy(value, json_data + tokens[value_token].start, length);
+            value[length] = '\0'; // Null-terminate the string
+
+            free(tokens); // Free the token array
+            return value; // Return the extracted value
         }
 
         // Free the token array if key was not found
@@ -519,53 +602,6 @@ char *get_json_value(const char *key, const char *json_data)
     return NULL; // Return NULL if something goes wrong
 }
 
-// Helper function to skip a token and all its descendants.
-// Returns the index of the next token after skipping this one.
-// On error or out of bounds, returns -1.
-static int skip_token(const jsmntok_t *tokens, int start, int total)
-{
-    if (start < 0 || start >= total)
-        return -1;
-
-    int i = start;
-    if (tokens[i].type == JSMN_OBJECT)
-    {
-        // For an object: size is number of key-value pairs
-        int pairs = tokens[i].size;
-        i++; // move to first key-value pair
-        for (int p = 0; p < pairs; p++)
-        {
-            // skip key (primitive/string)
-            i++;
-            if (i >= total)
-                return -1;
-            // skip value (which could be object/array and must be skipped recursively)
-            i = skip_token(tokens, i, total);
-            if (i == -1)
-                return -1;
-        }
-        return i; // i is now just past the object
-    }
-    else if (tokens[i].type == JSMN_ARRAY)
-    {
-        // For an array: size is number of elements
-        int elems = tokens[i].size;
-        i++; // move to first element
-        for (int e = 0; e < elems; e++)
-        {
-            i = skip_token(tokens, i, total);
-            if (i == -1)
-                return -1;
-        }
-        return i; // i is now just past the array
-    }
-    else
-    {
-        // Primitive or string token, just skip it
-        return i + 1;
-    }
-}
-
 // Revised get_json_array_value
 char *get_json_array_value(const char *key, uint32_t index, const char *json_data)
 {
@@ -801,3 +837,439 @@ int json_token_count(const char *json)
     int ret = jsmn_parse(&parser, json, strlen(json), NULL, 0);
     return ret; // If ret >= 0, it represents the number of tokens needed.
 }
+
+bool json_doc_parse(JsonDoc *doc, const char *json, size_t len, jsmntok_t *tokens, unsigned int capacity)
+{
+    if (doc == NULL || json == NULL || tokens == NULL || capacity == 0)
+    {
+        FURI_LOG_E("JSMM.H", "Invalid arguments to json_doc_parse.");
+        return false;
+    }
+
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    int ret = jsmn_parse(&parser, json, len, tokens, capacity);
+    if (ret < 1)
+    {
+        FURI_LOG_E("JSMM.H", "Failed to parse JSON document: %d", ret);
+        doc->count = 0;
+        return false;
+    }
+
+    doc->json = json;
+    doc->tokens = tokens;
+    doc->count = ret;
+    return true;
+}
+
+bool json_doc_parse_alloc(JsonDoc *doc, const char *json, size_t len)
+{
+    if (doc == NULL || json == NULL)
+    {
+        FURI_LOG_E("JSMM.H", "Invalid arguments to json_doc_parse_alloc.");
+        return false;
+    }
+    doc->tokens = NULL;
+    doc->count = 0;
+
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    int max_tokens = jsmn_parse(&parser, json, len, NULL, 0);
+    if (max_tokens < 1)
+    {
+        FURI_LOG_E("JSMM.H", "Failed to count JSON tokens: %d", max_tokens);
+        return false;
+    }
+    if (!jsmn_memory_check(max_tokens))
+    {
+        FURI_LOG_E("JSMM.H", "Insufficient memory for JSON tokens.");
+        return false;
+    }
+    jsmntok_t *tokens = malloc(sizeof(jsmntok_t) * max_tokens);
+    if (tokens == NULL)
+    {
+        FURI_LOG_E("JSMM.H", "Failed to allocate memory for JSON tokens.");
+        return false;
+    }
+    if (!json_doc_parse(doc, json, len, tokens, max_tokens))
+    {
+        free(tokens);
+        doc->tokens = NULL;
+        return false;
+    }
+    return true;
+}
+
+void json_doc_free(JsonDoc *doc)
+{
+    if (doc == NULL)
+    {
+        return;
+    }
+    free(doc->tokens);
+    doc->tokens = NULL;
+    doc->count = 0;
+}
+
+// Find the value token for a key given as (ptr,len) among the pairs of the object token obj
+static int json_doc_find_n(const JsonDoc *doc, int obj, const char *key, size_t key_len)
+{
+    if (doc == NULL || key == NULL || obj < 0 || obj >= doc->count || doc->tokens[obj].type != JSMN_OBJECT)
+    {
+        return -1;
+    }
+
+    // walk the key/value pairs of this object only, skipping nested values as whole subtrees
+    int pairs = doc->tokens[obj].size;
+    int i = obj + 1;
+    for (int p = 0; p < pairs && i < doc->count - 1; p++)
+    {
+        const jsmntok_t *tok = &doc->tokens[i];
+        if (tok->type == JSMN_STRING && (size_t)(tok->end - tok->start) == key_len &&
+            strncmp(doc->json + tok->start, key, key_len) == 0)
+        {
+            return i + 1;
+        }
+        i = skip_token(doc->tokens, i + 1, doc->count);
+        if (i == -1)
+        {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+int json_doc_find(const JsonDoc *doc, int obj, const char *key)
+{
+    return key ? json_doc_find_n(doc, obj, key, strlen(key)) : -1;
+}
+
+int json_doc_path(const JsonDoc *doc, int root, const char *path)
+{
+    if (doc == NULL || path == NULL)
+    {
+        return -1;
+    }
+
+    int tok = root;
+    const char *p = path;
+    while (*p && tok != -1)
+    {
+        if (*p == '[')
+        {
+            // array index: step over the preceding elements without descending into them
+            char *end = NULL;
+            long index = strtol(p + 1, &end, 10);
+            if (end == p + 1 || *end != ']' || index < 0 ||
+                tok < 0 || tok >= doc->count || doc->tokens[tok].type != JSMN_ARRAY ||
+                index >= doc->tokens[tok].size)
+            {
+                return -1;
+            }
+            int element = tok + 1;
+            for (long e = 0; e < index && element != -1; e++)
+            {
+                element = skip_token(doc->tokens, element, doc->count);
+            }
+            tok = element;
+            p = end + 1;
+        }
+        else
+        {
+            if (*p == '.')
+            {
+                p++;
+            }
+            size_t len = strcspn(p, ".[");
+            if (len == 0)
+            {
+                return -1;
+            }
+            tok = json_doc_find_n(doc, tok, p, len);
+            p += len;
+        }
+    }
+    return tok;
+}
+
+JsonView json_doc_view(const JsonDoc *doc, int tok)
+{
+    JsonView view = {NULL, 0};
+    if (doc == NULL || tok < 0 || tok >= doc->count)
+    {
+        return view;
+    }
+    view.ptr = doc->json + doc->tokens[tok].start;
+    view.len = doc->tokens[tok].end - doc->tokens[tok].start;
+    return view;
+}
+
+bool json_doc_get_view(const JsonDoc *doc, int obj, const char *key, JsonView *out)
+{
+    int tok = json_doc_path(doc, obj, key);
+    if (tok < 0)
+    {
+        return false;
+    }
+    *out = json_doc_view(doc, tok);
+    return true;
+}
+
+// Return a view of the primitive token at key/path, or an empty view if missing or not a primitive
+static JsonView json_doc_get_primitive(const JsonDoc *doc, int obj, const char *key)
+{
+    int tok = json_doc_path(doc, obj, key);
+    if (tok < 0 || doc->tokens[tok].type != JSMN_PRIMITIVE)
+    {
+        JsonView none = {NULL, 0};
+        return none;
+    }
+    return json_doc_view(doc, tok);
+}
+
+bool json_doc_get_int(const JsonDoc *doc, int obj, const char *key, int32_t *out)
+{
+    return json_view_to_int(json_doc_get_primitive(doc, obj, key), out);
+}
+
+bool json_doc_get_float(const JsonDoc *doc, int obj, const char *key, float *out)
+{
+    return json_view_to_float(json_doc_get_primitive(doc, obj, key), out);
+}
+
+bool json_doc_get_fixed(const JsonDoc *doc, int obj, const char *key, uint8_t decimals, int32_t *out)
+{
+    return json_view_to_fixed(json_doc_get_primitive(doc, obj, key), decimals, out);
+}
+
+bool json_doc_get_bool(const JsonDoc *doc, int obj, const char *key, bool *out)
+{
+    int tok = json_doc_path(doc, obj, key);
+    if (tok < 0 || doc->tokens[tok].type != JSMN_PRIMITIVE)
+    {
+        return false;
+    }
+    JsonView view = json_doc_view(doc, tok);
+    if (json_view_eq(view, "true"))
+    {
+        *out = true;
+        return true;
+    }
+    if (json_view_eq(view, "false"))
+    {
+        *out = false;
+        return true;
+    }
+    return false;
+}
+
+bool json_array_iter_init(JsonArrayIter *iter, const JsonDoc *doc, int arr)
+{
+    if (iter == NULL)
+    {
+        return false;
+    }
+    iter->doc = doc;
+    iter->next = -1;
+    iter->remaining = 0;
+    if (doc == NULL || arr < 0 || arr >= doc->count || doc->tokens[arr].type != JSMN_ARRAY)
+    {
+        return false;
+    }
+    iter->next = arr + 1;
+    iter->remaining = doc->tokens[arr].size;
+    return true;
+}
+
+int json_array_iter_next(JsonArrayIter *iter)
+{
+    if (iter == NULL || iter->remaining <= 0 || iter->next < 0 || iter->next >= iter->doc->count)
+    {
+        return -1;
+    }
+    int element = iter->next;
+    iter->remaining--;
+    // step over the whole element so nested objects/arrays are not yielded
+    iter->next = skip_token(iter->doc->tokens, element, iter->doc->count);
+    return element;
+}
+
+bool json_view_eq(JsonView view, const char *s)
+{
+    if (view.ptr == NULL || s == NULL)
+    {
+        return false;
+    }
+    return (int)strlen(s) == view.len && strncmp(view.ptr, s, view.len) == 0;
+}
+
+size_t json_view_copy(JsonView view, char *dest, size_t dest_size)
+{
+    if (dest == NULL || dest_size == 0)
+    {
+        return 0;
+    }
+    size_t length = view.ptr && view.len > 0 ? (size_t)view.len : 0;
+    if (length >= dest_size)
+    {
+        length = dest_size - 1;
+    }
+    if (length > 0)
+    {
+        memcpy(dest, view.ptr, length);
+    }
+    dest[length] = '\0';
+    return length;
+}
+
+// Decimal split into an integer mantissa and a power of ten: value = (negative ? -1 : 1) * mantissa * 10^exponent
+typedef struct
+{
+    bool negative;
+    uint32_t mantissa;
+    int exponent;
+} JsonDecimal;
+
+static const uint32_t json_pow10_u32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+// Scan [-]digits[.digits][(e|E)[+|-]digits] covering the whole view; keeps as many significant digits as fit in 32 bits
+static bool json_view_scan_decimal(JsonView view, JsonDecimal *out)
+{
+    if (view.ptr == NULL || view.len <= 0)
+    {
+        return false;
+    }
+    const char *p = view.ptr;
+    const char *end = view.ptr + view.len;
+    out->negative = false;
+    out->mantissa = 0;
+    out->exponent = 0;
+
+    if (*p == '-' || *p == '+')
+    {
+        out->negative = *p == '-';
+        p++;
+    }
+    bool digits = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+        digits = true;
+        if (out->mantissa <= 429496728u)
+            out->mantissa = out->mantissa * 10 + (uint32_t)(*p - '0');
+        else
+            out->exponent++; // digit dropped from the integer part still counts
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            digits = true;
+            if (out->mantissa <= 429496728u)
+            {
+                out->mantissa = out->mantissa * 10 + (uint32_t)(*p - '0');
+                out->exponent--;
+            }
+        }
+    }
+    if (!digits)
+    {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            exp_negative = *p == '-';
+            p++;
+        }
+        int exp = 0;
+        bool exp_digits = false;
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            exp_digits = true;
+            if (exp < 1000)
+                exp = exp * 10 + (*p - '0');
+        }
+        if (!exp_digits)
+        {
+            return false;
+        }
+        out->exponent += exp_negative ? -exp : exp;
+    }
+    return p == end;
+}
+
+// Scale a decimal to an integer at 10^-decimals resolution, rounding half away from zero
+static bool json_decimal_to_int(const JsonDecimal *decimal, int shift, bool round, int32_t *out)
+{
+    int exponent = decimal->exponent + shift;
+    uint64_t magnitude = decimal->mantissa;
+    if (exponent >= 0)
+    {
+        for (int i = 0; i < exponent && magnitude != 0; i++)
+        {
+            magnitude *= 10;
+            if (magnitude > 2147483648ull)
+                return false;
+        }
+    }
+    else if (-exponent > 9)
+    {
+        magnitude = 0;
+    }
+    else
+    {
+        uint32_t divisor = json_pow10_u32[-exponent];
+        magnitude = (magnitude + (round ? divisor / 2 : 0)) / divisor;
+    }
+    if (magnitude > (decimal->negative ? 2147483648ull : 2147483647ull))
+    {
+        return false;
+    }
+    *out = decimal->negative ? (int32_t)(0 - magnitude) : (int32_t)magnitude;
+    return true;
+}
+
+bool json_view_to_int(JsonView view, int32_t *out)
+{
+    JsonDecimal decimal;
+    return json_view_scan_decimal(view, &decimal) && json_decimal_to_int(&decimal, 0, false, out);
+}
+
+bool json_view_to_fixed(JsonView view, uint8_t decimals, int32_t *out)
+{
+    JsonDecimal decimal;
+    if (decimals > 6)
+    {
+        return false;
+    }
+    return json_view_scan_decimal(view, &decimal) && json_decimal_to_int(&decimal, decimals, true, out);
+}
+
+bool json_view_to_float(JsonView view, float *out)
+{
+    static const float pow10_f[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    JsonDecimal decimal;
+    if (!json_view_scan_decimal(view, &decimal))
+    {
+        return false;
+    }
+    float value = (float)decimal.mantissa;
+    int exponent = decimal.exponent;
+    while (exponent > 0 && value != 0.0f)
+    {
+        int step = exponent > 10 ? 10 : exponent;
+        value *= pow10_f[step];
+        exponent -= step;
+    }
+    while (exponent < 0 && value != 0.0f)
+    {
+        int step = -exponent > 10 ? 10 : -exponent;
+        value /= pow10_f[step];
+        exponent += step;
+    }
+    *out = decimal.negative ? -value : value;
+    return true;
+}
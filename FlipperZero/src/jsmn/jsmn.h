@@ -67,6 +67,80 @@ extern "C"
     char **get_json_array_values(const char *key, const char *json_data, int *num_values);
 
     int json_token_count(const char *json);
+
+    /* Single-tokenization document API: parse once, then look up many values without copying */
+
+    // Zero-copy view into the JSON text (not NUL-terminated)
+    typedef struct
+    {
+        const char *ptr;
+        int len;
+    } JsonView;
+
+    // Tokenized JSON document; the tokens live in a caller-provided buffer
+    typedef struct
+    {
+        const char *json;  // the JSON text (must outlive the document)
+        jsmntok_t *tokens; // token buffer provided by the caller
+        int count;         // number of tokens parsed
+    } JsonDoc;
+
+    // Tokenize the JSON once into tokens[capacity]; returns false on a parse error or if the buffer is too small
+    bool json_doc_parse(JsonDoc *doc, const char *json, size_t len, jsmntok_t *tokens, unsigned int capacity);
+
+    // Same as json_doc_parse, but sizes and allocates the token buffer on the heap; release it with json_doc_free
+    bool json_doc_parse_alloc(JsonDoc *doc, const char *json, size_t len);
+
+    // Free a token buffer allocated by json_doc_parse_alloc
+    void json_doc_free(JsonDoc *doc);
+
+    // Return the token index of the value for key in the object token obj (0 is the root), or -1 if not found
+    int json_doc_find(const JsonDoc *doc, int obj, const char *key);
+
+    // Resolve a path such as "sp.x" or "lobbies[2].id" from the token root in one pass; returns the token index or -1
+    int json_doc_path(const JsonDoc *doc, int root, const char *path);
+
+    // Return a view of the token at index tok (strings exclude their quotes)
+    JsonView json_doc_view(const JsonDoc *doc, int tok);
+
+    // Typed getters for the value at key (a key or path) under the token obj; return false if missing or of the wrong type
+    bool json_doc_get_view(const JsonDoc *doc, int obj, const char *key, JsonView *out);
+    bool json_doc_get_int(const JsonDoc *doc, int obj, const char *key, int32_t *out);
+    bool json_doc_get_float(const JsonDoc *doc, int obj, const char *key, float *out);
+    bool json_doc_get_fixed(const JsonDoc *doc, int obj, const char *key, uint8_t decimals, int32_t *out);
+    bool json_doc_get_bool(const JsonDoc *doc, int obj, const char *key, bool *out);
+
+    // Cursor over the elements of an array token; yields each element's token index in order
+    typedef struct
+    {
+        const JsonDoc *doc;
+        int next;      // token index of the next element
+        int remaining; // number of elements not yet yielded
+    } JsonArrayIter;
+
+    // Start iterating the array token arr; returns false if arr is not an array
+    bool json_array_iter_init(JsonArrayIter *iter, const JsonDoc *doc, int arr);
+
+    // Return the token index of the next element, or -1 when the array is exhausted
+    int json_array_iter_next(JsonArrayIter *iter);
+
+    // Compare a view against a C string
+    bool json_view_eq(JsonView view, const char *s);
+
+    // Copy a view into dest as a NUL-terminated string (truncating); returns the number of characters copied
+    size_t json_view_copy(JsonView view, char *dest, size_t dest_size);
+
+    /* Length-bounded number parsers: read straight from a view (no NUL-terminated copy) using
+       integer and single-precision math only. They return false unless the whole view is a number. */
+
+    // Parse an integer; a fractional part is accepted and truncated ("12.7" -> 12)
+    bool json_view_to_int(JsonView view, int32_t *out);
+
+    // Parse a decimal into fixed point, scaled by 10^decimals (decimals 0-6) and rounded ("1.25", 2 -> 125)
+    bool json_view_to_fixed(JsonView view, uint8_t decimals, int32_t *out);
+
+    // Parse a decimal with an optional exponent as a float
+    bool json_view_to_float(JsonView view, float *out);
 #endif /* JB_JSMN_EDIT */
 
 #ifdef __cplusplus
@@ -0,0 +1,331 @@
+#include <jsmn/jsmn_stream.h>
+#include <furi.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum
+{
+    STREAM_VALUE = 0,        // expecting a value
+    STREAM_VALUE_OR_END = 1, // after '[': expecting a value or ']'
+    STREAM_KEY_OR_END = 2,   // after '{': expecting a key or '}'
+    STREAM_KEY = 3,          // after ',' in an object: expecting a key
+    STREAM_KEY_STRING = 4,   // inside a key
+    STREAM_COLON = 5,        // after a key: expecting ':'
+    STREAM_STRING = 6,       // inside a string value
+    STREAM_PRIMITIVE = 7,    // inside a number/true/false/null
+    STREAM_AFTER_VALUE = 8,  // after a value: expecting ',' or a closing bracket
+    STREAM_DONE = 9,         // the root value is complete
+    STREAM_ERROR = 10,       // syntax error, all further input is rejected
+} StreamState;
+
+enum
+{
+    STREAM_KIND_OBJECT = 0,
+    STREAM_KIND_ARRAY = 1,
+};
+
+static void stream_emit(JsonStream *stream, JsonStreamEvent event, const char *value, size_t value_len)
+{
+    if (stream->callback)
+    {
+        stream->callback(stream->context, event, stream->path_valid ? stream->path : NULL, value, value_len);
+    }
+}
+
+// Point the path at the current member of the innermost container: base + ".key" or base + "[index]"
+static void stream_set_member_path(JsonStream *stream)
+{
+    uint8_t top = stream->depth - 1;
+    uint8_t base = stream->base_len[top];
+    size_t room = sizeof(stream->path) - base;
+    int written;
+    if (stream->kind[top] == STREAM_KIND_ARRAY)
+    {
+        written = snprintf(stream->path + base, room, "[%u]", stream->index[top]);
+    }
+    else
+    {
+        written = snprintf(stream->path + base, room, "%s%.*s", base ? "." : "", stream->buffer_len, stream->buffer);
+    }
+    stream->path_valid = stream->base_valid[top] && written >= 0 && (size_t)written < room;
+    stream->path_len = stream->path_valid ? (uint8_t)(base + written) : base;
+    stream->path[stream->path_len] = '\0';
+}
+
+static bool stream_push(JsonStream *stream, uint8_t kind)
+{
+    if (stream->depth >= JSON_STREAM_MAX_DEPTH)
+    {
+        FURI_LOG_E("JSMN_STREAM", "JSON nesting deeper than %d", JSON_STREAM_MAX_DEPTH);
+        return false;
+    }
+    stream_emit(stream, kind == STREAM_KIND_OBJECT ? JSON_STREAM_OBJECT_START : JSON_STREAM_ARRAY_START, NULL, 0);
+    stream->kind[stream->depth] = kind;
+    stream->base_len[stream->depth] = stream->path_len;
+    stream->base_valid[stream->depth] = stream->path_valid;
+    stream->index[stream->depth] = 0;
+    stream->depth++;
+    return true;
+}
+
+// Called once a value (scalar or container) is complete
+static void stream_value_done(JsonStream *stream)
+{
+    stream->state = stream->depth == 0 ? STREAM_DONE : STREAM_AFTER_VALUE;
+}
+
+static bool stream_pop(JsonStream *stream, uint8_t kind)
+{
+    if (stream->depth == 0 || stream->kind[stream->depth - 1] != kind)
+    {
+        return false;
+    }
+    stream->depth--;
+    // restore the container's own path for its END event
+    stream->path_len = stream->base_len[stream->depth];
+    stream->path_valid = stream->base_valid[stream->depth];
+    stream->path[stream->path_len] = '\0';
+    stream_emit(stream, kind == STREAM_KIND_OBJECT ? JSON_STREAM_OBJECT_END : JSON_STREAM_ARRAY_END, NULL, 0);
+    stream_value_done(stream);
+    return true;
+}
+
+static void stream_buffer_add(JsonStream *stream, char c)
+{
+    // keep the first JSON_STREAM_MAX_VALUE - 1 characters, drop the rest
+    if (stream->buffer_len < sizeof(stream->buffer) - 1)
+    {
+        stream->buffer[stream->buffer_len++] = c;
+    }
+}
+
+// Append one character of a string (key or value), resolving escape sequences
+static void stream_string_char(JsonStream *stream, char c)
+{
+    if (stream->unicode_left > 0)
+    {
+        stream->unicode_left--;
+        return;
+    }
+    if (!stream->escape)
+    {
+        if (c == '\\')
+            stream->escape = true;
+        else
+            stream_buffer_add(stream, c);
+        return;
+    }
+    stream->escape = false;
+    switch (c)
+    {
+    case 'n':
+        stream_buffer_add(stream, '\n');
+        break;
+    case 't':
+        stream_buffer_add(stream, '\t');
+        break;
+    case 'r':
+        stream_buffer_add(stream, '\r');
+        break;
+    case 'b':
+        stream_buffer_add(stream, '\b');
+        break;
+    case 'f':
+        stream_buffer_add(stream, '\f');
+        break;
+    case 'u':
+        // non-ASCII code points are not rendered on the Flipper; keep a placeholder
+        stream->unicode_left = 4;
+        stream_buffer_add(stream, '?');
+        break;
+    default:
+        stream_buffer_add(stream, c);
+        break;
+    }
+}
+
+static bool stream_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Start a value at c; returns false on a syntax error
+static bool stream_begin_value(JsonStream *stream, char c)
+{
+    if (c == '{')
+    {
+        if (!stream_push(stream, STREAM_KIND_OBJECT))
+            return false;
+        stream->state = STREAM_KEY_OR_END;
+    }
+    else if (c == '[')
+    {
+        if (!stream_push(stream, STREAM_KIND_ARRAY))
+            return false;
+        stream->state = STREAM_VALUE_OR_END;
+    }
+    else if (c == '"')
+    {
+        stream->buffer_len = 0;
+        stream->escape = false;
+        stream->unicode_left = 0;
+        stream->state = STREAM_STRING;
+    }
+    else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n')
+    {
+        stream->buffer_len = 0;
+        stream_buffer_add(stream, c);
+        stream->state = STREAM_PRIMITIVE;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void json_stream_init(JsonStream *stream, JsonStreamCallback callback, void *context)
+{
+    memset(stream, 0, sizeof(JsonStream));
+    stream->callback = callback;
+    stream->context = context;
+    stream->state = STREAM_VALUE;
+    stream->path_valid = true;
+}
+
+bool json_stream_feed(JsonStream *stream, const char *data, size_t len)
+{
+    if (stream == NULL || stream->state == STREAM_ERROR)
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    while (i < len)
+    {
+        char c = data[i];
+        bool ok = true;
+        bool consumed = true;
+
+        switch (stream->state)
+        {
+        case STREAM_VALUE:
+            if (!stream_is_space(c))
+                ok = stream_begin_value(stream, c);
+            break;
+        case STREAM_VALUE_OR_END:
+            if (c == ']')
+                ok = stream_pop(stream, STREAM_KIND_ARRAY);
+            else if (!stream_is_space(c))
+            {
+                stream_set_member_path(stream);
+                ok = stream_begin_value(stream, c);
+            }
+            break;
+        case STREAM_KEY_OR_END:
+        case STREAM_KEY:
+            if (c == '}' && stream->state == STREAM_KEY_OR_END)
+                ok = stream_pop(stream, STREAM_KIND_OBJECT);
+            else if (c == '"')
+            {
+                stream->buffer_len = 0;
+                stream->escape = false;
+                stream->unicode_left = 0;
+                stream->state = STREAM_KEY_STRING;
+            }
+            else if (!stream_is_space(c))
+                ok = false;
+            break;
+        case STREAM_KEY_STRING:
+            if (c == '"' && !stream->escape && stream->unicode_left == 0)
+            {
+                stream_set_member_path(stream);
+                stream->state = STREAM_COLON;
+            }
+            else
+                stream_string_char(stream, c);
+            break;
+        case STREAM_COLON:
+            if (c == ':')
+                stream->state = STREAM_VALUE;
+            else if (!stream_is_space(c))
+                ok = false;
+            break;
+        case STREAM_STRING:
+            if (c == '"' && !stream->escape && stream->unicode_left == 0)
+            {
+                stream->buffer[stream->buffer_len] = '\0';
+                stream_emit(stream, JSON_STREAM_STRING, stream->buffer, stream->buffer_len);
+                stream_value_done(stream);
+            }
+            else
+                stream_string_char(stream, c);
+            break;
+        case STREAM_PRIMITIVE:
+            if (stream_is_space(c) || c == ',' || c == '}' || c == ']')
+            {
+                stream->buffer[stream->buffer_len] = '\0';
+                stream_emit(stream, JSON_STREAM_PRIMITIVE, stream->buffer, stream->buffer_len);
+                stream_value_done(stream);
+                consumed = false; // the delimiter belongs to the enclosing container
+            }
+            else
+                stream_buffer_add(stream, c);
+            break;
+        case STREAM_AFTER_VALUE:
+            if (c == ',')
+            {
+                uint8_t top = stream->depth - 1;
+                if (stream->kind[top] == STREAM_KIND_ARRAY)
+                {
+                    stream->index[top]++;
+                    stream_set_member_path(stream);
+                    stream->state = STREAM_VALUE;
+                }
+                else
+                    stream->state = STREAM_KEY;
+            }
+            else if (c == '}')
+                ok = stream_pop(stream, STREAM_KIND_OBJECT);
+            else if (c == ']')
+                ok = stream_pop(stream, STREAM_KIND_ARRAY);
+            else if (!stream_is_space(c))
+                ok = false;
+            break;
+        case STREAM_DONE:
+            ok = stream_is_space(c) || c == '\0';
+            break;
+        default:
+            ok = false;
+            break;
+        }
+
+        if (!ok)
+        {
+            FURI_LOG_E("JSMN_STREAM", "Unexpected '%c' in JSON stream", c);
+            stream->state = STREAM_ERROR;
+            return false;
+        }
+        if (consumed)
+        {
+            i++;
+        }
+    }
+    return true;
+}
+
+bool json_stream_finish(JsonStream *stream)
+{
+    if (stream == NULL)
+    {
+        return false;
+    }
+    // a bare primitive at the root has no delimiter after it
+    if (stream->state == STREAM_PRIMITIVE && stream->depth == 0)
+    {
+        stream->buffer[stream->buffer_len] = '\0';
+        stream_emit(stream, JSON_STREAM_PRIMITIVE, stream->buffer, stream->buffer_len);
+        stream->state = STREAM_DONE;
+    }
+    return stream->state == STREAM_DONE;
+}
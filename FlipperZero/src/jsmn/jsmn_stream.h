@@ -0,0 +1,62 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* Incremental (SAX-style) JSON parser: feed it any number of chunks, it keeps a fixed
+       amount of state and reports every value together with its path ("game_stats.xp",
+       "lobbies[2].id"), so memory use does not depend on the size of the document. */
+
+#define JSON_STREAM_MAX_DEPTH 8  // maximum nesting depth
+#define JSON_STREAM_MAX_PATH 64  // longest path reported to the callback
+#define JSON_STREAM_MAX_VALUE 64 // longest key/value kept; longer strings are truncated
+
+    typedef enum
+    {
+        JSON_STREAM_OBJECT_START = 0, // an object begins at path
+        JSON_STREAM_OBJECT_END = 1,   // the object at path is complete
+        JSON_STREAM_ARRAY_START = 2,  // an array begins at path
+        JSON_STREAM_ARRAY_END = 3,    // the array at path is complete
+        JSON_STREAM_STRING = 4,       // a string value (unescaped, without quotes)
+        JSON_STREAM_PRIMITIVE = 5,    // a number, true, false or null
+    } JsonStreamEvent;
+
+    // path is NULL when it would not fit in JSON_STREAM_MAX_PATH; value is only set for STRING/PRIMITIVE
+    typedef void (*JsonStreamCallback)(void *context, JsonStreamEvent event, const char *path, const char *value, size_t value_len);
+
+    typedef struct
+    {
+        JsonStreamCallback callback;             // invoked for every event
+        void *context;                           // passed back to the callback
+        uint8_t state;                           // parser state (see jsmn_stream.c)
+        uint8_t depth;                           // number of open containers
+        uint8_t unicode_left;                    // hex digits left in a \uXXXX escape
+        bool escape;                             // previous character was a backslash
+        bool path_valid;                         // path fits in the buffer
+        char path[JSON_STREAM_MAX_PATH];         // path of the current value
+        uint8_t path_len;                        // length of path
+        uint8_t kind[JSON_STREAM_MAX_DEPTH];     // container type per depth (object or array)
+        uint8_t base_len[JSON_STREAM_MAX_DEPTH]; // path length of each open container
+        bool base_valid[JSON_STREAM_MAX_DEPTH];  // whether each open container has a valid path
+        uint16_t index[JSON_STREAM_MAX_DEPTH];   // current element index per array
+        char buffer[JSON_STREAM_MAX_VALUE];      // key or value being read
+        uint8_t buffer_len;                      // length of buffer
+    } JsonStream;
+
+    // Reset the parser and set the callback invoked for each event
+    void json_stream_init(JsonStream *stream, JsonStreamCallback callback, void *context);
+
+    // Feed the next chunk; chunks may split tokens anywhere. Returns false on a syntax error
+    bool json_stream_feed(JsonStream *stream, const char *data, size_t len);
+
+    // Call after the last chunk; returns true if exactly one complete document was parsed
+    bool json_stream_finish(JsonStream *stream);
+
+#ifdef __cplusplus
+}
+#endif
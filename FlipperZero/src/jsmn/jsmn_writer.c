@@ -0,0 +1,275 @@
+#include <jsmn/jsmn_writer.h>
+#include <string.h>
+
+static const uint32_t pow10_table[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+static void writer_append(JsonWriter *writer, const char *data, size_t len)
+{
+    if (writer->overflow)
+    {
+        return;
+    }
+    if (writer->length + len >= writer->capacity)
+    {
+        writer->overflow = true;
+        return;
+    }
+    memcpy(writer->buffer + writer->length, data, len);
+    writer->length += len;
+    writer->buffer[writer->length] = '\0';
+}
+
+static void writer_append_char(JsonWriter *writer, char c)
+{
+    writer_append(writer, &c, 1);
+}
+
+// Emit the separator owed before a value or key at the current depth
+static void writer_begin_item(JsonWriter *writer)
+{
+    if (writer->after_key)
+    {
+        writer->after_key = false;
+        return;
+    }
+    if (writer->depth > 0)
+    {
+        uint16_t bit = (uint16_t)(1u << (writer->depth - 1));
+        if (writer->has_items & bit)
+        {
+            writer_append_char(writer, ',');
+        }
+        writer->has_items |= bit;
+    }
+}
+
+// Unsigned integer to decimal, zero-padded to min_digits
+static void writer_append_uint(JsonWriter *writer, uint32_t value, uint8_t min_digits)
+{
+    char digits[10];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && count < sizeof(digits));
+    while (count < min_digits && count < sizeof(digits))
+    {
+        digits[count++] = '0';
+    }
+    char out[10];
+    for (uint8_t i = 0; i < count; i++)
+    {
+        out[i] = digits[count - 1 - i];
+    }
+    writer_append(writer, out, count);
+}
+
+static void writer_append_escaped(JsonWriter *writer, const char *value)
+{
+    for (const char *p = value; *p; p++)
+    {
+        char c = *p;
+        switch (c)
+        {
+        case '"':
+            writer_append(writer, "\\\"", 2);
+            break;
+        case '\\':
+            writer_append(writer, "\\\\", 2);
+            break;
+        case '\n':
+            writer_append(writer, "\\n", 2);
+            break;
+        case '\r':
+            writer_append(writer, "\\r", 2);
+            break;
+        case '\t':
+            writer_append(writer, "\\t", 2);
+            break;
+        default:
+            // other control characters are dropped rather than \u-encoded
+            if ((unsigned char)c >= 0x20)
+            {
+                writer_append_char(writer, c);
+            }
+            break;
+        }
+    }
+}
+
+static void writer_open(JsonWriter *writer, char bracket)
+{
+    writer_begin_item(writer);
+    if (writer->depth >= JSON_WRITER_MAX_DEPTH)
+    {
+        writer->overflow = true;
+        return;
+    }
+    writer->depth++;
+    writer->has_items &= (uint16_t)~(1u << (writer->depth - 1));
+    writer_append_char(writer, bracket);
+}
+
+static void writer_close(JsonWriter *writer, char bracket)
+{
+    if (writer->depth == 0 || writer->after_key)
+    {
+        writer->overflow = true;
+        return;
+    }
+    writer->depth--;
+    writer_append_char(writer, bracket);
+}
+
+void json_writer_init(JsonWriter *writer, char *buffer, size_t capacity)
+{
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+    writer->length = 0;
+    writer->has_items = 0;
+    writer->depth = 0;
+    writer->after_key = false;
+    writer->overflow = buffer == NULL || capacity == 0;
+    if (!writer->overflow)
+    {
+        buffer[0] = '\0';
+    }
+}
+
+void json_writer_object_start(JsonWriter *writer)
+{
+    writer_open(writer, '{');
+}
+
+void json_writer_object_end(JsonWriter *writer)
+{
+    writer_close(writer, '}');
+}
+
+void json_writer_array_start(JsonWriter *writer)
+{
+    writer_open(writer, '[');
+}
+
+void json_writer_array_end(JsonWriter *writer)
+{
+    writer_close(writer, ']');
+}
+
+void json_writer_key(JsonWriter *writer, const char *key)
+{
+    writer_begin_item(writer);
+    writer_append_char(writer, '"');
+    writer_append_escaped(writer, key);
+    writer_append(writer, "\":", 2);
+    writer->after_key = true;
+}
+
+void json_writer_string(JsonWriter *writer, const char *value)
+{
+    writer_begin_item(writer);
+    writer_append_char(writer, '"');
+    writer_append_escaped(writer, value ? value : "");
+    writer_append_char(writer, '"');
+}
+
+void json_writer_int(JsonWriter *writer, int32_t value)
+{
+    writer_begin_item(writer);
+    if (value < 0)
+    {
+        writer_append_char(writer, '-');
+        writer_append_uint(writer, (uint32_t)(-(int64_t)value), 1);
+    }
+    else
+    {
+        writer_append_uint(writer, (uint32_t)value, 1);
+    }
+}
+
+void json_writer_uint(JsonWriter *writer, uint32_t value)
+{
+    writer_begin_item(writer);
+    writer_append_uint(writer, value, 1);
+}
+
+void json_writer_bool(JsonWriter *writer, bool value)
+{
+    writer_begin_item(writer);
+    if (value)
+        writer_append(writer, "true", 4);
+    else
+        writer_append(writer, "false", 5);
+}
+
+void json_writer_fixed(JsonWriter *writer, float value, uint8_t decimals)
+{
+    writer_begin_item(writer);
+    if (decimals > 6)
+    {
+        decimals = 6;
+    }
+    if (value != value)
+    {
+        // NaN is not valid JSON
+        writer_append_char(writer, '0');
+        return;
+    }
+    bool negative = value < 0.0f;
+    float magnitude = negative ? -value : value;
+
+    // drop decimals until the scaled value fits in 32 bits
+    while (decimals > 0 && magnitude * (float)pow10_table[decimals] >= 4294967040.0f)
+    {
+        decimals--;
+    }
+    float scaled = magnitude * (float)pow10_table[decimals] + 0.5f;
+    uint32_t fixed = scaled >= 4294967040.0f ? UINT32_MAX : (uint32_t)scaled;
+    uint32_t whole = fixed / pow10_table[decimals];
+    uint32_t fraction = fixed % pow10_table[decimals];
+
+    if (negative && fixed != 0)
+    {
+        writer_append_char(writer, '-');
+    }
+    writer_append_uint(writer, whole, 1);
+    if (decimals > 0)
+    {
+        writer_append_char(writer, '.');
+        writer_append_uint(writer, fraction, decimals);
+    }
+}
+
+void json_writer_string_verbatim(JsonWriter *writer, const char *text, size_t len)
+{
+    writer_begin_item(writer);
+    writer_append_char(writer, '"');
+    writer_append(writer, text, len);
+    writer_append_char(writer, '"');
+}
+
+void json_writer_raw(JsonWriter *writer, const char *json, size_t len)
+{
+    writer_begin_item(writer);
+    writer_append(writer, json, len);
+}
+
+bool json_writer_ok(const JsonWriter *writer)
+{
+    return !writer->overflow;
+}
+
+const char *json_writer_finish(const JsonWriter *writer)
+{
+    if (writer->overflow || writer->depth != 0 || writer->after_key)
+    {
+        return NULL;
+    }
+    return writer->buffer;
+}
+
+size_t json_writer_length(const JsonWriter *writer)
+{
+    return writer->length;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* Fixed-capacity JSON writer: serializes into a caller-provided (stack) buffer, inserts
+       separators itself, and formats numbers with integer/single-precision math only, so no
+       heap allocation and no double-precision soft-float (snprintf "%f") is involved. */
+
+#define JSON_WRITER_MAX_DEPTH 16 // maximum nesting depth
+
+    typedef struct
+    {
+        char *buffer;       // destination buffer (always NUL-terminated)
+        size_t capacity;    // size of buffer in bytes
+        size_t length;      // characters written so far
+        uint16_t has_items; // bit per depth: container already holds an item
+        uint8_t depth;      // number of open containers
+        bool after_key;     // a key was written and its value is pending
+        bool overflow;      // output did not fit (or nesting was invalid)
+    } JsonWriter;
+
+    // Start writing into buffer[capacity]
+    void json_writer_init(JsonWriter *writer, char *buffer, size_t capacity);
+
+    void json_writer_object_start(JsonWriter *writer);
+    void json_writer_object_end(JsonWriter *writer);
+    void json_writer_array_start(JsonWriter *writer);
+    void json_writer_array_end(JsonWriter *writer);
+
+    // Write an object key; the next value written belongs to it
+    void json_writer_key(JsonWriter *writer, const char *key);
+
+    // Values
+    void json_writer_string(JsonWriter *writer, const char *value);
+    void json_writer_int(JsonWriter *writer, int32_t value);
+    void json_writer_uint(JsonWriter *writer, uint32_t value);
+    void json_writer_bool(JsonWriter *writer, bool value);
+
+    // Write value rounded to a fixed number of decimals (0-6) using single-precision math only
+    void json_writer_fixed(JsonWriter *writer, float value, uint8_t decimals);
+
+    // Write text as a quoted string without escaping (for payloads the protocol carries verbatim)
+    void json_writer_string_verbatim(JsonWriter *writer, const char *text, size_t len);
+
+    // Write an already-serialized JSON value as-is
+    void json_writer_raw(JsonWriter *writer, const char *json, size_t len);
+
+    // True while everything written so far fit (containers may still be open)
+    bool json_writer_ok(const JsonWriter *writer);
+
+    // Return the finished NUL-terminated JSON, or NULL if it did not fit
+    const char *json_writer_finish(const JsonWriter *writer);
+
+    // Number of characters written (valid when the writer did not overflow)
+    size_t json_writer_length(const JsonWriter *writer);
+
+#ifdef __cplusplus
+}
+#endif
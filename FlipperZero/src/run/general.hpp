@@ -1,6 +1,7 @@
 #pragma once
 #include "engine/vector.hpp"
 #include <stdint.h>
+#include <string.h>
 #include <memory>
 
 #define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
@@ -64,6 +65,7 @@ typedef enum
     ICON_ID_ROCK_LARGE,
     ICON_ID_ROCK_MEDIUM,
     ICON_ID_ROCK_SMALL,
+    ICON_ID_COUNT, // number of registered icons (not an icon)
 } IconID;
 
 typedef struct
@@ -80,6 +82,19 @@ typedef struct
     IconSpec *icons; // pointer to an array of icon specs
 } IconGroupContext;
 
-inline float atof_(const char *nptr) { return (float)strtod(nptr, NULL); }
+// FNV-1a hash used by the asset registry so name lookups can switch on a compile-time constant
+constexpr uint32_t assetHash(const char *name, uint32_t hash = 2166136261u)
+{
+    return *name ? assetHash(name + 1, (hash ^ (uint8_t)*name) * 16777619u) : hash;
+}
+
+// A hash match only picks a candidate; different names can share a hash, so confirm it by name
+inline bool assetNameMatches(const char *name, const char *registered)
+{
+    return strcmp(name, registered) == 0;
+}
+
+IconID iconIdFromName(const char *name); // Resolve an icon name (e.g. "rock_small") to its registry ID
+
 inline bool toggleToBool(ToggleState state) noexcept { return state == ToggleOn; }
 inline const char *toggleToString(ToggleState state) noexcept { return state == ToggleOn ? "On" : "Off"; }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "run/interpolation.hpp"
+
+void netMotionReset(NetMotion *motion, Vector position, uint32_t tick)
+{
+    motion->from = position;
+    motion->target = position;
+    motion->velocity = Vector(0, 0);
+    motion->targetTick = tick;
+    motion->blendMs = 0;
+    motion->horizonMs = 0;
+}
+
+void netMotionPush(NetMotion *motion, Vector rendered, Vector position, uint32_t tick)
+{
+    float errorX = position.x - rendered.x;
+    float errorY = position.y - rendered.y;
+    if (errorX > NET_MOTION_SNAP_DISTANCE || errorX < -NET_MOTION_SNAP_DISTANCE ||
+        errorY > NET_MOTION_SNAP_DISTANCE || errorY < -NET_MOTION_SNAP_DISTANCE)
+    {
+        netMotionReset(motion, position, tick);
+        return;
+    }
+
+    uint32_t interval = tick - motion->targetTick;
+    if (interval > NET_MOTION_MAX_INTERVAL_MS)
+    {
+        motion->velocity = Vector(0, 0);
+        motion->horizonMs = 0;
+    }
+    else
+    {
+        float dt = (float)(interval < NET_MOTION_MIN_INTERVAL_MS ? NET_MOTION_MIN_INTERVAL_MS : interval);
+        motion->velocity = Vector((position.x - motion->target.x) / dt, (position.y - motion->target.y) / dt);
+        // predict up to the next expected update, then hold until it arrives
+        motion->horizonMs = interval > NET_MOTION_MAX_EXTRAPOLATION_MS ? NET_MOTION_MAX_EXTRAPOLATION_MS : interval;
+    }
+
+    // spread the correction over half an update interval so it lands well before the next one
+    uint32_t blend = interval / 2;
+    motion->blendMs = blend > NET_MOTION_MAX_BLEND_MS ? NET_MOTION_MAX_BLEND_MS : blend;
+    motion->from = rendered;
+    motion->target = position;
+    motion->targetTick = tick;
+}
+
+Vector netMotionSample(const NetMotion *motion, uint32_t tick)
+{
+    uint32_t elapsed = tick - motion->targetTick;
+    float ahead = (float)(elapsed < motion->horizonMs ? elapsed : motion->horizonMs);
+    Vector predicted(motion->target.x + motion->velocity.x * ahead, motion->target.y + motion->velocity.y * ahead);
+    if (elapsed >= motion->blendMs)
+    {
+        return predicted;
+    }
+    float alpha = (float)elapsed / (float)motion->blendMs;
+    return Vector(motion->from.x + (predicted.x - motion->from.x) * alpha,
+                  motion->from.y + (predicted.y - motion->from.y) * alpha);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "engine/vector.hpp"
+#include <stdint.h>
+
+/*
+ * Smoothing for remote entities, which only receive a position every sync interval.
+ *
+ * Each network update is stamped with the local tick it arrived on. The velocity between the
+ * last two updates predicts where the entity is now, for at most one update interval (and never
+ * more than NET_MOTION_MAX_EXTRAPOLATION_MS), and the rendered position blends from wherever it
+ * was drawn when the update arrived onto that predicted path, so corrections glide instead of
+ * teleporting. Corrections larger than NET_MOTION_SNAP_DISTANCE (respawns, level changes, long
+ * stalls) snap.
+ */
+
+#define NET_MOTION_MAX_EXTRAPOLATION_MS 1000 // furthest an entity is predicted past its last update
+#define NET_MOTION_MIN_INTERVAL_MS 50        // shorter update gaps are treated as this long (bursts)
+#define NET_MOTION_MAX_INTERVAL_MS 2000      // longer update gaps give no velocity (the entity stalled)
+#define NET_MOTION_MAX_BLEND_MS 500          // longest time a correction is spread over
+#define NET_MOTION_SNAP_DISTANCE 48.0f       // corrections larger than this (pixels, per axis) snap
+
+// Smoothed motion of one remote entity
+struct NetMotion
+{
+    Vector from;         // position drawn when the latest update arrived
+    Vector target;       // latest received position
+    Vector velocity;     // pixels per millisecond between the last two updates
+    uint32_t targetTick; // local tick the latest update arrived on
+    uint32_t blendMs;    // time to converge from `from` onto the predicted path
+    uint32_t horizonMs;  // how far past targetTick the velocity is trusted
+};
+
+void netMotionReset(NetMotion *motion, Vector position, uint32_t tick);                 // Start at position with no velocity
+void netMotionPush(NetMotion *motion, Vector rendered, Vector position, uint32_t tick); // Record an update received at tick while drawn at rendered
+Vector netMotionSample(const NetMotion *motion, uint32_t tick);                         // Position to draw at tick
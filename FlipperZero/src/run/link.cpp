@@ -0,0 +1,143 @@
+#include "run/link.hpp"
+
+void netLinkInit(NetLinkStats *link, uint32_t tick)
+{
+    *link = NetLinkStats{};
+    link->syncIntervalMs = NET_LINK_SYNC_DEFAULT_MS;
+    link->pacingMs = NET_LINK_PACING_DEFAULT_MS;
+    link->windowStart = tick;
+    link->lastPingTick = tick;
+}
+
+void netLinkOnQueued(NetLinkStats *link)
+{
+    if (link->windowQueued < UINT16_MAX)
+        link->windowQueued++;
+}
+
+void netLinkOnDropped(NetLinkStats *link)
+{
+    link->drops++;
+    if (link->windowDrops < UINT16_MAX)
+        link->windowDrops++;
+}
+
+void netLinkOnStale(NetLinkStats *link)
+{
+    // not a congestion signal: reordering happens upstream of our queue
+    link->staleDrops++;
+}
+
+void netLinkOnSent(NetLinkStats *link, size_t bytes, uint32_t sendMs)
+{
+    link->windowBytes += (uint32_t)bytes;
+    link->windowBusyMs += sendMs;
+    if (link->windowSent < UINT16_MAX)
+        link->windowSent++;
+}
+
+bool netLinkPingDue(const NetLinkStats *link, uint32_t tick)
+{
+    return link->pingTick == 0 && tick - link->lastPingTick >= NET_LINK_PING_INTERVAL_MS;
+}
+
+void netLinkOnPing(NetLinkStats *link, uint32_t tick)
+{
+    // 0 means "none outstanding", so never use it as a stamp
+    link->pingTick = (tick & NET_LINK_STAMP_MASK) ? tick : tick + 1;
+    link->lastPingTick = tick;
+}
+
+bool netLinkOnPong(NetLinkStats *link, uint32_t stamp, uint32_t tick)
+{
+    if (link->pingTick == 0 || (link->pingTick & NET_LINK_STAMP_MASK) != (stamp & NET_LINK_STAMP_MASK))
+    {
+        return false;
+    }
+    uint32_t rtt = tick - link->pingTick;
+    link->pingTick = 0;
+    link->pongSeen = true;
+    if (link->rttMinMs == 0 || rtt < link->rttMinMs)
+        link->rttMinMs = rtt;
+    // smoothed like TCP's SRTT: 7/8 old + 1/8 new
+    link->rttMs = link->rttMs == 0 ? rtt : (link->rttMs * 7 + rtt) / 8;
+    return true;
+}
+
+bool netLinkUpdate(NetLinkStats *link, size_t queueDepth, size_t queueCapacity, size_t peers, uint32_t tick)
+{
+    if (peers == 0 && link->peers != 0)
+    {
+        // everyone left: what was measured against them no longer applies
+        uint32_t drops = link->drops;
+        uint32_t staleDrops = link->staleDrops;
+        netLinkInit(link, tick);
+        link->drops = drops;
+        link->staleDrops = staleDrops;
+    }
+    link->peers = peers;
+
+    if (link->pingTick != 0 && tick - link->pingTick > NET_LINK_PING_TIMEOUT_MS)
+    {
+        link->pingTick = 0;
+        // nobody may be listening until a peer has answered once
+        if (link->pongSeen)
+            link->windowPingLost = true;
+    }
+
+    uint32_t elapsed = tick - link->windowStart;
+    if (elapsed < NET_LINK_WINDOW_MS)
+    {
+        return false;
+    }
+
+    // rates for the window that just closed
+    link->sentBytesPerSec = (uint32_t)((uint64_t)link->windowBytes * 1000 / elapsed);
+    link->drainPerSec = (uint16_t)((uint32_t)link->windowSent * 1000 / elapsed);
+    link->enqueuePerSec = (uint16_t)((uint32_t)link->windowQueued * 1000 / elapsed);
+    if (link->windowBusyMs > 0)
+    {
+        uint32_t uart = (uint32_t)((uint64_t)link->windowBytes * 1000 / link->windowBusyMs);
+        link->uartBytesPerSec = link->uartBytesPerSec == 0 ? uart : (link->uartBytesPerSec * 3 + uart) / 4;
+    }
+
+    // congestion signals
+    bool backlog = queueDepth > queueCapacity / 2 ||
+                   (queueDepth > queueCapacity / 4 && link->windowQueued > link->windowSent);
+    bool slowRtt = link->rttMinMs != 0 && link->rttMs > link->rttMinMs * 2 + NET_LINK_RTT_CONGESTED_SLACK_MS;
+    link->congested = link->windowDrops > 0 || backlog || slowRtt || link->windowPingLost;
+
+    // pacing below the UART's own write time only lets the queue fill up
+    uint32_t pacingFloor = NET_LINK_PACING_MIN_MS;
+    if (link->uartBytesPerSec > 0 && link->windowSent > 0)
+    {
+        uint32_t frameMs = (link->windowBytes / link->windowSent) * 1000 / link->uartBytesPerSec;
+        if (frameMs > pacingFloor)
+            pacingFloor = frameMs > NET_LINK_PACING_MAX_MS ? NET_LINK_PACING_MAX_MS : frameMs;
+    }
+
+    if (link->congested)
+    {
+        // multiplicative decrease of the send rate
+        link->syncIntervalMs = link->syncIntervalMs * 2 > NET_LINK_SYNC_MAX_MS ? NET_LINK_SYNC_MAX_MS : link->syncIntervalMs * 2;
+        link->pacingMs = link->pacingMs * 3 / 2 > NET_LINK_PACING_MAX_MS ? NET_LINK_PACING_MAX_MS : link->pacingMs * 3 / 2;
+    }
+    else
+    {
+        // additive increase of the send rate
+        link->syncIntervalMs = link->syncIntervalMs > NET_LINK_SYNC_MIN_MS + NET_LINK_SYNC_STEP_MS ? link->syncIntervalMs - NET_LINK_SYNC_STEP_MS : NET_LINK_SYNC_MIN_MS;
+        link->pacingMs = link->pacingMs > NET_LINK_PACING_MIN_MS + NET_LINK_PACING_STEP_MS ? link->pacingMs - NET_LINK_PACING_STEP_MS : NET_LINK_PACING_MIN_MS;
+    }
+    if (link->pacingMs < pacingFloor)
+        link->pacingMs = pacingFloor;
+
+    // open the next window
+    link->windowStart = tick;
+    link->windowBytes = 0;
+    link->windowBusyMs = 0;
+    link->windowSent = 0;
+    link->windowQueued = 0;
+    link->windowDrops = 0;
+    link->windowPingLost = false;
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Link measurements and the AIMD controller that paces multiplayer traffic.
+ *
+ * Every NET_LINK_WINDOW_MS the window's counters become rates (UART throughput, queue drain and
+ * fill rate) and the controller runs once. Drops, a backed-up queue, a round-trip time well above
+ * the best one seen or a lost ping count as congestion and double the sync interval (and grow the
+ * pacing by half). Otherwise both shrink by a fixed step. Pacing never drops below the time the
+ * UART needs to write an average frame.
+ *
+ * A ping only counts as lost once some ping has been answered: alone in a level nobody echoes it.
+ * When the last peer leaves, the controller starts over from the defaults.
+ */
+
+#define NET_LINK_WINDOW_MS 1000             // measurement and control period
+#define NET_LINK_SYNC_DEFAULT_MS 1000       // starting sync interval
+#define NET_LINK_SYNC_MIN_MS 250            // fastest sync interval
+#define NET_LINK_SYNC_MAX_MS 4000           // slowest sync interval
+#define NET_LINK_SYNC_STEP_MS 50            // additive decrease per uncongested window
+#define NET_LINK_PACING_DEFAULT_MS 300      // starting gap between queued sends
+#define NET_LINK_PACING_MIN_MS 30           // shortest gap between queued sends
+#define NET_LINK_PACING_MAX_MS 1000         // longest gap between queued sends
+#define NET_LINK_PACING_STEP_MS 10          // additive decrease per uncongested window
+#define NET_LINK_PING_INTERVAL_MS 2000      // time between round-trip probes
+#define NET_LINK_PING_TIMEOUT_MS 3000       // an unanswered probe counts as congestion after this
+#define NET_LINK_RTT_CONGESTED_SLACK_MS 100 // RTT above 2 * min + slack is congestion
+#define NET_LINK_STAMP_MASK 0x7FFFFFFFu     // probe stamps travel as JSON integers, so only 31 bits of the tick are carried
+
+struct NetLinkStats
+{
+    // measurements (last closed window unless noted)
+    uint32_t uartBytesPerSec; // bytes per second while the UART is writing (smoothed)
+    uint32_t sentBytesPerSec; // bytes sent per second of wall time
+    uint16_t drainPerSec;     // queued messages sent per second
+    uint16_t enqueuePerSec;   // messages queued per second
+    uint32_t rttMs;           // smoothed round-trip time (0 until the first pong)
+    uint32_t rttMinMs;        // lowest round-trip time seen (the uncongested baseline)
+    uint32_t drops;           // messages dropped from the outgoing queue since start
+    uint32_t staleDrops;      // incoming updates dropped as late or duplicate since start
+    bool congested;           // the last window was congested
+    // controller outputs
+    uint32_t syncIntervalMs; // time between sync rounds
+    uint32_t pacingMs;       // minimum gap between queued sends
+    // probe state
+    uint32_t pingTick;     // tick of the outstanding ping (0: none outstanding)
+    uint32_t lastPingTick; // tick the last ping was sent
+    bool pongSeen;         // a peer has answered a ping since the controller was reset
+    size_t peers;          // peers seen at the last update
+    // window accumulators
+    uint32_t windowStart;  // tick the current window opened
+    uint32_t windowBytes;  // bytes sent
+    uint32_t windowBusyMs; // time spent inside the UART send
+    uint16_t windowSent;   // messages sent
+    uint16_t windowQueued; // messages queued
+    uint16_t windowDrops;  // messages dropped
+    bool windowPingLost;   // a ping timed out
+};
+
+void netLinkInit(NetLinkStats *link, uint32_t tick);                                             // Reset measurements; start at the default interval and pacing
+void netLinkOnQueued(NetLinkStats *link);                                                        // A message entered the outgoing queue
+void netLinkOnDropped(NetLinkStats *link);                                                       // A message was dropped from (or refused by) the queue
+void netLinkOnStale(NetLinkStats *link);                                                         // An incoming update was older than the one already applied
+void netLinkOnSent(NetLinkStats *link, size_t bytes, uint32_t sendMs);                           // A message of bytes took sendMs to write to the UART
+bool netLinkPingDue(const NetLinkStats *link, uint32_t tick);                                    // True when a new round-trip probe should go out
+void netLinkOnPing(NetLinkStats *link, uint32_t tick);                                           // A probe stamped with tick was sent
+bool netLinkOnPong(NetLinkStats *link, uint32_t stamp, uint32_t tick);                           // Echo of the probe stamped stamp arrived; false if it is not the outstanding one
+bool netLinkUpdate(NetLinkStats *link, size_t queueDepth, size_t queueCapacity, size_t peers, uint32_t tick); // Close the window and run the controller when due; true if it ran
@@ -0,0 +1,253 @@
+#include "run/lockstep.hpp"
+#include "engine/entity.hpp"
+#include <string.h>
+
+#define NET_LOCKSTEP_MASK (NET_LOCKSTEP_WINDOW - 1)
+
+static uint8_t allSlots(const NetLockstep *ls)
+{
+    return (uint8_t)((1u << ls->playerCount) - 1);
+}
+
+// Full tick of the 16-bit tick closest to the current one
+static uint32_t expandTick(const NetLockstep *ls, uint16_t tick)
+{
+    return ls->tick + (int16_t)(uint16_t)(tick - (uint16_t)ls->tick);
+}
+
+static uint32_t hashInt(uint32_t hash, int32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        hash ^= (uint8_t)(value >> (i * 8));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool netLockstepStart(NetLockstep *ls, const uint16_t *players, uint8_t count, uint16_t localId, uint8_t session, uint8_t idleInput)
+{
+    memset(ls, 0, sizeof(NetLockstep));
+    if (!players || count == 0 || count > NET_ROSTER_MAX)
+    {
+        return false;
+    }
+
+    // simulate players in id order so every device walks them the same way
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t j = i;
+        while (j > 0 && ls->players[j - 1] > players[i])
+        {
+            ls->players[j] = ls->players[j - 1];
+            j--;
+        }
+        ls->players[j] = players[i];
+    }
+    ls->playerCount = count;
+    int slot = netLockstepSlot(ls, localId);
+    if (slot < 0)
+    {
+        ls->playerCount = 0;
+        return false;
+    }
+    ls->localSlot = (uint8_t)slot;
+    ls->session = session;
+    ls->idleInput = idleInput;
+    ls->pendingInput = idleInput;
+
+    // nobody can have pressed anything for the first ticks
+    for (uint32_t t = 0; t < NET_LOCKSTEP_INPUT_DELAY; t++)
+    {
+        for (uint8_t s = 0; s < count; s++)
+        {
+            ls->inputs[t][s] = idleInput;
+        }
+        ls->received[t] = allSlots(ls);
+    }
+    ls->scheduled = NET_LOCKSTEP_INPUT_DELAY;
+    ls->active = true;
+    return true;
+}
+
+void netLockstepStop(NetLockstep *ls)
+{
+    ls->active = false;
+    ls->playerCount = 0;
+    ls->waitingSince = 0;
+}
+
+int netLockstepSlot(const NetLockstep *ls, uint16_t playerId)
+{
+    for (uint8_t i = 0; i < ls->playerCount; i++)
+    {
+        if (ls->players[i] == playerId)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void netLockstepLocalInput(NetLockstep *ls, uint8_t input)
+{
+    if (!ls->active)
+    {
+        return;
+    }
+    if (input != ls->idleInput)
+    {
+        ls->pendingInput = input & 0x0F;
+    }
+    // one tick is scheduled per frame; while the simulation waits the press stays pending
+    while (ls->scheduled < ls->tick + NET_LOCKSTEP_INPUT_DELAY)
+    {
+        uint32_t index = ls->scheduled & NET_LOCKSTEP_MASK;
+        ls->inputs[index][ls->localSlot] = ls->pendingInput;
+        ls->received[index] |= (uint8_t)(1u << ls->localSlot);
+        ls->pendingInput = ls->idleInput;
+        ls->scheduled++;
+    }
+}
+
+uint8_t netLockstepOutgoing(NetLockstep *ls, uint16_t *firstTick, uint8_t *out, uint8_t capacity)
+{
+    if (!ls->active || !firstTick || !out || capacity == 0)
+    {
+        return 0;
+    }
+    ls->quietFrames++;
+    if (ls->scheduled - ls->sent < NET_LOCKSTEP_SEND_TICKS && ls->quietFrames < NET_LOCKSTEP_RESEND_FRAMES)
+    {
+        return 0;
+    }
+
+    // the local slot of the ring is only rewritten when a tick is scheduled, so older ticks are still there
+    uint32_t count = ls->scheduled < NET_LOCKSTEP_RESEND_TICKS ? ls->scheduled : NET_LOCKSTEP_RESEND_TICKS;
+    if (count > capacity)
+    {
+        count = capacity;
+    }
+    uint32_t first = ls->scheduled - count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        out[i] = ls->inputs[(first + i) & NET_LOCKSTEP_MASK][ls->localSlot];
+    }
+    *firstTick = (uint16_t)first;
+    ls->sent = ls->scheduled;
+    ls->quietFrames = 0;
+    return (uint8_t)count;
+}
+
+bool netLockstepOnInputs(NetLockstep *ls, uint16_t playerId, uint8_t session, uint16_t firstTick, const uint8_t *inputs, uint8_t count)
+{
+    if (!ls->active || session != ls->session || !inputs)
+    {
+        return false;
+    }
+    int slot = netLockstepSlot(ls, playerId);
+    if (slot < 0 || slot == ls->localSlot)
+    {
+        return false;
+    }
+
+    uint32_t first = expandTick(ls, firstTick);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        // ticks already simulated are repeats; ticks past the window would overwrite live ones
+        int32_t ahead = (int32_t)(first + i - ls->tick);
+        if (ahead < 0 || ahead >= NET_LOCKSTEP_WINDOW)
+        {
+            continue;
+        }
+        uint32_t index = (first + i) & NET_LOCKSTEP_MASK;
+        ls->inputs[index][slot] = inputs[i] & 0x0F;
+        ls->received[index] |= (uint8_t)(1u << slot);
+    }
+    return true;
+}
+
+bool netLockstepReady(const NetLockstep *ls)
+{
+    return ls->active && ls->scheduled > ls->tick && ls->received[ls->tick & NET_LOCKSTEP_MASK] == allSlots(ls);
+}
+
+bool netLockstepBehind(const NetLockstep *ls)
+{
+    // peers at the same tick have scheduled up to tick + delay - 1; input past that means they are ahead
+    uint8_t remote = (uint8_t)(allSlots(ls) & ~(1u << ls->localSlot));
+    return ls->active && (ls->received[(ls->tick + NET_LOCKSTEP_INPUT_DELAY) & NET_LOCKSTEP_MASK] & remote) != 0;
+}
+
+const uint8_t *netLockstepTickInputs(const NetLockstep *ls)
+{
+    return ls->inputs[ls->tick & NET_LOCKSTEP_MASK];
+}
+
+void netLockstepAdvance(NetLockstep *ls)
+{
+    // the slot now stands for tick + window; inputs stay so the local ones can be resent
+    ls->received[ls->tick & NET_LOCKSTEP_MASK] = 0;
+    ls->tick++;
+    ls->waitingSince = 0;
+}
+
+bool netLockstepStalled(NetLockstep *ls, uint32_t now)
+{
+    if (!ls->active || netLockstepReady(ls))
+    {
+        ls->waitingSince = 0;
+        return false;
+    }
+    if (ls->waitingSince == 0)
+    {
+        ls->waitingSince = now ? now : 1;
+        return false;
+    }
+    return now - ls->waitingSince >= NET_LOCKSTEP_STALL_MS;
+}
+
+uint8_t netLockstepMissing(const NetLockstep *ls)
+{
+    return (uint8_t)(allSlots(ls) & ~ls->received[ls->tick & NET_LOCKSTEP_MASK]);
+}
+
+bool netLockstepChecksumDue(const NetLockstep *ls)
+{
+    return ls->active && ls->tick != 0 && ls->tick % NET_LOCKSTEP_CHECKSUM_TICKS == 0;
+}
+
+uint32_t netLockstepHash(uint32_t hash, const Entity *entity)
+{
+    // quarter-pixel positions and quarter-point health: equal states hash equally, float noise below that does not count
+    hash = hashInt(hash, (int32_t)(entity->position.x * 4.0f));
+    hash = hashInt(hash, (int32_t)(entity->position.y * 4.0f));
+    hash = hashInt(hash, (int32_t)(entity->health * 4.0f));
+    hash = hashInt(hash, (int32_t)entity->xp);
+    hash = hashInt(hash, (int32_t)entity->state);
+    return hash;
+}
+
+void netLockstepOnOwnChecksum(NetLockstep *ls, uint32_t tick, uint32_t value)
+{
+    uint32_t index = (tick / NET_LOCKSTEP_CHECKSUM_TICKS) % NET_LOCKSTEP_CHECKSUM_HISTORY;
+    ls->checksumTick[index] = tick;
+    ls->checksumValue[index] = value;
+}
+
+bool netLockstepOnPeerChecksum(NetLockstep *ls, uint8_t session, uint16_t tick, uint32_t value)
+{
+    if (!ls->active || session != ls->session)
+    {
+        return true;
+    }
+    // a peer ahead of us is checked when our own report reaches it
+    uint32_t full = expandTick(ls, tick);
+    uint32_t index = (full / NET_LOCKSTEP_CHECKSUM_TICKS) % NET_LOCKSTEP_CHECKSUM_HISTORY;
+    if (full == 0 || ls->checksumTick[index] != full || ls->checksumValue[index] == value)
+    {
+        return true;
+    }
+    ls->desyncs++;
+    return false;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "run/protocol.hpp"
+
+/*
+ * Deterministic lockstep: peers exchange only the input of each simulation tick.
+ *
+ * Every device runs the same fixed-step simulation of the same level from the same starting
+ * state, so only the players' inputs need to travel. A local press is scheduled
+ * NET_LOCKSTEP_INPUT_DELAY ticks ahead, which gives it time to reach the other peers before
+ * the tick runs. Tick n runs only once every player's input for n is known; a device that is
+ * still missing one waits, and a peer that stays silent for NET_LOCKSTEP_STALL_MS ends the
+ * session. Inputs go out in batches covering the last NET_LOCKSTEP_RESEND_TICKS ticks, so a
+ * lost frame is repaired by the next one. Every NET_LOCKSTEP_CHECKSUM_TICKS ticks each device
+ * hashes its state (quantized to fixed point) and broadcasts it; a differing hash is a desync.
+ */
+
+#define NET_LOCKSTEP_WINDOW 32            // ticks of input kept (power of two)
+#define NET_LOCKSTEP_INPUT_DELAY 8        // ticks between a press and the tick it runs on
+#define NET_LOCKSTEP_SEND_TICKS 4         // newly scheduled ticks that trigger an input batch
+#define NET_LOCKSTEP_RESEND_TICKS 16      // ticks each batch covers (older ones are repeated; 2 * input delay)
+#define NET_LOCKSTEP_RESEND_FRAMES 30     // frames without a new batch before the last one is repeated
+#define NET_LOCKSTEP_CHECKSUM_TICKS 64    // ticks between state checksums
+#define NET_LOCKSTEP_CHECKSUM_HISTORY 4   // own checksums kept to compare late peer reports
+#define NET_LOCKSTEP_MAX_CATCHUP 2        // ticks run per frame when behind
+#define NET_LOCKSTEP_STALL_MS 3000        // waiting this long for a peer's input ends the session
+
+class Entity;
+
+struct NetLockstep
+{
+    bool active;                                                       // a session is running
+    uint8_t session;                                                   // session number from the roster
+    uint8_t playerCount;                                               // players in the session
+    uint8_t localSlot;                                                 // index of this device's player
+    uint16_t players[NET_ROSTER_MAX];                                  // player ids, ascending (the simulation order)
+    uint32_t tick;                                                     // next tick to simulate
+    uint32_t scheduled;                                                // local input is known for ticks below this
+    uint32_t sent;                                                     // scheduled value when the last batch went out
+    uint8_t quietFrames;                                               // frames since the last batch
+    uint8_t idleInput;                                                 // input meaning "nothing pressed"
+    uint8_t pendingInput;                                              // local press waiting for a free tick
+    uint8_t inputs[NET_LOCKSTEP_WINDOW][NET_ROSTER_MAX];               // input per tick and slot
+    uint8_t received[NET_LOCKSTEP_WINDOW];                             // bit per slot whose input for the tick is known
+    uint32_t checksumTick[NET_LOCKSTEP_CHECKSUM_HISTORY];              // ticks of the own checksums
+    uint32_t checksumValue[NET_LOCKSTEP_CHECKSUM_HISTORY];             // own checksums
+    uint32_t waitingSince;                                             // tick the simulation started waiting (0: not waiting)
+    uint32_t desyncs;                                                  // checksum mismatches seen
+};
+
+bool netLockstepStart(NetLockstep *ls, const uint16_t *players, uint8_t count, uint16_t localId, uint8_t session, uint8_t idleInput); // Begin a session; false if localId is not a player
+void netLockstepStop(NetLockstep *ls);                                                                                               // End the session
+int netLockstepSlot(const NetLockstep *ls, uint16_t playerId);                                                                       // Slot of a player (-1 if not in the session)
+void netLockstepLocalInput(NetLockstep *ls, uint8_t input);                                                                          // Schedule this frame's local input
+uint8_t netLockstepOutgoing(NetLockstep *ls, uint16_t *firstTick, uint8_t *out, uint8_t capacity);                                   // Local inputs to send now (0: nothing due)
+bool netLockstepOnInputs(NetLockstep *ls, uint16_t playerId, uint8_t session, uint16_t firstTick, const uint8_t *inputs, uint8_t count); // Store a peer's batch; false if it does not belong to the session
+bool netLockstepReady(const NetLockstep *ls);                                                                                        // True when every input of the next tick is known
+bool netLockstepBehind(const NetLockstep *ls);                                                                                       // True when a peer already scheduled past this device's horizon
+const uint8_t *netLockstepTickInputs(const NetLockstep *ls);                                                                         // Inputs of the next tick, by slot
+void netLockstepAdvance(NetLockstep *ls);                                                                                            // The next tick was simulated
+bool netLockstepStalled(NetLockstep *ls, uint32_t now);                                                                              // True once the simulation waited NET_LOCKSTEP_STALL_MS
+uint8_t netLockstepMissing(const NetLockstep *ls);                                                                                   // Bit per slot whose input for the next tick is missing
+bool netLockstepChecksumDue(const NetLockstep *ls);                                                                                  // True right after a tick that is checksummed
+uint32_t netLockstepHash(uint32_t hash, const Entity *entity);                                                                       // Fold an entity's quantized state into hash (start with 2166136261)
+void netLockstepOnOwnChecksum(NetLockstep *ls, uint32_t tick, uint32_t value);                                                       // Remember this device's checksum of tick
+bool netLockstepOnPeerChecksum(NetLockstep *ls, uint8_t session, uint16_t tick, uint32_t value);                                     // Compare a peer's checksum; false on desync
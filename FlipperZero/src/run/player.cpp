@@ -4,8 +4,150 @@
 #include "run/general.hpp"
 #include "app.hpp"
 #include "jsmn/jsmn.h"
+#include "jsmn/jsmn_stream.h"
+#include "jsmn/jsmn_writer.h"
 #include <math.h>
 
+// Fields collected while streaming user_info.txt; applied only once all of them are present
+typedef enum
+{
+    USER_INFO_USERNAME = 1 << 0,
+    USER_INFO_LEVEL = 1 << 1,
+    USER_INFO_XP = 1 << 2,
+    USER_INFO_HEALTH = 1 << 3,
+    USER_INFO_STRENGTH = 1 << 4,
+    USER_INFO_MAX_HEALTH = 1 << 5,
+    USER_INFO_ALL_FIELDS = (1 << 6) - 1,
+} UserInfoField;
+
+struct UserInfoFields
+{
+    char username[64];
+    int32_t level;
+    int32_t xp;
+    int32_t health;
+    int32_t strength;
+    int32_t max_health;
+    uint8_t found; // UserInfoField bits
+};
+
+static void userInfoStreamCallback(void *context, JsonStreamEvent event, const char *path, const char *value, size_t value_len)
+{
+    UserInfoFields *fields = static_cast<UserInfoFields *>(context);
+    if (!path || strncmp(path, "game_stats.", 11) != 0)
+    {
+        return;
+    }
+    const char *key = path + 11;
+    if (event == JSON_STREAM_STRING && strcmp(key, "username") == 0)
+    {
+        snprintf(fields->username, sizeof(fields->username), "%.*s", (int)value_len, value);
+        fields->found |= USER_INFO_USERNAME;
+        return;
+    }
+    int32_t number;
+    if (event != JSON_STREAM_PRIMITIVE || !json_view_to_int(JsonView{value, (int)value_len}, &number))
+    {
+        return;
+    }
+    if (strcmp(key, "level") == 0)
+    {
+        fields->level = number;
+        fields->found |= USER_INFO_LEVEL;
+    }
+    else if (strcmp(key, "xp") == 0)
+    {
+        fields->xp = number;
+        fields->found |= USER_INFO_XP;
+    }
+    else if (strcmp(key, "health") == 0)
+    {
+        fields->health = number;
+        fields->found |= USER_INFO_HEALTH;
+    }
+    else if (strcmp(key, "strength") == 0)
+    {
+        fields->strength = number;
+        fields->found |= USER_INFO_STRENGTH;
+    }
+    else if (strcmp(key, "max_health") == 0)
+    {
+        fields->max_health = number;
+        fields->found |= USER_INFO_MAX_HEALTH;
+    }
+}
+
+// Lobbies are written straight into the Player's fixed array while streaming lobbies.txt
+struct LobbyStreamContext
+{
+    LobbyInfo *lobbies; // destination array (4 entries)
+    int count;          // number of complete lobbies stored so far
+};
+
+static void lobbyStreamCallback(void *context, JsonStreamEvent event, const char *path, const char *value, size_t value_len)
+{
+    LobbyStreamContext *parsed = static_cast<LobbyStreamContext *>(context);
+    if (!path || strncmp(path, "lobbies[", 8) != 0 || parsed->count >= 4)
+    {
+        return;
+    }
+    // skip the index; elements arrive in order, so the next free slot is the current lobby
+    const char *field = strchr(path, ']');
+    if (!field)
+    {
+        return;
+    }
+    field++;
+    LobbyInfo *lobby = &parsed->lobbies[parsed->count];
+
+    if (*field == '\0')
+    {
+        if (event == JSON_STREAM_OBJECT_START)
+        {
+            *lobby = LobbyInfo();
+            lobby->maxPlayers = 10;
+        }
+        else if (event == JSON_STREAM_OBJECT_END)
+        {
+            if (strlen(lobby->id) > 0)
+            {
+                // use the ID if the name is not available
+                if (strlen(lobby->name) == 0)
+                {
+                    snprintf(lobby->name, sizeof(lobby->name), "Lobby %s", lobby->id);
+                }
+                parsed->count++;
+            }
+            else
+            {
+                FURI_LOG_E(TAG, "Failed to get lobby ID for lobby %d", parsed->count);
+            }
+        }
+        return;
+    }
+
+    if (event == JSON_STREAM_STRING && strcmp(field, ".id") == 0)
+    {
+        snprintf(lobby->id, sizeof(lobby->id), "%.*s", (int)value_len, value);
+    }
+    else if (event == JSON_STREAM_STRING && strcmp(field, ".name") == 0)
+    {
+        snprintf(lobby->name, sizeof(lobby->name), "%.*s", (int)value_len, value);
+    }
+    else if (event == JSON_STREAM_PRIMITIVE && strcmp(field, ".player_count") == 0)
+    {
+        int32_t number;
+        if (json_view_to_int(JsonView{value, (int)value_len}, &number))
+            lobby->playerCount = number;
+    }
+    else if (event == JSON_STREAM_PRIMITIVE && strcmp(field, ".max_players") == 0)
+    {
+        int32_t number;
+        if (json_view_to_int(JsonView{value, (int)value_len}, &number))
+            lobby->maxPlayers = number;
+    }
+}
+
 Player::Player() : Entity("Player", ENTITY_PLAYER, Vector(384, 192), Vector(15, 11), player_left_sword_15x11px, player_left_sword_15x11px, player_right_sword_15x11px)
 {
     is_player = true;                                        // Mark this entity as a player (so level doesn't delete it)
@@ -25,7 +167,32 @@ Player::Player() : Entity("Player", ENTITY_PLAYER, Vector(384, 192), Vector(15,
 
 Player::~Player()
 {
-    // nothing to clean up for now
+    // queued requests carry this player as their callback context
+    FlipWorldApp *app = flipWorldRun ? static_cast<FlipWorldApp *>(flipWorldRun->appContext) : nullptr;
+    if (app)
+    {
+        app->httpCancel(this);
+    }
+}
+
+void Player::animateLoading(Draw *canvas, const char *text)
+{
+    if (!loadingStarted)
+    {
+        if (!loading)
+        {
+            loading = std::make_unique<Loading>(canvas);
+        }
+        loadingStarted = true;
+        if (loading)
+        {
+            loading->setText(text);
+        }
+    }
+    if (loading)
+    {
+        loading->animate();
+    }
 }
 
 bool Player::areAllEnemiesDead(Game *game)
@@ -164,6 +331,13 @@ void Player::drawCurrentView(Draw *canvas)
     if (!canvas)
         return;
 
+    // finished requests update the statuses (and views) before anything is drawn
+    FlipWorldApp *app = flipWorldRun ? static_cast<FlipWorldApp *>(flipWorldRun->appContext) : nullptr;
+    if (app)
+    {
+        app->httpPoll();
+    }
+
     // Update debounce timer
     if (systemMenuDebounceTimer > 0.0f)
     {
@@ -196,6 +370,16 @@ void Player::drawCurrentView(Draw *canvas)
                     return;                          // Don't process game input this frame
                 }
 
+                if (flipWorldRun->isLockstepActive())
+                {
+                    // Lockstep: the run steps every player with the exchanged inputs; the engine only draws
+                    updateDebounce();
+                    flipWorldRun->updateLockstep(currentInput);
+                    flipWorldRun->resetInput();
+                    flipWorldRun->getEngine()->getGame()->render();
+                    return;
+                }
+
                 flipWorldRun->getEngine()->updateGameInput(currentInput);
                 // Reset the input after processing to prevent it from being continuously pressed
                 flipWorldRun->resetInput();
@@ -291,59 +475,10 @@ void Player::drawCurrentView(Draw *canvas)
 
 void Player::drawJoinLobbyView(Draw *canvas)
 {
-    static bool loadingStarted = false;
     switch (joinLobbyStatus)
     {
     case JoinLobbyWaiting:
-        if (!loadingStarted)
-        {
-            if (!loading)
-            {
-                loading = std::make_unique<Loading>(canvas);
-            }
-            loadingStarted = true;
-            if (loading)
-            {
-                loading->setText("Joining...");
-            }
-        }
-        if (!this->httpRequestIsFinished())
-        {
-            if (loading)
-            {
-                loading->animate();
-            }
-        }
-        else
-        {
-            if (loading)
-            {
-                loading->stop();
-            }
-            loadingStarted = false;
-            FlipWorldApp *app = static_cast<FlipWorldApp *>(flipWorldRun->appContext);
-            if (app->getHttpState() == ISSUE)
-            {
-                joinLobbyStatus = JoinLobbyRequestError;
-                return;
-            }
-            char *response = (char *)malloc(512);
-            if (app && app->loadChar("join_lobby", response, 512))
-            {
-                // no need to check response this time, just join the game if a response is received
-                // no issues in testing, but if needed, it does return [SUCCESS] in the message if successful
-                joinLobbyStatus = JoinLobbySuccess;
-                currentMainView = GameViewGame;         // switch to game view
-                userRequest(RequestTypeStartWebsocket); // Start websocket connection for real-time updates
-                flipWorldRun->setPvEMode(true);         // we're in pve mode now!
-                flipWorldRun->startGame();
-            }
-            else
-            {
-                joinLobbyStatus = JoinLobbyRequestError;
-            }
-            ::free(response);
-        }
+        animateLoading(canvas, "Joining...");
         break;
     case JoinLobbySuccess:
         canvas->fillScreen(ColorWhite);
@@ -381,119 +516,14 @@ void Player::drawJoinLobbyView(Draw *canvas)
 
 void Player::drawLobbiesView(Draw *canvas)
 {
-    static bool loadingStarted = false;
     switch (lobbiesStatus)
     {
+    case LobbiesNotStarted:
+        // not fetched with the sign-in burst: fetch now
+        userRequest(RequestTypeLobbies);
+        break;
     case LobbiesWaiting:
-        if (!loadingStarted)
-        {
-            if (!loading)
-            {
-                loading = std::make_unique<Loading>(canvas);
-            }
-            loadingStarted = true;
-            if (loading)
-            {
-                loading->setText("Fetching...");
-            }
-            userRequest(RequestTypeLobbies);
-            return;
-        }
-        if (!this->httpRequestIsFinished())
-        {
-            if (loading)
-            {
-                loading->animate();
-            }
-        }
-        else
-        {
-            if (loading)
-            {
-                loading->stop();
-            }
-            loadingStarted = false;
-            FlipWorldApp *app = static_cast<FlipWorldApp *>(flipWorldRun->appContext);
-            if (app->getHttpState() == ISSUE)
-            {
-                lobbiesStatus = LobbiesRequestError;
-                return;
-            }
-            char *response = (char *)malloc(512);
-            if (app && app->loadChar("lobbies", response, 512))
-            {
-                lobbiesStatus = LobbiesSuccess;
-                lobbyCount = 0;
-                currentLobbyIndex = 0; // Reset selection to first lobby
-
-                // parse the lobbies and store them
-                for (uint32_t i = 0; i < 4; i++)
-                {
-                    char *lobby = get_json_array_value("lobbies", i, response);
-                    if (!lobby)
-                    {
-                        FURI_LOG_I(TAG, "No more lobbies found (total: %d)", lobbyCount);
-                        break;
-                    }
-
-                    char *lobby_id = get_json_value("id", lobby);
-                    char *lobby_name = get_json_value("name", lobby);
-                    char *player_count = get_json_value("player_count", lobby);
-                    char *max_players = get_json_value("max_players", lobby);
-
-                    if (lobby_id && strlen(lobby_id) > 0)
-                    {
-                        // Store lobby ID
-                        strncpy(lobbies[lobbyCount].id, lobby_id, sizeof(lobbies[lobbyCount].id) - 1);
-                        lobbies[lobbyCount].id[sizeof(lobbies[lobbyCount].id) - 1] = '\0';
-
-                        // Store lobby name (use ID if name is not available)
-                        if (lobby_name && strlen(lobby_name) > 0)
-                        {
-                            strncpy(lobbies[lobbyCount].name, lobby_name, sizeof(lobbies[lobbyCount].name) - 1);
-                            lobbies[lobbyCount].name[sizeof(lobbies[lobbyCount].name) - 1] = '\0';
-                        }
-                        else
-                        {
-                            snprintf(lobbies[lobbyCount].name, sizeof(lobbies[lobbyCount].name), "Lobby %s", lobby_id);
-                        }
-
-                        // Store player counts
-                        lobbies[lobbyCount].playerCount = player_count ? atoi(player_count) : 0;
-                        lobbies[lobbyCount].maxPlayers = max_players ? atoi(max_players) : 10;
-
-                        lobbyCount++;
-                    }
-                    else
-                    {
-                        FURI_LOG_E(TAG, "Failed to get lobby ID for lobby %lu", (unsigned long)i);
-                    }
-
-                    // Free the parsed strings
-                    free(lobby);
-                    if (lobby_id)
-                        free(lobby_id);
-                    if (lobby_name)
-                        free(lobby_name);
-                    if (player_count)
-                        free(player_count);
-                    if (max_players)
-                        free(max_players);
-                }
-
-                if (lobbyCount == 0)
-                {
-                    FURI_LOG_E(TAG, "No valid lobbies found in response");
-                }
-
-                ::free(response);
-            }
-            else
-            {
-                lobbiesStatus = LobbiesRequestError;
-                ::free(response);
-            }
-        }
+        animateLoading(canvas, "Fetching...");
         break;
     case LobbiesSuccess:
         canvas->fillScreen(ColorWhite);
@@ -592,77 +622,10 @@ void Player::drawLoginView(Draw *canvas)
 {
     canvas->fillScreen(ColorWhite);
     canvas->setFont(FontPrimary);
-    static bool loadingStarted = false;
     switch (loginStatus)
     {
     case LoginWaiting:
-        if (!loadingStarted)
-        {
-            if (!loading)
-            {
-                loading = std::make_unique<Loading>(canvas);
-            }
-            loadingStarted = true;
-            if (loading)
-            {
-                loading->setText("Logging in...");
-            }
-        }
-        if (!this->httpRequestIsFinished())
-        {
-            if (loading)
-            {
-                loading->animate();
-            }
-        }
-        else
-        {
-            if (loading)
-            {
-                loading->stop();
-            }
-            loadingStarted = false;
-            FlipWorldApp *app = static_cast<FlipWorldApp *>(flipWorldRun->appContext);
-            if (app->getHttpState() == ISSUE)
-            {
-                loginStatus = LoginRequestError;
-                return;
-            }
-            char response[256];
-            if (app && app->loadChar("login", response, sizeof(response)))
-            {
-                if (strstr(response, "[SUCCESS]") != NULL)
-                {
-                    loginStatus = LoginSuccess;
-                    currentMainView = GameViewUserInfo; // switch to user info view
-                    userInfoStatus = UserInfoWaiting;   // set user info status to waiting
-                    userRequest(RequestTypeUserInfo);
-                }
-                else if (strstr(response, "User not found") != NULL)
-                {
-                    loginStatus = LoginNotStarted;
-                    currentMainView = GameViewRegistration;
-                    registrationStatus = RegistrationWaiting;
-                    userRequest(RequestTypeRegistration);
-                }
-                else if (strstr(response, "Incorrect password") != NULL)
-                {
-                    loginStatus = LoginWrongPassword;
-                }
-                else if (strstr(response, "Username or password is empty.") != NULL)
-                {
-                    loginStatus = LoginCredentialsMissing;
-                }
-                else
-                {
-                    loginStatus = LoginRequestError;
-                }
-            }
-            else
-            {
-                loginStatus = LoginRequestError;
-            }
-        }
+        animateLoading(canvas, "Logging in...");
         break;
     case LoginSuccess:
         canvas->text(Vector(0, 10), "Login successful!", ColorBlack);
@@ -718,70 +681,10 @@ void Player::drawRegistrationView(Draw *canvas)
 {
     canvas->fillScreen(ColorWhite);
     canvas->setFont(FontPrimary);
-    static bool loadingStarted = false;
     switch (registrationStatus)
     {
     case RegistrationWaiting:
-        if (!loadingStarted)
-        {
-            if (!loading)
-            {
-                loading = std::make_unique<Loading>(canvas);
-            }
-            loadingStarted = true;
-            if (loading)
-            {
-                loading->setText("Registering...");
-            }
-        }
-        if (!this->httpRequestIsFinished())
-        {
-            if (loading)
-            {
-                loading->animate();
-            }
-        }
-        else
-        {
-            if (loading)
-            {
-                loading->stop();
-            }
-            loadingStarted = false;
-            FlipWorldApp *app = static_cast<FlipWorldApp *>(flipWorldRun->appContext);
-            if (app->getHttpState() == ISSUE)
-            {
-                registrationStatus = RegistrationRequestError;
-                return;
-            }
-            char response[256];
-            if (app && app->loadChar("register", response, sizeof(response)))
-            {
-                if (strstr(response, "[SUCCESS]") != NULL)
-                {
-                    registrationStatus = RegistrationSuccess;
-                    currentMainView = GameViewUserInfo; // switch to user info view
-                    userInfoStatus = UserInfoWaiting;   // set user info status to waiting
-                    userRequest(RequestTypeUserInfo);
-                }
-                else if (strstr(response, "Username or password not provided") != NULL)
-                {
-                    registrationStatus = RegistrationCredentialsMissing;
-                }
-                else if (strstr(response, "User already exists") != NULL)
-                {
-                    registrationStatus = RegistrationUserExists;
-                }
-                else
-                {
-                    registrationStatus = RegistrationRequestError;
-                }
-            }
-            else
-            {
-                registrationStatus = RegistrationRequestError;
-            }
-        }
+        animateLoading(canvas, "Registering...");
         break;
     case RegistrationSuccess:
         canvas->text(Vector(0, 10), "Registration successful!", ColorBlack);
@@ -928,143 +831,10 @@ void Player::drawUsername(Vector pos, Game *game)
 
 void Player::drawUserInfoView(Draw *canvas)
 {
-    static bool loadingStarted = false;
     switch (userInfoStatus)
     {
     case UserInfoWaiting:
-        if (!loadingStarted)
-        {
-            if (!loading)
-            {
-                loading = std::make_unique<Loading>(canvas);
-            }
-            loadingStarted = true;
-            if (loading)
-            {
-                loading->setText("Syncing...");
-            }
-        }
-        if (!this->httpRequestIsFinished())
-        {
-            if (loading)
-            {
-                loading->animate();
-            }
-        }
-        else
-        {
-            canvas->text(Vector(0, 10), "Loading user info...", ColorBlack);
-            canvas->text(Vector(0, 20), "Please wait...", ColorBlack);
-            canvas->text(Vector(0, 30), "It may take up to 15 seconds.", ColorBlack);
-            FlipWorldApp *app = static_cast<FlipWorldApp *>(flipWorldRun->appContext);
-            if (app->getHttpState() == ISSUE)
-            {
-                userInfoStatus = UserInfoRequestError;
-                if (loading)
-                {
-                    loading->stop();
-                }
-                loadingStarted = false;
-                return;
-            }
-            char response[512];
-            if (app && app->loadChar("user_info", response, sizeof(response)))
-            {
-                userInfoStatus = UserInfoSuccess;
-                // they're in! let's go
-                char *game_stats = get_json_value("game_stats", response);
-                if (!game_stats)
-                {
-                    FURI_LOG_E("Player", "Failed to parse game_stats");
-                    userInfoStatus = UserInfoParseError;
-                    if (loading)
-                    {
-                        loading->stop();
-                    }
-                    loadingStarted = false;
-                    return;
-                }
-                canvas->fillScreen(ColorWhite);
-                canvas->text(Vector(0, 10), "User info loaded!", ColorBlack);
-                char *username = get_json_value("username", game_stats);
-                char *level = get_json_value("level", game_stats);
-                char *xp = get_json_value("xp", game_stats);
-                char *health = get_json_value("health", game_stats);
-                char *strength = get_json_value("strength", game_stats);
-                char *max_health = get_json_value("max_health", game_stats);
-                if (!username || !level || !xp || !health || !strength || !max_health)
-                {
-                    FURI_LOG_E("Player", "Failed to parse user info");
-                    userInfoStatus = UserInfoParseError;
-                    if (username)
-                        ::free(username);
-                    if (level)
-                        ::free(level);
-                    if (xp)
-                        ::free(xp);
-                    if (health)
-                        ::free(health);
-                    if (strength)
-                        ::free(strength);
-                    if (max_health)
-                        ::free(max_health);
-                    ::free(game_stats);
-                    if (loading)
-                    {
-                        loading->stop();
-                    }
-                    loadingStarted = false;
-                    return;
-                }
-
-                canvas->fillScreen(ColorWhite);
-                canvas->text(Vector(0, 10), "User data found!", ColorBlack);
-
-                // Update player info
-                snprintf(player_name, sizeof(player_name), "%s", username);
-                name = player_name;
-                this->level = atoi(level);
-                this->xp = atoi(xp);
-                this->health = atoi(health);
-                this->strength = atoi(strength);
-                this->max_health = atoi(max_health);
-
-                canvas->fillScreen(ColorWhite);
-                canvas->text(Vector(0, 10), "Player info updated!", ColorBlack);
-
-                // clean em up gang
-                ::free(username);
-                ::free(level);
-                ::free(xp);
-                ::free(health);
-                ::free(strength);
-                ::free(max_health);
-                ::free(game_stats);
-
-                if (loading)
-                {
-                    loading->stop();
-                }
-                loadingStarted = false;
-
-                // if story, start immediately, otherwise load the lobbies
-                if (currentTitleIndex == TitleIndexStory)
-                {
-                    currentMainView = GameViewGame; // switch to game view
-                    flipWorldRun->startGame();
-                }
-                else
-                {
-                    currentMainView = GameViewLobbies; // switch to lobbies view
-                    lobbiesStatus = LobbiesWaiting;    // set lobbies status to waiting
-                }
-                return;
-            }
-            else
-            {
-                userInfoStatus = UserInfoRequestError;
-            }
-        }
+        animateLoading(canvas, "Syncing...");
         break;
     case UserInfoSuccess:
         canvas->fillScreen(ColorWhite);
@@ -1190,6 +960,200 @@ void Player::iconGroupRender(Game *game)
     }
 }
 
+void Player::onJoinLobbyResponse(const FlipperHTTPResponse *response, void *context)
+{
+    Player *player = static_cast<Player *>(context);
+    if (player->joinLobbyStatus != JoinLobbyWaiting)
+    {
+        return;
+    }
+    player->stopLoading();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(player->flipWorldRun->appContext);
+    char *body = (char *)malloc(512);
+    // no need to check the body, just join the game if a response is received
+    // no issues in testing, but if needed, it does return [SUCCESS] in the message if successful
+    if (body && app && app->loadResponse(response, body, 512))
+    {
+        player->joinLobbyStatus = JoinLobbySuccess;
+        if (player->currentMainView == GameViewJoinLobby)
+        {
+            player->userRequest(RequestTypeStartWebsocket); // Start websocket connection for real-time updates
+            player->flipWorldRun->setPvEMode(true);         // we're in pve mode now!
+            player->currentMainView = GameViewGame;         // the game view starts the game
+        }
+    }
+    else
+    {
+        player->joinLobbyStatus = JoinLobbyRequestError;
+    }
+    ::free(body);
+}
+
+void Player::onLobbiesResponse(const FlipperHTTPResponse *response, void *context)
+{
+    Player *player = static_cast<Player *>(context);
+    if (player->lobbiesStatus != LobbiesWaiting)
+    {
+        return;
+    }
+    player->stopLoading();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(player->flipWorldRun->appContext);
+    // stream the response so any number of lobbies fits in constant memory
+    LobbyStreamContext parsed = {player->lobbies, 0};
+    JsonStream stream;
+    json_stream_init(&stream, lobbyStreamCallback, &parsed);
+    if (app && app->loadResponseJson(response, &stream))
+    {
+        player->lobbiesStatus = LobbiesSuccess;
+        player->lobbyCount = parsed.count;
+        player->currentLobbyIndex = 0; // Reset selection to first lobby
+        FURI_LOG_I(TAG, "Lobbies found: %d", player->lobbyCount);
+
+        if (player->lobbyCount == 0)
+        {
+            FURI_LOG_E(TAG, "No valid lobbies found in response");
+        }
+    }
+    else
+    {
+        player->lobbiesStatus = LobbiesRequestError;
+    }
+}
+
+void Player::onLoginResponse(const FlipperHTTPResponse *response, void *context)
+{
+    Player *player = static_cast<Player *>(context);
+    if (player->loginStatus != LoginWaiting)
+    {
+        return;
+    }
+    player->stopLoading();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(player->flipWorldRun->appContext);
+    char body[256];
+    if (!app || !app->loadResponse(response, body, sizeof(body)))
+    {
+        player->loginStatus = LoginRequestError;
+    }
+    else if (strstr(body, "[SUCCESS]") != NULL)
+    {
+        player->loginStatus = LoginSuccess;
+        if (player->currentMainView == GameViewLogin)
+        {
+            player->currentMainView = GameViewUserInfo; // the user info is already on its way
+        }
+        return;
+    }
+    else if (strstr(body, "User not found") != NULL)
+    {
+        player->loginStatus = LoginNotStarted;
+    }
+    else if (strstr(body, "Incorrect password") != NULL)
+    {
+        player->loginStatus = LoginWrongPassword;
+    }
+    else if (strstr(body, "Username or password is empty.") != NULL)
+    {
+        player->loginStatus = LoginCredentialsMissing;
+    }
+    else
+    {
+        player->loginStatus = LoginRequestError;
+    }
+
+    // the requests queued behind the login answer for a session that does not exist
+    player->userInfoStatus = UserInfoNotStarted;
+    player->lobbiesStatus = LobbiesNotStarted;
+    if (player->loginStatus == LoginNotStarted)
+    {
+        player->currentMainView = GameViewRegistration;
+        player->registrationStatus = RegistrationWaiting;
+        player->userRequest(RequestTypeRegistration);
+    }
+}
+
+void Player::onRegistrationResponse(const FlipperHTTPResponse *response, void *context)
+{
+    Player *player = static_cast<Player *>(context);
+    if (player->registrationStatus != RegistrationWaiting)
+    {
+        return;
+    }
+    player->stopLoading();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(player->flipWorldRun->appContext);
+    char body[256];
+    if (!app || !app->loadResponse(response, body, sizeof(body)))
+    {
+        player->registrationStatus = RegistrationRequestError;
+    }
+    else if (strstr(body, "[SUCCESS]") != NULL)
+    {
+        player->registrationStatus = RegistrationSuccess;
+        player->currentMainView = GameViewUserInfo; // switch to user info view
+        player->queueProfileRequests();
+    }
+    else if (strstr(body, "Username or password not provided") != NULL)
+    {
+        player->registrationStatus = RegistrationCredentialsMissing;
+    }
+    else if (strstr(body, "User already exists") != NULL)
+    {
+        player->registrationStatus = RegistrationUserExists;
+    }
+    else
+    {
+        player->registrationStatus = RegistrationRequestError;
+    }
+}
+
+void Player::onUserInfoResponse(const FlipperHTTPResponse *response, void *context)
+{
+    Player *player = static_cast<Player *>(context);
+    if (player->userInfoStatus != UserInfoWaiting)
+    {
+        return;
+    }
+    player->stopLoading();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(player->flipWorldRun->appContext);
+    UserInfoFields fields = {};
+    JsonStream stream;
+    json_stream_init(&stream, userInfoStreamCallback, &fields);
+    if (!app || !app->loadResponseJson(response, &stream))
+    {
+        player->userInfoStatus = UserInfoRequestError;
+        return;
+    }
+    if (fields.found != USER_INFO_ALL_FIELDS)
+    {
+        FURI_LOG_E("Player", "Failed to parse user info");
+        player->userInfoStatus = UserInfoParseError;
+        return;
+    }
+    player->userInfoStatus = UserInfoSuccess;
+
+    // Update player info
+    snprintf(player->player_name, sizeof(player->player_name), "%s", fields.username);
+    player->name = player->player_name;
+    player->level = fields.level;
+    player->xp = fields.xp;
+    player->health = fields.health;
+    player->strength = fields.strength;
+    player->max_health = fields.max_health;
+
+    if (player->currentMainView != GameViewUserInfo)
+    {
+        return;
+    }
+    // if story, start immediately, otherwise show the lobbies (fetched in the same burst)
+    if (player->currentTitleIndex == TitleIndexStory)
+    {
+        player->currentMainView = GameViewGame; // the game view starts the game
+    }
+    else
+    {
+        player->currentMainView = GameViewLobbies;
+    }
+}
+
 void Player::processInput()
 {
     if (!flipWorldRun)
@@ -1338,6 +1302,16 @@ void Player::processInput()
     }
 }
 
+void Player::queueProfileRequests()
+{
+    // queued right behind the login/registration, so the whole sign-in goes out in one burst
+    userRequest(RequestTypeUserInfo);
+    if (currentTitleIndex == TitleIndexPvE)
+    {
+        userRequest(RequestTypeLobbies);
+    }
+}
+
 void Player::render(Draw *canvas, Game *game)
 {
     if (currentMainView != GameViewGame)
@@ -1367,94 +1341,91 @@ bool Player::setHttpState(HTTPState state)
     return app->setHttpState(state);
 }
 
-void Player::update(Game *game)
+void Player::spawn(Entity *entity, float xp)
 {
-    // Update debounce timer
-    if (systemMenuDebounceTimer > 0.0f)
-    {
-        systemMenuDebounceTimer -= 1.0f / 120.f;
-        if (systemMenuDebounceTimer < 0.0f)
-        {
-            systemMenuDebounceTimer = 0.0f;
-        }
-    }
-
-    if (currentMainView != GameViewGame)
-    {
-        // If not in game view, skip player updates
-        return;
-    }
+    entity->xp = xp;
+    updateStats(entity);
+    entity->health = entity->max_health;
+    entity->attack_timer = 1;
+    entity->health_regen = 1;
+    entity->elapsed_attack_timer = 0;
+    entity->elapsed_health_regen = 0;
+    entity->direction = ENTITY_RIGHT;
+    entity->sprite = entity->sprite_right;
+    entity->state = ENTITY_IDLE;
+    entity->start_position = Vector(384, 192);
+    entity->end_position = Vector(384, 192);
+    // set twice so the old position (used when a hit pushes the player back) is the spawn point too
+    entity->position_set(entity->start_position);
+    entity->position_set(entity->start_position);
+}
 
+void Player::step(Entity *entity, uint8_t input, Game *game, const IconGroupContext *icons)
+{
     // Apply health regeneration
-    elapsed_health_regen += 0.05f;
-    if (elapsed_health_regen >= 1 && health < max_health)
+    entity->elapsed_health_regen += 0.05f;
+    if (entity->elapsed_health_regen >= 1 && entity->health < entity->max_health)
     {
-        health += health_regen;
-        elapsed_health_regen = 0;
-        if (health > max_health)
+        entity->health += entity->health_regen;
+        entity->elapsed_health_regen = 0;
+        if (entity->health > entity->max_health)
         {
-            health = max_health;
+            entity->health = entity->max_health;
         }
     }
 
     // Increment the elapsed_attack_timer for the player
-    elapsed_attack_timer += 0.05f;
+    entity->elapsed_attack_timer += 0.05f;
 
     // update player traits
-    updateStats();
-
-    // Check if all enemies are dead and switch to next level if needed
-    checkForLevelCompletion(game);
+    updateStats(entity);
 
-    Vector oldPos = position;
+    Vector oldPos = entity->position;
     Vector newPos = oldPos;
     bool shouldSetPosition = false;
 
     // Handle input based on current view
-    if (game->input == InputKeyUp)
+    if (input == InputKeyUp)
     {
         newPos.y -= 5;
-        direction = ENTITY_UP;
+        entity->direction = ENTITY_UP;
         shouldSetPosition = true;
     }
-    else if (game->input == InputKeyDown)
+    else if (input == InputKeyDown)
     {
         newPos.y += 5;
-        direction = ENTITY_DOWN;
+        entity->direction = ENTITY_DOWN;
         shouldSetPosition = true;
     }
-    else if (game->input == InputKeyLeft)
+    else if (input == InputKeyLeft)
     {
         newPos.x -= 5;
-        direction = ENTITY_LEFT;
+        entity->direction = ENTITY_LEFT;
         shouldSetPosition = true;
     }
-    else if (game->input == InputKeyRight)
+    else if (input == InputKeyRight)
     {
         newPos.x += 5;
-        direction = ENTITY_RIGHT;
+        entity->direction = ENTITY_RIGHT;
         shouldSetPosition = true;
     }
 
-    // reset input
-    game->input = InputKeyMAX;
-
     // check if new position is within the level boundaries
-    if (newPos.x < 0 || newPos.x + size.x > game->size.x ||
-        newPos.y < 0 || newPos.y + size.y > game->size.y)
+    if (newPos.x < 0 || newPos.x + entity->size.x > game->size.x ||
+        newPos.y < 0 || newPos.y + entity->size.y > game->size.y)
     {
         // restore old position
         shouldSetPosition = false;
     }
 
     // update player sprite based on direction
-    if (direction == ENTITY_LEFT)
+    if (entity->direction == ENTITY_LEFT)
     {
-        sprite = sprite_left;
+        entity->sprite = entity->sprite_left;
     }
-    else if (direction == ENTITY_RIGHT)
+    else if (entity->direction == ENTITY_RIGHT)
     {
-        sprite = sprite_right;
+        entity->sprite = entity->sprite_right;
     }
 
     // Only check for collisions if we're actually trying to move
@@ -1463,9 +1434,9 @@ void Player::update(Game *game)
         bool hasCollision = false;
 
         // Loop over all icon specifications in the current icon group.
-        for (int i = 0; i < getIconGroupContext()->count; i++)
+        for (int i = 0; icons && i < icons->count; i++)
         {
-            IconSpec *spec = &getIconGroupContext()->icons[i];
+            const IconSpec *spec = &icons->icons[i];
 
             // Calculate the difference between the NEW position and the icon's center.
             float dx = newPos.x - spec->pos.x;
@@ -1485,11 +1456,44 @@ void Player::update(Game *game)
         // Only update position if there's no collision
         if (!hasCollision)
         {
-            position_set(newPos);
+            entity->position_set(newPos);
         }
         // If there's a collision, we simply don't move (stay at current position)
     }
+}
+
+void Player::stopLoading()
+{
+    if (loading && loadingStarted)
+    {
+        loading->stop();
+    }
+    loadingStarted = false;
+}
+
+void Player::update(Game *game)
+{
+    updateDebounce();
+
+    if (currentMainView != GameViewGame)
+    {
+        // If not in game view, skip player updates
+        return;
+    }
+
+    // Check if all enemies are dead and switch to next level if needed
+    checkForLevelCompletion(game);
 
+    step(this, game->input, game, getIconGroupContext());
+
+    // reset input
+    game->input = InputKeyMAX;
+
+    updateCamera(game);
+}
+
+void Player::updateCamera(Game *game)
+{
     // Store the current camera position before updating
     game->old_pos = game->pos;
 
@@ -1510,21 +1514,34 @@ void Player::update(Game *game)
     game->pos = Vector(camera_x, camera_y);
 }
 
-void Player::updateStats()
+void Player::updateDebounce()
+{
+    // Update debounce timer
+    if (systemMenuDebounceTimer > 0.0f)
+    {
+        systemMenuDebounceTimer -= 1.0f / 120.f;
+        if (systemMenuDebounceTimer < 0.0f)
+        {
+            systemMenuDebounceTimer = 0.0f;
+        }
+    }
+}
+
+void Player::updateStats(Entity *entity)
 {
     // Determine the player's level based on XP
-    level = 1;
+    entity->level = 1;
     uint32_t xp_required = 100; // Base XP for level 2
 
-    while (level < 100 && xp >= xp_required) // Maximum level supported
+    while (entity->level < 100 && entity->xp >= xp_required) // Maximum level supported
     {
-        level++;
+        entity->level++;
         xp_required = (uint32_t)(xp_required * 1.5); // 1.5 growth factor per level
     }
 
     // Update strength and max health based on the new level
-    strength = 10 + (level * 1);           // 1 strength per level
-    max_health = 100 + ((level - 1) * 10); // 10 health per level
+    entity->strength = 10 + (entity->level * 1);           // 1 strength per level
+    entity->max_health = 100 + ((entity->level - 1) * 10); // 10 health per level
 }
 
 void Player::userRequest(RequestType requestType)
@@ -1599,30 +1616,52 @@ void Player::userRequest(RequestType requestType)
     }
 
     // Create JSON payload for login/registration
-    char *payload = (char *)malloc(256);
-    if (!payload)
+    char payload[256];
+    JsonWriter payloadWriter;
+    json_writer_init(&payloadWriter, payload, sizeof(payload));
+    json_writer_object_start(&payloadWriter);
+    json_writer_key(&payloadWriter, "username");
+    json_writer_string(&payloadWriter, username);
+    json_writer_key(&payloadWriter, "password");
+    json_writer_string(&payloadWriter, password);
+    json_writer_object_end(&payloadWriter);
+    if (!json_writer_finish(&payloadWriter) &&
+        (requestType == RequestTypeLogin || requestType == RequestTypeRegistration))
     {
-        FURI_LOG_E("Player", "userRequest: Failed to allocate memory for payload");
+        // only login and registration post the credentials; never send them an empty body
+        FURI_LOG_E("Player", "userRequest: Credentials do not fit in payload");
+        if (requestType == RequestTypeLogin)
+        {
+            loginStatus = LoginRequestError;
+        }
+        else
+        {
+            registrationStatus = RegistrationRequestError;
+        }
         free(username);
         free(password);
         return;
     }
-    snprintf(payload, 256, "{\"username\":\"%s\",\"password\":\"%s\"}", username, password);
 
+    bool queueProfile = false;
     switch (requestType)
     {
     case RequestTypeLogin:
-        if (!app->httpRequestAsync("login.txt",
-                                   "https://www.jblanked.com/flipper/api/user/login/",
-                                   POST, "{\"Content-Type\":\"application/json\"}", payload))
+        if (!app->httpRequestQueued("login.txt",
+                                    "https://www.jblanked.com/flipper/api/user/login/",
+                                    onLoginResponse, this,
+                                    POST, "{\"Content-Type\":\"application/json\"}", payload))
         {
             loginStatus = LoginRequestError;
+            break;
         }
+        queueProfile = true;
         break;
     case RequestTypeRegistration:
-        if (!app->httpRequestAsync("register.txt",
-                                   "https://www.jblanked.com/flipper/api/user/register/",
-                                   POST, "{\"Content-Type\":\"application/json\"}", payload))
+        if (!app->httpRequestQueued("register.txt",
+                                    "https://www.jblanked.com/flipper/api/user/register/",
+                                    onRegistrationResponse, this,
+                                    POST, "{\"Content-Type\":\"application/json\"}", payload))
         {
             registrationStatus = RegistrationRequestError;
         }
@@ -1636,11 +1675,14 @@ void Player::userRequest(RequestType requestType)
             userInfoStatus = UserInfoRequestError;
             free(username);
             free(password);
-            free(payload);
             return;
         }
         snprintf(url, 128, "https://www.jblanked.com/flipper/api/user/game-stats/%s/", username);
-        if (!app->httpRequestAsync("user_info.txt", url, GET, "{\"Content-Type\":\"application/json\"}"))
+        if (app->httpRequestQueued("user_info.txt", url, onUserInfoResponse, this, GET, "{\"Content-Type\":\"application/json\"}"))
+        {
+            userInfoStatus = UserInfoWaiting;
+        }
+        else
         {
             userInfoStatus = UserInfoRequestError;
         }
@@ -1650,9 +1692,14 @@ void Player::userRequest(RequestType requestType)
     case RequestTypeLobbies:
     {
         // 10 max players, 4 max lobbies
-        if (!app->httpRequestAsync("lobbies.txt",
+        if (app->httpRequestQueued("lobbies.txt",
                                    "https://www.jblanked.com/flipper/api/world/pve/lobbies/10/4/",
+                                   onLobbiesResponse, this,
                                    GET, "{\"Content-Type\":\"application/json\"}"))
+        {
+            lobbiesStatus = LobbiesWaiting;
+        }
+        else
         {
             lobbiesStatus = LobbiesRequestError;
         }
@@ -1660,20 +1707,25 @@ void Player::userRequest(RequestType requestType)
     break;
     case RequestTypeJoinLobby:
     {
-        char *payload2 = (char *)malloc(256);
-        if (!payload2)
+        char payload2[128];
+        JsonWriter joinWriter;
+        json_writer_init(&joinWriter, payload2, sizeof(payload2));
+        json_writer_object_start(&joinWriter);
+        json_writer_key(&joinWriter, "username");
+        json_writer_string(&joinWriter, username);
+        json_writer_key(&joinWriter, "game_id");
+        json_writer_string(&joinWriter, lobbies[currentLobbyIndex].id);
+        json_writer_object_end(&joinWriter);
+        if (!json_writer_finish(&joinWriter))
         {
-            FURI_LOG_E("Player", "userRequest: Failed to allocate memory for payload2");
+            FURI_LOG_E("Player", "userRequest: Join payload does not fit");
             joinLobbyStatus = JoinLobbyRequestError;
-            free(username);
-            free(password);
-            free(payload);
-            return;
+            break;
         }
-        snprintf(payload2, 256, "{\"username\":\"%s\", \"game_id\":\"%s\"}", username, lobbies[currentLobbyIndex].id);
-        if (!app->httpRequestAsync("join_lobby.txt",
-                                   "https://www.jblanked.com/flipper/api/world/pve/lobby/join/",
-                                   POST, "{\"Content-Type\":\"application/json\"}", payload2))
+        if (!app->httpRequestQueued("join_lobby.txt",
+                                    "https://www.jblanked.com/flipper/api/world/pve/lobby/join/",
+                                    onJoinLobbyResponse, this,
+                                    POST, "{\"Content-Type\":\"application/json\"}", payload2))
         {
             joinLobbyStatus = JoinLobbyRequestError;
         }
@@ -1700,14 +1752,22 @@ void Player::userRequest(RequestType requestType)
         break;
     case RequestTypeSaveStats:
     {
-        const char *playerJson = flipWorldRun->entityToJson(this);
-        if (!app->httpRequestAsync("save_stats.txt",
-                                   "https://www.jblanked.com/flipper/api/user/update-game-stats/",
-                                   POST, "{\"Content-Type\":\"application/json\"}", playerJson))
+        char playerJson[512];
+        JsonWriter statsWriter;
+        json_writer_init(&statsWriter, playerJson, sizeof(playerJson));
+        if (!flipWorldRun->entityToJson(this, &statsWriter) || !json_writer_finish(&statsWriter))
+        {
+            FURI_LOG_E("Player", "Player stats do not fit in payload");
+            break;
+        }
+        // nothing waits for the answer; it is collected by the next poll
+        if (!app->httpRequestQueued("save_stats.txt",
+                                    "https://www.jblanked.com/flipper/api/user/update-game-stats/",
+                                    nullptr, nullptr,
+                                    POST, "{\"Content-Type\":\"application/json\"}", playerJson))
         {
             FURI_LOG_E("Player", "Failed to save player stats");
         }
-        free((void *)playerJson);
     }
     break;
     default:
@@ -1718,11 +1778,14 @@ void Player::userRequest(RequestType requestType)
         lobbiesStatus = LobbiesRequestError;
         free(username);
         free(password);
-        free(payload);
         return;
     }
 
     free(username);
     free(password);
-    free(payload);
+
+    if (queueProfile)
+    {
+        queueProfileRequests();
+    }
 }
\ No newline at end of file
@@ -113,7 +113,12 @@ public:
     void setInputKey(InputKey key) { lastInput = key; }                            // Set the last input key pressed
     bool shouldLeaveGame() const noexcept { return leaveGame == ToggleOn; }        // Check if the player wants to leave the game
     void update(Game *game) override;                                              // update callback for the player
+    void updateCamera(Game *game);                                                 // Center the camera on the player
     void userRequest(RequestType requestType);                                     // Send a user request to the server based on the request type
+    //
+    static void spawn(Entity *entity, float xp);                                                          // Reset any player (local or remote) to the level start with the given xp
+    static void step(Entity *entity, uint8_t input, Game *game, const IconGroupContext *icons);          // Advance any player one frame with the given input (deterministic)
+    static void updateStats(Entity *entity);                                                              // Derive level, strength and max health from xp
 
 private:
     TitleIndex currentTitleIndex = TitleIndexStory;                 // current title index (must be in the GameViewTitle)
@@ -131,6 +136,7 @@ private:
     InputKey lastInput = InputKeyMAX;                               // Last input key pressed
     ToggleState leaveGame = ToggleOff;                              // leave game toggle state
     std::unique_ptr<Loading> loading;                               // loading animation instance
+    bool loadingStarted = false;                                    // whether the loading animation is running
     LobbyInfo lobbies[4];                                           // Array to store lobby information (max 4 lobbies)
     LobbiesStatus lobbiesStatus = LobbiesNotStarted;                // Current lobbies status
     int lobbyCount = 0;                                             // Number of lobbies loaded
@@ -140,6 +146,7 @@ private:
     float systemMenuDebounceTimer = 0.0f;                           // debounce timer for system menu input
     UserInfoStatus userInfoStatus = UserInfoNotStarted;             // Current user info status
 
+    void animateLoading(Draw *canvas, const char *text); // start (with text) or advance the loading animation
     bool areAllEnemiesDead(Game *game);           // Check if all enemies in the current level are dead
     void checkForLevelCompletion(Game *game);     // Check if all enemies are dead and switch to next level
     void drawLobbiesView(Draw *canvas);           // draw the lobbies view
@@ -152,5 +159,13 @@ private:
     void drawUserInfoView(Draw *canvas);          // draw the user info view
     void drawUsername(Vector pos, Game *game);    // draw the username at the specified position
     void drawUserStats(Vector pos, Draw *canvas); // draw the user stats at the specified position
-    void updateStats();                           // update player stats
+    void queueProfileRequests();                  // queue the user info (and in PvE the lobbies) request
+    void stopLoading();                           // stop the loading animation
+    void updateDebounce();                        // count down the system menu debounce timer
+    //
+    static void onJoinLobbyResponse(const FlipperHTTPResponse *response, void *context);    // join lobby request finished
+    static void onLobbiesResponse(const FlipperHTTPResponse *response, void *context);      // lobbies request finished
+    static void onLoginResponse(const FlipperHTTPResponse *response, void *context);        // login request finished
+    static void onRegistrationResponse(const FlipperHTTPResponse *response, void *context); // registration request finished
+    static void onUserInfoResponse(const FlipperHTTPResponse *response, void *context);     // user info request finished
 };
\ No newline at end of file
@@ -0,0 +1,507 @@
+#include "run/protocol.hpp"
+#include "run/general.hpp"
+#include <string.h>
+
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+// Round to the nearest integer and clamp into [low, high] without leaving single precision
+static int32_t quantize(float value, int32_t low, int32_t high)
+{
+    float rounded = value < 0 ? value - 0.5f : value + 0.5f;
+    if (rounded <= (float)low)
+        return low;
+    if (rounded >= (float)high)
+        return high;
+    return (int32_t)rounded;
+}
+
+static void writeU16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static uint16_t readU16(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+uint16_t netPlayerId(const char *name)
+{
+    // players join in a different order on every device, so their ids come from the username;
+    // the high bit keeps them clear of the spawn-order ids the level gives everything else
+    uint32_t hash = assetHash(name ? name : "");
+    return (uint16_t)(0x8000 | (((hash >> 16) ^ hash) & 0x7FFF));
+}
+
+uint16_t netEntityId(const Entity *entity)
+{
+    return entity->type == ENTITY_PLAYER ? netPlayerId(entity->name) : entity->net_id;
+}
+
+uint8_t netDirectionFromVector(Vector dir)
+{
+    if (dir.x == -1 && dir.y == 0)
+        return NetDirectionLeft;
+    if (dir.x == 0 && dir.y == -1)
+        return NetDirectionUp;
+    if (dir.x == 0 && dir.y == 1)
+        return NetDirectionDown;
+    return NetDirectionRight;
+}
+
+Vector netDirectionToVector(uint8_t code)
+{
+    switch (code)
+    {
+    case NetDirectionLeft:
+        return ENTITY_LEFT;
+    case NetDirectionUp:
+        return ENTITY_UP;
+    case NetDirectionDown:
+        return ENTITY_DOWN;
+    default:
+        return ENTITY_RIGHT;
+    }
+}
+
+void netEntityStateFromEntity(const Entity *entity, NetEntityState *out)
+{
+    out->id = netEntityId(entity);
+    out->seq = entity->net_seq;
+    out->isPlayer = entity->type == ENTITY_PLAYER;
+    out->fields = NET_FIELD_ALL;
+    out->position = entity->position;
+    out->direction = netDirectionFromVector(entity->direction);
+    out->state = (uint8_t)entity->state;
+    out->health = entity->health;
+    out->xp = (uint32_t)quantize(entity->xp, 0, INT32_MAX);
+    out->attackElapsed = entity->elapsed_attack_timer;
+}
+
+void netWireStateFromEntityState(const NetEntityState *state, NetWireState *out)
+{
+    out->id = state->id;
+    out->seq = state->seq;
+    out->x = (int16_t)quantize(state->position.x * 4, INT16_MIN, INT16_MAX);
+    out->y = (int16_t)quantize(state->position.y * 4, INT16_MIN, INT16_MAX);
+    out->flags = (uint8_t)((state->direction & 0x03) | ((state->state & 0x07) << 2) | (state->isPlayer ? 0x20 : 0));
+    out->health = (uint16_t)quantize(state->health, 0, UINT16_MAX);
+    out->xp = (uint16_t)(state->xp > UINT16_MAX ? UINT16_MAX : state->xp);
+    out->attack = (uint8_t)quantize(state->attackElapsed * 10, 0, UINT8_MAX);
+}
+
+uint8_t netSeqNext(uint8_t seq)
+{
+    return seq == UINT8_MAX ? 1 : seq + 1;
+}
+
+bool netSeqIsStale(uint8_t last, uint8_t seq)
+{
+    // serial-number arithmetic: how far seq is behind last, modulo 256
+    return last != 0 && (uint8_t)(last - seq) < NET_SEQ_REORDER_WINDOW;
+}
+
+uint8_t netWireStateDiff(const NetWireState *current, const NetWireState *previous)
+{
+    uint8_t fields = 0;
+    if (current->x != previous->x)
+        fields |= NET_FIELD_X;
+    if (current->y != previous->y)
+        fields |= NET_FIELD_Y;
+    if (current->flags != previous->flags)
+        fields |= NET_FIELD_FLAGS;
+    if (current->health != previous->health)
+        fields |= NET_FIELD_HEALTH;
+    if (current->xp != previous->xp)
+        fields |= NET_FIELD_XP;
+    if (current->attack != previous->attack)
+        fields |= NET_FIELD_ATTACK;
+    return fields;
+}
+
+// Write the fields selected by mask in full-record order; returns bytes written
+static size_t writeFields(const NetWireState *state, uint8_t fields, uint8_t *out)
+{
+    size_t pos = 0;
+    if (fields & NET_FIELD_X)
+    {
+        writeU16(out + pos, (uint16_t)state->x);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_Y)
+    {
+        writeU16(out + pos, (uint16_t)state->y);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_FLAGS)
+        out[pos++] = state->flags;
+    if (fields & NET_FIELD_HEALTH)
+    {
+        writeU16(out + pos, state->health);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_XP)
+    {
+        writeU16(out + pos, state->xp);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_ATTACK)
+        out[pos++] = state->attack;
+    return pos;
+}
+
+static size_t fieldsSize(uint8_t fields)
+{
+    return ((fields & NET_FIELD_X) ? 2 : 0) + ((fields & NET_FIELD_Y) ? 2 : 0) + ((fields & NET_FIELD_FLAGS) ? 1 : 0) +
+           ((fields & NET_FIELD_HEALTH) ? 2 : 0) + ((fields & NET_FIELD_XP) ? 2 : 0) + ((fields & NET_FIELD_ATTACK) ? 1 : 0);
+}
+
+size_t netWireStateEncode(const NetWireState *state, uint8_t *out, size_t capacity)
+{
+    if (!state || !out || capacity < NET_ENTITY_STATE_SIZE)
+    {
+        return 0;
+    }
+    out[0] = NET_STATE_VERSION;
+    writeU16(out + 1, state->id);
+    out[3] = state->seq;
+    return 4 + writeFields(state, NET_FIELD_ALL, out + 4);
+}
+
+size_t netWireStateEncodeDelta(const NetWireState *state, uint8_t fields, uint8_t *out, size_t capacity)
+{
+    fields &= NET_FIELD_ALL;
+    if (fields == NET_FIELD_ALL)
+    {
+        // a full record is one byte shorter than a delta carrying every field
+        return netWireStateEncode(state, out, capacity);
+    }
+    if (!state || !out || capacity < 5 + fieldsSize(fields))
+    {
+        return 0;
+    }
+    out[0] = NET_DELTA_VERSION;
+    writeU16(out + 1, state->id);
+    out[3] = state->seq;
+    out[4] = (uint8_t)(fields | ((state->flags & 0x20) ? NET_FIELD_PLAYER : 0));
+    return 5 + writeFields(state, fields, out + 5);
+}
+
+size_t netLevelEncode(uint8_t levelIndex, uint8_t *out, size_t capacity)
+{
+    if (!out || capacity < NET_LEVEL_RECORD_SIZE)
+    {
+        return 0;
+    }
+    out[0] = NET_LEVEL_VERSION;
+    out[1] = levelIndex;
+    return NET_LEVEL_RECORD_SIZE;
+}
+
+size_t netRecordSize(const uint8_t *data, size_t len)
+{
+    if (!data || len == 0)
+    {
+        return 0;
+    }
+    size_t size;
+    switch (data[0])
+    {
+    case NET_STATE_VERSION:
+        size = NET_ENTITY_STATE_SIZE;
+        break;
+    case NET_DELTA_VERSION:
+        size = len < 5 ? 5 : 5 + fieldsSize(data[4] & NET_FIELD_ALL);
+        break;
+    case NET_LEVEL_VERSION:
+        size = NET_LEVEL_RECORD_SIZE;
+        break;
+    case NET_INPUT_VERSION:
+        size = len < 7 ? 7 : 7 + (data[6] + 1) / 2;
+        break;
+    case NET_CHECKSUM_VERSION:
+        size = NET_CHECKSUM_RECORD_SIZE;
+        break;
+    case NET_ROSTER_VERSION:
+        size = len < 4 ? 4 : 4 + data[3] * 6;
+        break;
+    default:
+        return 0;
+    }
+    return size <= len ? size : 0;
+}
+
+bool netRecordHeader(const uint8_t *data, size_t len, uint16_t *id, uint8_t *seq)
+{
+    if (!data || len < NET_RECORD_HEADER_SIZE || (data[0] != NET_STATE_VERSION && data[0] != NET_DELTA_VERSION))
+    {
+        return false;
+    }
+    *id = readU16(data + 1);
+    *seq = data[3];
+    return true;
+}
+
+bool netEntityStateDecode(const uint8_t *data, size_t len, NetEntityState *out)
+{
+    if (!data || !out || len < 5)
+    {
+        return false;
+    }
+    uint8_t fields;
+    size_t pos;
+    if (data[0] == NET_STATE_VERSION)
+    {
+        fields = NET_FIELD_ALL;
+        pos = 4;
+    }
+    else if (data[0] == NET_DELTA_VERSION)
+    {
+        fields = data[4] & NET_FIELD_ALL;
+        out->isPlayer = (data[4] & NET_FIELD_PLAYER) != 0;
+        pos = 5;
+    }
+    else
+    {
+        return false;
+    }
+    if (len < pos + fieldsSize(fields))
+    {
+        return false;
+    }
+    out->id = readU16(data + 1);
+    out->seq = data[3];
+    out->fields = fields;
+    if (fields & NET_FIELD_X)
+    {
+        out->position.x = (int16_t)readU16(data + pos) * 0.25f;
+        pos += 2;
+    }
+    if (fields & NET_FIELD_Y)
+    {
+        out->position.y = (int16_t)readU16(data + pos) * 0.25f;
+        pos += 2;
+    }
+    if (fields & NET_FIELD_FLAGS)
+    {
+        uint8_t flags = data[pos++];
+        out->direction = flags & 0x03;
+        out->state = (flags >> 2) & 0x07;
+        out->isPlayer = (flags & 0x20) != 0;
+        if (out->state > ENTITY_DEAD)
+            return false;
+    }
+    if (fields & NET_FIELD_HEALTH)
+    {
+        out->health = readU16(data + pos);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_XP)
+    {
+        out->xp = readU16(data + pos);
+        pos += 2;
+    }
+    if (fields & NET_FIELD_ATTACK)
+        out->attackElapsed = data[pos] * 0.1f;
+    return true;
+}
+
+size_t netInputBatchEncode(const NetInputBatch *batch, uint8_t *out, size_t capacity)
+{
+    if (!batch || !out || batch->count == 0 || batch->count > NET_INPUT_MAX_TICKS || capacity < 7 + (batch->count + 1) / 2u)
+    {
+        return 0;
+    }
+    out[0] = NET_INPUT_VERSION;
+    writeU16(out + 1, batch->playerId);
+    out[3] = batch->session;
+    writeU16(out + 4, batch->firstTick);
+    out[6] = batch->count;
+    for (uint8_t i = 0; i < batch->count; i += 2)
+    {
+        uint8_t high = i + 1 < batch->count ? batch->inputs[i + 1] : 0;
+        out[7 + i / 2] = (uint8_t)((batch->inputs[i] & 0x0F) | ((high & 0x0F) << 4));
+    }
+    return 7 + (batch->count + 1) / 2;
+}
+
+bool netInputBatchDecode(const uint8_t *data, size_t len, NetInputBatch *out)
+{
+    if (!data || !out || len < 7 || data[0] != NET_INPUT_VERSION || data[6] == 0 || data[6] > NET_INPUT_MAX_TICKS ||
+        len < 7 + (size_t)(data[6] + 1) / 2)
+    {
+        return false;
+    }
+    out->playerId = readU16(data + 1);
+    out->session = data[3];
+    out->firstTick = readU16(data + 4);
+    out->count = data[6];
+    for (uint8_t i = 0; i < out->count; i++)
+    {
+        uint8_t packed = data[7 + i / 2];
+        out->inputs[i] = (i & 1) ? (packed >> 4) : (packed & 0x0F);
+    }
+    return true;
+}
+
+size_t netChecksumEncode(const NetChecksum *checksum, uint8_t *out, size_t capacity)
+{
+    if (!checksum || !out || capacity < NET_CHECKSUM_RECORD_SIZE)
+    {
+        return 0;
+    }
+    out[0] = NET_CHECKSUM_VERSION;
+    writeU16(out + 1, checksum->playerId);
+    out[3] = checksum->session;
+    writeU16(out + 4, checksum->tick);
+    writeU16(out + 6, (uint16_t)(checksum->value & 0xFFFF));
+    writeU16(out + 8, (uint16_t)(checksum->value >> 16));
+    return NET_CHECKSUM_RECORD_SIZE;
+}
+
+bool netChecksumDecode(const uint8_t *data, size_t len, NetChecksum *out)
+{
+    if (!data || !out || len < NET_CHECKSUM_RECORD_SIZE || data[0] != NET_CHECKSUM_VERSION)
+    {
+        return false;
+    }
+    out->playerId = readU16(data + 1);
+    out->session = data[3];
+    out->tick = readU16(data + 4);
+    out->value = readU16(data + 6) | ((uint32_t)readU16(data + 8) << 16);
+    return true;
+}
+
+size_t netRosterEncode(const NetRoster *roster, uint8_t *out, size_t capacity)
+{
+    if (!roster || !out || roster->count == 0 || roster->count > NET_ROSTER_MAX || capacity < 4 + roster->count * 6u)
+    {
+        return 0;
+    }
+    out[0] = NET_ROSTER_VERSION;
+    out[1] = roster->session;
+    out[2] = roster->levelIndex;
+    out[3] = roster->count;
+    for (uint8_t i = 0; i < roster->count; i++)
+    {
+        writeU16(out + 4 + i * 6, roster->players[i]);
+        writeU16(out + 6 + i * 6, (uint16_t)(roster->xp[i] & 0xFFFF));
+        writeU16(out + 8 + i * 6, (uint16_t)(roster->xp[i] >> 16));
+    }
+    return 4 + roster->count * 6;
+}
+
+bool netRosterDecode(const uint8_t *data, size_t len, NetRoster *out)
+{
+    if (!data || !out || len < 4 || data[0] != NET_ROSTER_VERSION || data[3] == 0 || data[3] > NET_ROSTER_MAX ||
+        len < 4 + data[3] * 6u)
+    {
+        return false;
+    }
+    out->session = data[1];
+    out->levelIndex = data[2];
+    out->count = data[3];
+    for (uint8_t i = 0; i < out->count; i++)
+    {
+        out->players[i] = readU16(data + 4 + i * 6);
+        out->xp[i] = readU16(data + 6 + i * 6) | ((uint32_t)readU16(data + 8 + i * 6) << 16);
+    }
+    return true;
+}
+
+bool netRecordToText(const uint8_t *records, size_t len, char *out, size_t capacity)
+{
+    if (!records || len == 0 || !out || capacity < 2)
+    {
+        return false;
+    }
+    out[0] = NET_BINARY_PREFIX;
+    return netBase64Encode(records, len, out + 1, capacity - 1) != 0;
+}
+
+size_t netRecordFromText(const char *text, size_t len, uint8_t *out, size_t capacity)
+{
+    if (!text || len < 2 || text[0] != NET_BINARY_PREFIX)
+    {
+        return 0;
+    }
+    return netBase64Decode(text + 1, len - 1, out, capacity);
+}
+
+size_t netBase64Encode(const uint8_t *data, size_t len, char *out, size_t capacity)
+{
+    size_t needed = NET_BASE64_SIZE(len);
+    if (!data || !out || capacity < needed + 1)
+    {
+        return 0;
+    }
+    size_t pos = 0;
+    for (size_t i = 0; i < len; i += 3)
+    {
+        uint32_t chunk = (uint32_t)data[i] << 16;
+        if (i + 1 < len)
+            chunk |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len)
+            chunk |= data[i + 2];
+        out[pos++] = base64Alphabet[(chunk >> 18) & 0x3F];
+        out[pos++] = base64Alphabet[(chunk >> 12) & 0x3F];
+        if (i + 1 < len)
+            out[pos++] = base64Alphabet[(chunk >> 6) & 0x3F];
+        if (i + 2 < len)
+            out[pos++] = base64Alphabet[chunk & 0x3F];
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+size_t netBase64Decode(const char *text, size_t len, uint8_t *out, size_t capacity)
+{
+    if (!text || !out)
+    {
+        return 0;
+    }
+    // tolerate padding from other encoders
+    while (len > 0 && text[len - 1] == '=')
+    {
+        len--;
+    }
+    if (len % 4 == 1 || len * 3 / 4 > capacity)
+    {
+        return 0;
+    }
+    size_t pos = 0;
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        int value = base64Value(text[i]);
+        if (value < 0)
+        {
+            return 0;
+        }
+        bits = (bits << 6) | (uint32_t)value;
+        bitCount += 6;
+        if (bitCount >= 8)
+        {
+            bitCount -= 8;
+            out[pos++] = (uint8_t)(bits >> bitCount);
+        }
+    }
+    return pos;
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include "engine/entity.hpp"
+#include "engine/vector.hpp"
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Binary entity-state records, sent over the websocket as '~' + unpadded base64.
+ *
+ * Full record (version 1, 14 bytes -> 19 characters):
+ *   [0]      NET_STATE_VERSION
+ *   [1..2]   entity id (u16, little-endian; see netEntityId)
+ *   [3]      sequence number (see netSeqNext)
+ *   [4..5]   position x (int16, quarter pixels)
+ *   [6..7]   position y (int16, quarter pixels)
+ *   [8]      bits 0-1 direction code, bits 2-4 EntityState, bit 5 player flag
+ *   [9..10]  health (u16)
+ *   [11..12] xp (u16, saturated)
+ *   [13]     elapsed attack timer (u8, tenths of a second, saturated)
+ *
+ * Delta record (NET_DELTA_VERSION, 5-13 bytes; a change to every field is sent as a full record):
+ *   [0]      NET_DELTA_VERSION
+ *   [1..2]   entity id
+ *   [3]      sequence number
+ *   [4]      NET_FIELD_* mask of the fields that follow, plus NET_FIELD_PLAYER
+ *   [5..]    the changed fields, in full-record order and encoding
+ *
+ * Level record (NET_LEVEL_VERSION, 2 bytes):
+ *   [0]      NET_LEVEL_VERSION
+ *   [1]      LevelIndex
+ *
+ * Lockstep records (see run/lockstep.hpp):
+ *   input batch (NET_INPUT_VERSION, 8-15 bytes):
+ *     [0] version, [1..2] player id, [3] session, [4..5] first tick (u16, low bits),
+ *     [6] tick count, [7..] one input per tick, two per byte (low nibble first)
+ *   checksum (NET_CHECKSUM_VERSION, 10 bytes):
+ *     [0] version, [1..2] player id, [3] session, [4..5] tick (u16, low bits), [6..9] checksum (u32)
+ *   roster (NET_ROSTER_VERSION, 10-28 bytes; starts a session):
+ *     [0] version, [1] session, [2] LevelIndex, [3] player count, then per player id (u16) and xp (u32)
+ *
+ * Records are self-delimiting, so a batch frame is simply several records back to back,
+ * base64-armored together, up to NET_BATCH_MAX_BYTES per websocket frame.
+ *
+ * Each entity's sender numbers its updates (binary records and JSON keyframes alike) with an 8-bit
+ * sequence that skips 0. Receivers remember the last sequence applied and drop an update that is
+ * at most NET_SEQ_REORDER_WINDOW behind it (a late or repeated frame); anything further behind is
+ * taken as a sender that restarted and is applied.
+ */
+
+#define NET_BINARY_PREFIX '~'                                                   // first character of a binary record on the wire
+#define NET_STATE_VERSION 1                                                     // full record
+#define NET_DELTA_VERSION 2                                                     // delta record
+#define NET_LEVEL_VERSION 3                                                     // level record
+#define NET_LEVEL_RECORD_SIZE 2                                                 // level record size in bytes
+#define NET_INPUT_VERSION 4                                                     // lockstep input batch
+#define NET_CHECKSUM_VERSION 5                                                  // lockstep state checksum
+#define NET_ROSTER_VERSION 6                                                    // lockstep session start
+#define NET_CHECKSUM_RECORD_SIZE 10                                             // checksum record size in bytes
+#define NET_INPUT_MAX_TICKS 16                                                  // most ticks one input batch carries
+#define NET_ROSTER_MAX 4                                                        // most players in a lockstep session
+#define NET_ENTITY_STATE_SIZE 14                                                // largest encoded record in bytes
+#define NET_RECORD_HEADER_SIZE 4                                                // version, id and sequence lead every entity record
+#define NET_SEQ_REORDER_WINDOW 32                                               // updates this far behind the last applied one are stale
+#define NET_BASE64_SIZE(n) ((((n) * 4) + 2) / 3)                                // unpadded base64 length of n bytes
+#define NET_ENTITY_STATE_TEXT_SIZE (NET_BASE64_SIZE(NET_ENTITY_STATE_SIZE) + 2) // prefix + base64 + NUL
+#define NET_MAX_FRAME_SIZE 80                                                   // largest websocket message FlipperHTTP carries in one frame
+#define NET_BATCH_MAX_BYTES (((NET_MAX_FRAME_SIZE - 1) * 3) / 4)                // record bytes that fit in one '~' frame
+
+#define NET_FIELD_X 0x01      // position x
+#define NET_FIELD_Y 0x02      // position y
+#define NET_FIELD_FLAGS 0x04  // direction and state
+#define NET_FIELD_HEALTH 0x08 // health
+#define NET_FIELD_XP 0x10     // xp
+#define NET_FIELD_ATTACK 0x20 // elapsed attack timer
+#define NET_FIELD_ALL 0x3F    // every field (full record)
+#define NET_FIELD_PLAYER 0x80 // delta mask only: the entity is a player
+
+typedef enum
+{
+    NetDirectionLeft = 0,  // ENTITY_LEFT
+    NetDirectionRight = 1, // ENTITY_RIGHT
+    NetDirectionUp = 2,    // ENTITY_UP
+    NetDirectionDown = 3,  // ENTITY_DOWN
+} NetDirection;
+
+// Decoded entity state shared by the JSON and binary sync formats
+struct NetEntityState
+{
+    uint16_t id;         // netEntityId of the entity
+    uint8_t seq;         // sender's sequence number for this entity
+    bool isPlayer;       // player (true) or enemy (false)
+    uint8_t fields;      // NET_FIELD_* mask of the fields below that are set
+    Vector position;     // current position
+    uint8_t direction;   // NetDirection
+    uint8_t state;       // EntityState
+    float health;        // current health
+    uint32_t xp;         // experience
+    float attackElapsed; // elapsed attack timer in seconds
+};
+
+// Quantized state exactly as it goes on the wire; also the per-entity "last sent" snapshot for deltas
+struct NetWireState
+{
+    uint16_t id;     // entity id
+    uint8_t seq;     // sequence number (not part of the delta comparison)
+    int16_t x;       // quarter pixels
+    int16_t y;       // quarter pixels
+    uint8_t flags;   // direction | state << 2 | player << 5
+    uint16_t health; // whole points
+    uint16_t xp;     // saturated
+    uint8_t attack;  // tenths of a second
+};
+
+uint16_t netPlayerId(const char *name);                                   // Player id derived from the username (high bit set)
+uint16_t netEntityId(const Entity *entity);                               // Wire id: netPlayerId for players, the level-assigned net_id otherwise
+uint8_t netDirectionFromVector(Vector dir);                               // Map a direction vector to a NetDirection (right if unknown)
+Vector netDirectionToVector(uint8_t code);                                // Map a NetDirection back to a direction vector
+void netEntityStateFromEntity(const Entity *entity, NetEntityState *out); // Capture an entity's syncable state (all fields)
+void netWireStateFromEntityState(const NetEntityState *state, NetWireState *out); // Quantize a state for the wire
+uint8_t netSeqNext(uint8_t seq);                                          // Sequence number after seq (skips 0, which means "none yet")
+bool netSeqIsStale(uint8_t last, uint8_t seq);                            // True if seq is a duplicate of or shortly behind last
+
+uint8_t netWireStateDiff(const NetWireState *current, const NetWireState *previous);                 // NET_FIELD_* mask of fields that differ
+size_t netWireStateEncode(const NetWireState *state, uint8_t *out, size_t capacity);                 // Write a full record; returns bytes written or 0
+size_t netWireStateEncodeDelta(const NetWireState *state, uint8_t fields, uint8_t *out, size_t capacity); // Write a delta with the given fields
+size_t netLevelEncode(uint8_t levelIndex, uint8_t *out, size_t capacity);                           // Write a level record; returns bytes written or 0
+size_t netRecordSize(const uint8_t *data, size_t len);                                               // Size of the record at data, or 0 if unknown/truncated
+bool netRecordHeader(const uint8_t *data, size_t len, uint16_t *id, uint8_t *seq);                   // Read an entity record's id and sequence without decoding the body
+bool netEntityStateDecode(const uint8_t *data, size_t len, NetEntityState *out);                     // Read a full or delta record; false if malformed
+bool netRecordToText(const uint8_t *records, size_t len, char *out, size_t capacity);                // Armor one or more records as '~' + base64
+size_t netRecordFromText(const char *text, size_t len, uint8_t *out, size_t capacity);               // Strip the '~' and decode; returns record bytes or 0
+
+// One player's inputs for consecutive lockstep ticks
+struct NetInputBatch
+{
+    uint16_t playerId;                         // netEntityId of the player
+    uint8_t session;                           // lockstep session the ticks belong to
+    uint16_t firstTick;                        // low 16 bits of the first tick
+    uint8_t count;                             // ticks in the batch
+    uint8_t inputs[NET_INPUT_MAX_TICKS];       // input per tick (0-15)
+};
+
+// One player's hash of the simulation after a lockstep tick
+struct NetChecksum
+{
+    uint16_t playerId; // netEntityId of the reporting player
+    uint8_t session;   // lockstep session
+    uint16_t tick;     // low 16 bits of the tick
+    uint32_t value;    // state hash
+};
+
+// Players (and the xp they start with) of a lockstep session
+struct NetRoster
+{
+    uint8_t session;                  // session number chosen by the host
+    uint8_t levelIndex;               // level the session runs on
+    uint8_t count;                    // players in the session
+    uint16_t players[NET_ROSTER_MAX]; // player ids
+    uint32_t xp[NET_ROSTER_MAX];      // each player's xp
+};
+
+size_t netInputBatchEncode(const NetInputBatch *batch, uint8_t *out, size_t capacity); // Write an input batch; returns bytes written or 0
+bool netInputBatchDecode(const uint8_t *data, size_t len, NetInputBatch *out);         // Read an input batch; false if malformed
+size_t netChecksumEncode(const NetChecksum *checksum, uint8_t *out, size_t capacity);  // Write a checksum record; returns bytes written or 0
+bool netChecksumDecode(const uint8_t *data, size_t len, NetChecksum *out);             // Read a checksum record; false if malformed
+size_t netRosterEncode(const NetRoster *roster, uint8_t *out, size_t capacity);        // Write a roster record; returns bytes written or 0
+bool netRosterDecode(const uint8_t *data, size_t len, NetRoster *out);                 // Read a roster record; false if malformed
+
+size_t netBase64Encode(const uint8_t *data, size_t len, char *out, size_t capacity);  // Unpadded base64; returns characters written (NUL-terminated) or 0
+size_t netBase64Decode(const char *text, size_t len, uint8_t *out, size_t capacity); // Returns bytes written or 0 on invalid input
@@ -5,32 +5,33 @@
 
 FlipWorldRun::FlipWorldRun()
 {
-    // Initialize chunked messages array
+    // Initialize chunked message pool
     for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
     {
-        chunkedMessages[i].id = 0;
-        chunkedMessages[i].totalChunks = 0;
-        chunkedMessages[i].receivedChunks = 0;
-        chunkedMessages[i].data = nullptr;
-        chunkedMessages[i].dataSize = 0;
-        chunkedMessages[i].dataCapacity = 0;
-        chunkedMessages[i].lastUpdateTime = 0;
+        chunkedMessages[i].active = false;
+        releaseChunkedMessage(&chunkedMessages[i]);
     }
     chunkedMessageCount = 0;
 
     // Initialize message queue
     for (size_t i = 0; i < MAX_QUEUED_MESSAGES; i++)
     {
-        messageQueue[i].message = nullptr;
+        messageQueue[i].message[0] = '\0';
         messageQueue[i].messageLen = 0;
     }
     queueHead = 0;
     queueTail = 0;
     queueSize = 0;
+    queuedBytes = 0;
+
+    netLinkInit(&link, furi_get_tick());
 }
 
 FlipWorldRun::~FlipWorldRun()
 {
+    // the player cancels its queued requests through appContext, so it goes first
+    player.reset();
+
     // Clean up currentIconGroup if allocated
     if (currentIconGroup)
     {
@@ -42,62 +43,71 @@ FlipWorldRun::~FlipWorldRun()
         currentIconGroup = nullptr;
     }
 
-    // Clean up chunked messages
-    for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
-    {
-        if (chunkedMessages[i].data)
-        {
-            free(chunkedMessages[i].data);
-            chunkedMessages[i].data = nullptr;
-        }
-    }
+}
 
-    // Clean up message queue
-    for (size_t i = 0; i < MAX_QUEUED_MESSAGES; i++)
+void FlipWorldRun::addLevelEntities(Level *level, LevelIndex index) const
+{
+    switch (index)
     {
-        if (messageQueue[i].message)
-        {
-            free(messageQueue[i].message);
-            messageQueue[i].message = nullptr;
-        }
-    }
+    case LevelHomeWoods:
+        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(350, 210), Vector(390, 210), 2.0f, 30.0f, 0.4f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(200, 320), Vector(220, 320), 0.5f, 45.0f, 0.6f, 20.0f, 200.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(100, 80), Vector(180, 85), 2.2f, 55.0f, 0.5f, 30.0f, 300.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(400, 50), Vector(490, 50), 1.7f, 35.0f, 1.0f, 20.0f, 200.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Funny NPC", ENTITY_NPC, Vector(350, 180), Vector(350, 180), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f).release());
+        break;
+    case LevelRockWorld:
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(180, 80), Vector(160, 80), 1.0f, 32.0f, 0.5f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(220, 140), Vector(200, 140), 1.5f, 20.0f, 1.0f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(400, 200), Vector(450, 200), 2.0f, 15.0f, 1.2f, 20.0f, 200.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(600, 150), Vector(580, 150), 1.8f, 28.0f, 1.0f, 40.0f, 400.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(500, 250), Vector(480, 250), 1.2f, 30.0f, 0.6f, 10.0f, 100.0f).release());
+        break;
+    case LevelForestWorld:
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(50, 120), Vector(100, 120), 1.0f, 30.0f, 0.5f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(300, 60), Vector(250, 60), 1.5f, 20.0f, 0.8f, 30.0f, 300.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(400, 200), Vector(450, 200), 1.7f, 15.0f, 1.0f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(700, 150), Vector(650, 150), 1.2f, 25.0f, 0.6f, 10.0f, 100.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(200, 300), Vector(250, 300), 2.0f, 18.0f, 0.9f, 20.0f, 200.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(300, 300), Vector(350, 300), 1.5f, 15.0f, 1.2f, 50.0f, 500.0f).release());
+        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(500, 200), Vector(550, 200), 1.3f, 20.0f, 0.7f, 40.0f, 400.0f).release());
+        break;
+    default:
+        break;
+    };
 }
 
-bool FlipWorldRun::addRemotePlayer(const char *username)
+Entity *FlipWorldRun::addRemotePlayer(const char *username)
 {
     // Only add remote players in PvE mode
     if (!isPvEMode || !username)
     {
         FURI_LOG_W("FlipWorldRun", "Cannot add remote player: isPvEMode=%s, username=%s",
                    isPvEMode ? "true" : "false", username ? username : "null");
-        return false;
+        return nullptr;
     }
 
     if (!engine || !engine->getGame() || !engine->getGame()->current_level)
     {
         FURI_LOG_E("FlipWorldRun", "Cannot add remote player: game engine not ready");
-        return false;
+        return nullptr;
     }
 
     auto currentLevel = engine->getGame()->current_level;
 
     // Check if player already exists
-    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    uint16_t netId = netPlayerId(username);
+    Entity *existing = currentLevel->entity_find(netId);
+    if (existing && existing->type == ENTITY_PLAYER)
     {
-        Entity *entity = currentLevel->getEntity(i);
-        if (entity && entity->type == ENTITY_PLAYER &&
-            entity->name && strcmp(entity->name, username) == 0)
-        {
-            // Player already exists
-            return true;
-        }
+        return existing;
     }
 
     char *persistentUsername = (char *)malloc(strlen(username) + 1);
     if (!persistentUsername)
     {
         FURI_LOG_E("FlipWorldRun", "Failed to allocate memory for remote player username");
-        return false;
+        return nullptr;
     }
     strcpy(persistentUsername, username);
 
@@ -127,9 +137,10 @@ bool FlipWorldRun::addRemotePlayer(const char *username)
         remotePlayer->strength = 10.0f;
         remotePlayer->xp = 0.0f;
         remotePlayer->level = 1.0f;
+        remotePlayer->net_id = netId;
 
         currentLevel->entity_add(remotePlayer);
-        return true;
+        return remotePlayer;
     }
     else
     {
@@ -137,7 +148,101 @@ bool FlipWorldRun::addRemotePlayer(const char *username)
         free(persistentUsername);
     }
 
-    return false;
+    return nullptr;
+}
+
+void FlipWorldRun::applyEntityRecord(const uint8_t *record, size_t size)
+{
+    uint16_t id;
+    uint8_t seq;
+    if (!netRecordHeader(record, size, &id, &seq))
+    {
+        return;
+    }
+
+    // Don't update self
+    if (player && id == netEntityId(player.get()))
+    {
+        return;
+    }
+
+    // Remote players are created from the JSON keyframe, which carries the full username.
+    // Followers receive enemy updates from the host; the host never accepts enemy state from others
+    Entity *entity = engine->getGame()->current_level->entity_find(id);
+    if (!entity || (entity->type != ENTITY_PLAYER && entity->type != ENTITY_ENEMY) ||
+        (entity->type == ENTITY_ENEMY && isLobbyHost))
+    {
+        return;
+    }
+
+    // a late or repeated update would roll the entity back; drop it before decoding the body
+    if (netSeqIsStale(entity->net_seq, seq))
+    {
+        netLinkOnStale(&link);
+        return;
+    }
+
+    NetEntityState state;
+    if (netEntityStateDecode(record, size, &state) && state.isPlayer == (entity->type == ENTITY_PLAYER))
+    {
+        applyEntityState(entity, &state);
+        entity->net_seq = seq;
+    }
+}
+
+void FlipWorldRun::applyEntityState(Entity *entity, const NetEntityState *state)
+{
+    // only the fields present in the update are applied; deltas leave the rest untouched
+    if (state->fields & NET_FIELD_HEALTH)
+    {
+        entity->health = state->health;
+    }
+    if (entity->health <= 0)
+    {
+        entity->health = 0;
+        entity->state = ENTITY_DEAD;
+        releaseRemoteMotion(entity);
+        entity->position_set((Vector){-100, -100});
+        return;
+    }
+
+    if (state->fields & NET_FIELD_ATTACK)
+    {
+        entity->elapsed_attack_timer = state->attackElapsed;
+    }
+    if (state->fields & NET_FIELD_FLAGS)
+    {
+        entity->direction = netDirectionToVector(state->direction);
+        entity->state = (EntityState)state->state;
+    }
+
+    if (state->fields & NET_FIELD_XP)
+    {
+        entity->xp = state->xp;
+        entity->level = 1;
+        uint32_t xp_required = 100; // Base XP for level 2
+        while (entity->level < 100 && entity->xp >= xp_required) // Maximum level supported
+        {
+            entity->level++;
+            xp_required = (uint32_t)(xp_required * 1.5); // 1.5 growth factor per level
+        }
+    }
+
+    if (state->fields & (NET_FIELD_X | NET_FIELD_Y))
+    {
+        if (isPvEMode)
+        {
+            // remote entities glide towards the update instead of jumping to it
+            pushRemoteMotion(entity, state->position, state->fields);
+            return;
+        }
+        Vector position = entity->position;
+        if (state->fields & NET_FIELD_X)
+            position.x = state->position.x;
+        if (state->fields & NET_FIELD_Y)
+            position.y = state->position.y;
+        entity->position_set(position);
+    }
 }
 
 void FlipWorldRun::cleanupExpiredChunkedMessages()
@@ -147,23 +252,12 @@ void FlipWorldRun::cleanupExpiredChunkedMessages()
 
     for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
     {
-        if (chunkedMessages[i].data &&
+        if (chunkedMessages[i].active &&
             (currentTime - chunkedMessages[i].lastUpdateTime) > CHUNK_TIMEOUT)
         {
-            FURI_LOG_W("FlipWorldRun", "Cleaning up expired chunked message ID %d (%zu bytes)",
-                       chunkedMessages[i].id, chunkedMessages[i].dataCapacity);
-            free(chunkedMessages[i].data);
-            chunkedMessages[i].data = nullptr;
-            chunkedMessages[i].id = 0;
-            chunkedMessages[i].totalChunks = 0;
-            chunkedMessages[i].receivedChunks = 0;
-            chunkedMessages[i].dataSize = 0;
-            chunkedMessages[i].dataCapacity = 0;
-            chunkedMessages[i].lastUpdateTime = 0;
-            if (chunkedMessageCount > 0)
-            {
-                chunkedMessageCount--;
-            }
+            FURI_LOG_W("FlipWorldRun", "Cleaning up expired chunked message ID %d (%d/%d chunks)",
+                       chunkedMessages[i].id, chunkedMessages[i].receivedChunks, chunkedMessages[i].totalChunks);
+            releaseChunkedMessage(&chunkedMessages[i]);
         }
     }
 
@@ -176,7 +270,7 @@ void FlipWorldRun::cleanupExpiredChunkedMessages()
 
         for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
         {
-            if (chunkedMessages[i].data && chunkedMessages[i].lastUpdateTime < oldestTime)
+            if (chunkedMessages[i].active && chunkedMessages[i].lastUpdateTime < oldestTime)
             {
                 oldestTime = chunkedMessages[i].lastUpdateTime;
                 oldestIndex = i;
@@ -187,20 +281,28 @@ void FlipWorldRun::cleanupExpiredChunkedMessages()
         {
             FURI_LOG_W("FlipWorldRun", "Force cleaning oldest chunked message ID %d",
                        chunkedMessages[oldestIndex].id);
-            free(chunkedMessages[oldestIndex].data);
-            chunkedMessages[oldestIndex].data = nullptr;
-            chunkedMessages[oldestIndex].id = 0;
-            chunkedMessages[oldestIndex].totalChunks = 0;
-            chunkedMessages[oldestIndex].receivedChunks = 0;
-            chunkedMessages[oldestIndex].dataSize = 0;
-            chunkedMessages[oldestIndex].dataCapacity = 0;
-            chunkedMessages[oldestIndex].lastUpdateTime = 0;
-            if (chunkedMessageCount > 0)
-            {
-                chunkedMessageCount--;
-            }
+            releaseChunkedMessage(&chunkedMessages[oldestIndex]);
+        }
+    }
+}
+
+int FlipWorldRun::countLevelPlayers()
+{
+    if (!engine || !engine->getGame() || !engine->getGame()->current_level)
+    {
+        return 0;
+    }
+    auto currentLevel = engine->getGame()->current_level;
+    int count = 0;
+    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (entity && entity->type == ENTITY_PLAYER)
+        {
+            count++;
         }
     }
+    return count;
 }
 
 void FlipWorldRun::debounceInput()
@@ -220,6 +322,35 @@ void FlipWorldRun::debounceInput()
     }
 }
 
+void FlipWorldRun::dropQueuedMessage()
+{
+    if (queueSize == 0)
+    {
+        return;
+    }
+    QueuedMessage *slot = &messageQueue[queueHead];
+    queuedBytes -= slot->messageLen + 1;
+    slot->message[0] = '\0';
+    slot->messageLen = 0;
+    queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
+    queueSize--;
+}
+
+bool FlipWorldRun::dropStaleUpdate(Entity *entity, const JsonDoc *doc, int obj)
+{
+    int32_t seq;
+    if (!json_doc_get_int(doc, obj, "q", &seq) || seq < 0 || seq > UINT8_MAX)
+    {
+        return false; // unnumbered update: apply it
+    }
+    if (netSeqIsStale(entity->net_seq, (uint8_t)seq))
+    {
+        netLinkOnStale(&link);
+        return true;
+    }
+    return false; // parseEntityDataFromJson commits the sequence once the update has applied
+}
+
 void FlipWorldRun::endGame()
 {
     shouldReturnToMenu = true;
@@ -243,6 +374,14 @@ void FlipWorldRun::endGame()
 
     isPvEMode = false;
     isLobbyHost = false;
+    netLockstepStop(&lockstep);
+    lockstepEnabled = false;
+    lockstepEndedAt = 0;
+    snapshotPending = false;
+    snapshotReceived = false;
+    announcedLevel = -1;
+    announcedPlayers = 0;
+    lastJoinRequestTime = 0;
 }
 
 bool FlipWorldRun::entityJsonUpdate(Entity *entity)
@@ -282,142 +421,69 @@ bool FlipWorldRun::entityJsonUpdate(Entity *entity)
     }
     */
 
-    char *u = get_json_value("u", response);
-    if (!u)
+    // tokenize once; every field below is a view into the response
+    jsmntok_t tokens[MAX_ENTITY_JSON_TOKENS];
+    JsonDoc doc;
+    if (!json_doc_parse(&doc, response, strlen(response), tokens, MAX_ENTITY_JSON_TOKENS))
     {
-        FURI_LOG_E("Game", "entityJsonUpdate: Failed to get username");
+        FURI_LOG_E("Game", "entityJsonUpdate: Failed to parse response");
         return false;
     }
 
-    // check if the username matches
-    if (strcmp(u, entity->name) != 0)
+    JsonView u;
+    if (!json_doc_get_view(&doc, 0, "u", &u))
     {
-        free(u);
-        return false;
-    }
-
-    free(u); // free username
-
-    // we need the health, elapsed attack timer, direction, xp, and position
-    char *h = get_json_value("h", response);
-    char *eat = get_json_value("eat", response);
-    char *d = get_json_value("d", response);
-    char *xp = get_json_value("xp", response);
-    char *sp = get_json_value("sp", response);
-    char *x = get_json_value("x", sp);
-    char *y = get_json_value("y", sp);
-
-    if (!h || !eat || !d || !sp || !x || !y || !xp)
-    {
-        if (h)
-            free(h);
-        if (eat)
-            free(eat);
-        if (d)
-            free(d);
-        if (sp)
-            free(sp);
-        if (x)
-            free(x);
-        if (y)
-            free(y);
-        if (xp)
-            free(xp);
+        FURI_LOG_E("Game", "entityJsonUpdate: Failed to get username");
         return false;
     }
 
-    // set enemy info
-    entity->health = (float)atoi(h); // h is an int
-    if (entity->health <= 0)
+    // check if the username matches
+    if (!json_view_eq(u, entity->name))
     {
-        entity->health = 0;
-        entity->state = ENTITY_DEAD;
-        entity->position_set((Vector){-100, -100});
-        free(h);
-        free(eat);
-        free(d);
-        free(sp);
-        free(x);
-        free(y);
-        free(xp);
-        return true;
+        return false;
     }
 
-    entity->elapsed_attack_timer = atof_(eat);
-
-    switch (atoi(d))
+    // we need the health, elapsed attack timer, direction, state, xp, and position
+    // eat and sp are sent with one decimal; read them as tenths
+    int32_t h, d, s, xp, eat_tenths, x_tenths, y_tenths;
+    if (!json_doc_get_int(&doc, 0, "h", &h) ||
+        !json_doc_get_fixed(&doc, 0, "eat", 1, &eat_tenths) ||
+        !json_doc_get_int(&doc, 0, "d", &d) ||
+        !json_doc_get_int(&doc, 0, "s", &s) ||
+        !json_doc_get_int(&doc, 0, "xp", &xp) ||
+        !json_doc_get_fixed(&doc, 0, "sp.x", 1, &x_tenths) ||
+        !json_doc_get_fixed(&doc, 0, "sp.y", 1, &y_tenths))
     {
-    case 0:
-        entity->direction = ENTITY_LEFT;
-        break;
-    case 1:
-        entity->direction = ENTITY_RIGHT;
-        break;
-    case 2:
-        entity->direction = ENTITY_UP;
-        break;
-    case 3:
-        entity->direction = ENTITY_DOWN;
-        break;
-    default:
-        entity->direction = ENTITY_RIGHT;
-        break;
+        return false;
     }
 
-    entity->xp = (atoi)(xp); // xp is an int
-    entity->level = 1;
-    uint32_t xp_required = 100; // Base XP for level 2
-
-    while (entity->level < 100 && entity->xp >= xp_required) // Maximum level supported
+    // out-of-range codes are refused, as the binary decoder does
+    if (d < NetDirectionLeft || d > NetDirectionDown || s < 0 || s > ENTITY_DEAD)
     {
-        entity->level++;
-        xp_required = (uint32_t)(xp_required * 1.5); // 1.5 growth factor per level
+        return false;
     }
 
-    // set position
-    entity->position_set(Vector(atof_(x), atof_(y)));
-
-    // free the strings
-    free(h);
-    free(eat);
-    free(d);
-    free(sp);
-    free(x);
-    free(y);
-    free(xp);
-
+    NetEntityState state;
+    state.id = netEntityId(entity);
+    state.isPlayer = entity->type == ENTITY_PLAYER;
+    state.fields = NET_FIELD_ALL;
+    state.position = Vector(x_tenths * 0.1f, y_tenths * 0.1f);
+    state.direction = (uint8_t)d;
+    state.state = (uint8_t)s;
+    state.health = (float)h; // h is an int
+    state.xp = xp > 0 ? (uint32_t)xp : 0;
+    state.attackElapsed = eat_tenths * 0.1f;
+    applyEntityState(entity, &state);
     return true;
 }
 
-const char *FlipWorldRun::entityToJson(Entity *entity, bool websocketParsing) const
+bool FlipWorldRun::entityToJson(Entity *entity, JsonWriter *writer, bool websocketParsing) const
 {
-    // "safely" append string to dynamically allocated buffer
-    auto append_to_buffer = [](char **buffer, size_t *size, size_t *capacity, const char *str)
+    if (!entity || !writer)
     {
-        size_t str_len = strlen(str);
-        size_t new_size = *size + str_len;
-
-        if (new_size >= *capacity)
-        {
-            size_t new_capacity = *capacity * 2;
-            while (new_capacity <= new_size)
-            {
-                new_capacity *= 2;
-            }
-            char *new_buffer = (char *)realloc(*buffer, new_capacity);
-            if (!new_buffer)
-            {
-                return false;
-            }
-            *buffer = new_buffer;
-            *capacity = new_capacity;
-        }
-
-        memcpy(*buffer + *size, str, str_len);
-        (*buffer)[new_size] = '\0'; // Null terminate
-        *size = new_size;
-        return true;
-    };
+        FURI_LOG_E(TAG, "entityToJson: Invalid parameters");
+        return false;
+    }
 
     // Helper function to convert direction Vector to numeric code
     auto direction_to_code = [](Vector dir) -> int
@@ -428,299 +494,125 @@ const char *FlipWorldRun::entityToJson(Entity *entity, bool websocketParsing) co
             return 1; // ENTITY_RIGHT
         if (dir.x == 0 && dir.y == -1)
             return 2; // ENTITY_UP
-        if (dir.x == 0 && dir.y == 1)
-            return 3; // ENTITY_DOWN
-        return 1;     // default to right
-    };
-
-    // Initial capacity for the JSON buffer
-    size_t json_capacity = 512;
-    size_t json_size = 0;
-    char *json = (char *)malloc(json_capacity);
-    if (!json)
-    {
-        FURI_LOG_E(TAG, "Failed to allocate JSON string");
-        return NULL;
-    }
-    json[0] = '\0'; // Initialize empty string
-
-    if (!append_to_buffer(&json, &json_size, &json_capacity, "{"))
-    {
-        free(json);
-        return NULL;
-    }
-
-    if (websocketParsing)
-    {
-        // Minimal JSON for WebSocket (abbreviated, <128 characters)
-        // "u": username
-        if (!append_to_buffer(&json, &json_size, &json_capacity, "\"u\":\"") ||
-            !append_to_buffer(&json, &json_size, &json_capacity, entity->name) ||
-            !append_to_buffer(&json, &json_size, &json_capacity, "\","))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "xp": experience
-        char buffer[32];
-        snprintf(buffer, sizeof(buffer), "\"xp\":%.0f,", (double)entity->xp);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "h": health
-        snprintf(buffer, sizeof(buffer), "\"h\":%.0f,", (double)entity->health);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "ehr": elapsed health regen (1 decimal)
-        snprintf(buffer, sizeof(buffer), "\"ehr\":%.1f,", (double)entity->elapsed_health_regen);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "eat": elapsed attack timer (1 decimal)
-        snprintf(buffer, sizeof(buffer), "\"eat\":%.1f,", (double)entity->elapsed_attack_timer);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "d": direction (numeric code)
-        snprintf(buffer, sizeof(buffer), "\"d\":%d,", direction_to_code(entity->direction));
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // "s": state (numeric code)
-        snprintf(buffer, sizeof(buffer), "\"s\":%d,", entity->state);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // instead of start position, send the current
-        // "sp": start position object with x and y (1 decimal)
-        snprintf(buffer, sizeof(buffer), "\"sp\":{\"x\":%.1f,\"y\":%.1f}",
-                 (double)entity->position.x, (double)entity->position.y);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-    }
-    else
-    {
-        // Full JSON output (unchanged)
-        // 1. Username
-        if (!append_to_buffer(&json, &json_size, &json_capacity, "\"username\":\"") ||
-            !append_to_buffer(&json, &json_size, &json_capacity, entity->name) ||
-            !append_to_buffer(&json, &json_size, &json_capacity, "\","))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 2. Level
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "\"level\":%.0f,", (double)entity->level);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 3. XP
-        snprintf(buffer, sizeof(buffer), "\"xp\":%.0f,", (double)entity->xp);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 4. Health
-        snprintf(buffer, sizeof(buffer), "\"health\":%.0f,", (double)entity->health);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 5. Strength
-        snprintf(buffer, sizeof(buffer), "\"strength\":%.0f,", (double)entity->strength);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 6. Max Health
-        snprintf(buffer, sizeof(buffer), "\"max_health\":%.0f,", (double)entity->max_health);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 7. Health Regen
-        snprintf(buffer, sizeof(buffer), "\"health_regen\":%.0f,", (double)entity->health_regen);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 8. Elapsed Health Regen
-        snprintf(buffer, sizeof(buffer), "\"elapsed_health_regen\":%.6f,", (double)entity->elapsed_health_regen);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 9. Attack Timer
-        snprintf(buffer, sizeof(buffer), "\"attack_timer\":%.6f,", (double)entity->attack_timer);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 10. Elapsed Attack Timer
-        snprintf(buffer, sizeof(buffer), "\"elapsed_attack_timer\":%.6f,", (double)entity->elapsed_attack_timer);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 11. Direction (string representation)
-        const char *direction_str;
-        Vector dir = entity->direction;
-        if (dir.x == 0 && dir.y == -1)
-        {
-            direction_str = "\"direction\":\"up\",";
-        }
-        else if (dir.x == 0 && dir.y == 1)
-        {
-            direction_str = "\"direction\":\"down\",";
-        }
-        else if (dir.x == -1 && dir.y == 0)
-        {
-            direction_str = "\"direction\":\"left\",";
-        }
-        else
-        {
-            direction_str = "\"direction\":\"right\",";
-        }
-        if (!append_to_buffer(&json, &json_size, &json_capacity, direction_str))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 12. State (string representation)
-        const char *state_str;
-        switch (entity->state)
-        {
-        case ENTITY_IDLE:
-            state_str = "\"state\":\"idle\",";
-            break;
-        case ENTITY_MOVING:
-            state_str = "\"state\":\"moving\",";
-            break;
-        case ENTITY_ATTACKING:
-            state_str = "\"state\":\"attacking\",";
-            break;
-        case ENTITY_ATTACKED:
-            state_str = "\"state\":\"attacked\",";
-            break;
-        case ENTITY_DEAD:
-            state_str = "\"state\":\"dead\",";
-            break;
-        default:
-            state_str = "\"state\":\"unknown\",";
-            break;
-        }
-        if (!append_to_buffer(&json, &json_size, &json_capacity, state_str))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 13. Start Position X
-        snprintf(buffer, sizeof(buffer), "\"start_position_x\":%.6f,", (double)entity->start_position.x);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 14. Start Position Y
-        snprintf(buffer, sizeof(buffer), "\"start_position_y\":%.6f,", (double)entity->start_position.y);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 15. dx (direction x component)
-        snprintf(buffer, sizeof(buffer), "\"dx\":%.0f,", (double)entity->direction.x);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-
-        // 16. dy (direction y component)
-        snprintf(buffer, sizeof(buffer), "\"dy\":%.0f", (double)entity->direction.y);
-        if (!append_to_buffer(&json, &json_size, &json_capacity, buffer))
-        {
-            free(json);
-            return NULL;
-        }
-    }
-
-    if (!append_to_buffer(&json, &json_size, &json_capacity, "}"))
-    {
-        free(json);
-        return NULL;
-    }
+        if (dir.x == 0 && dir.y == 1)
+            return 3; // ENTITY_DOWN
+        return 1;     // default to right
+    };
 
-    // For websocket, output only the minimal JSON
     if (websocketParsing)
     {
-        return json;
-    }
+        // Minimal JSON for WebSocket (abbreviated, <128 characters)
+        json_writer_object_start(writer);
+        json_writer_key(writer, "u"); // username
+        json_writer_string(writer, entity->name);
+        if (entity->type != ENTITY_PLAYER)
+        {
+            json_writer_key(writer, "n"); // net id (players are keyed by username)
+            json_writer_uint(writer, entity->net_id);
+        }
+        json_writer_key(writer, "q"); // sequence number of this update
+        json_writer_uint(writer, entity->net_seq);
+        json_writer_key(writer, "xp"); // experience
+        json_writer_fixed(writer, entity->xp, 0);
+        json_writer_key(writer, "h"); // health
+        json_writer_fixed(writer, entity->health, 0);
+        json_writer_key(writer, "ehr"); // elapsed health regen (1 decimal)
+        json_writer_fixed(writer, entity->elapsed_health_regen, 1);
+        json_writer_key(writer, "eat"); // elapsed attack timer (1 decimal)
+        json_writer_fixed(writer, entity->elapsed_attack_timer, 1);
+        json_writer_key(writer, "d"); // direction (numeric code)
+        json_writer_int(writer, direction_to_code(entity->direction));
+        json_writer_key(writer, "s"); // state (numeric code)
+        json_writer_int(writer, entity->state);
+
+        // instead of start position, send the current
+        // "sp": start position object with x and y (1 decimal)
+        json_writer_key(writer, "sp");
+        json_writer_object_start(writer);
+        json_writer_key(writer, "x");
+        json_writer_fixed(writer, entity->position.x, 1);
+        json_writer_key(writer, "y");
+        json_writer_fixed(writer, entity->position.y, 1);
+        json_writer_object_end(writer);
+        json_writer_object_end(writer);
+        return json_writer_ok(writer); // the caller may have opened a wrapper around it
+    }
+
+    // Full JSON output, wrapped as {"username":..,"game_stats":{..}}
+    const char *direction_str;
+    Vector dir = entity->direction;
+    if (dir.x == 0 && dir.y == -1)
+        direction_str = "up";
+    else if (dir.x == 0 && dir.y == 1)
+        direction_str = "down";
+    else if (dir.x == -1 && dir.y == 0)
+        direction_str = "left";
     else
-    {
-        // Allocate buffer for the wrapped JSON
-        size_t wrapped_capacity = json_size + 256; // Extra space for wrapper
-        char *json_data = (char *)malloc(wrapped_capacity);
-        if (!json_data)
-        {
-            FURI_LOG_E(TAG, "Failed to allocate wrapped JSON string");
-            free(json);
-            return NULL;
-        }
+        direction_str = "right";
 
-        snprintf(json_data, wrapped_capacity, "{\"username\":\"%s\",\"game_stats\":%s}",
-                 entity->name, json);
-        free(json);
-        return json_data;
+    const char *state_str;
+    switch (entity->state)
+    {
+    case ENTITY_IDLE:
+        state_str = "idle";
+        break;
+    case ENTITY_MOVING:
+        state_str = "moving";
+        break;
+    case ENTITY_ATTACKING:
+        state_str = "attacking";
+        break;
+    case ENTITY_ATTACKED:
+        state_str = "attacked";
+        break;
+    case ENTITY_DEAD:
+        state_str = "dead";
+        break;
+    default:
+        state_str = "unknown";
+        break;
     }
+
+    json_writer_object_start(writer);
+    json_writer_key(writer, "username");
+    json_writer_string(writer, entity->name);
+    json_writer_key(writer, "game_stats");
+    json_writer_object_start(writer);
+    json_writer_key(writer, "username");
+    json_writer_string(writer, entity->name);
+    json_writer_key(writer, "level");
+    json_writer_fixed(writer, entity->level, 0);
+    json_writer_key(writer, "xp");
+    json_writer_fixed(writer, entity->xp, 0);
+    json_writer_key(writer, "health");
+    json_writer_fixed(writer, entity->health, 0);
+    json_writer_key(writer, "strength");
+    json_writer_fixed(writer, entity->strength, 0);
+    json_writer_key(writer, "max_health");
+    json_writer_fixed(writer, entity->max_health, 0);
+    json_writer_key(writer, "health_regen");
+    json_writer_fixed(writer, entity->health_regen, 0);
+    json_writer_key(writer, "elapsed_health_regen");
+    json_writer_fixed(writer, entity->elapsed_health_regen, 6);
+    json_writer_key(writer, "attack_timer");
+    json_writer_fixed(writer, entity->attack_timer, 6);
+    json_writer_key(writer, "elapsed_attack_timer");
+    json_writer_fixed(writer, entity->elapsed_attack_timer, 6);
+    json_writer_key(writer, "direction");
+    json_writer_string(writer, direction_str);
+    json_writer_key(writer, "state");
+    json_writer_string(writer, state_str);
+    json_writer_key(writer, "start_position_x");
+    json_writer_fixed(writer, entity->start_position.x, 6);
+    json_writer_key(writer, "start_position_y");
+    json_writer_fixed(writer, entity->start_position.y, 6);
+    json_writer_key(writer, "dx");
+    json_writer_fixed(writer, entity->direction.x, 0);
+    json_writer_key(writer, "dy");
+    json_writer_fixed(writer, entity->direction.y, 0);
+    json_writer_object_end(writer);
+    json_writer_object_end(writer);
+    return json_writer_ok(writer);
 }
 
 LevelIndex FlipWorldRun::getCurrentLevelIndex() const
@@ -752,26 +644,73 @@ LevelIndex FlipWorldRun::getCurrentLevelIndex() const
     return LevelUnknown;
 }
 
+// Icon registry indexed by IconID; level data may reference an icon by name or by its ID
+static const struct
+{
+    const char *name;
+    const uint8_t *icon;
+    Vector size;
+} iconRegistry[ICON_ID_COUNT] = {
+    {"house", icon_house_48x32px, Vector(48, 32)},             // ICON_ID_HOUSE
+    {"plant", icon_plant_16x16, Vector(16, 16)},               // ICON_ID_PLANT
+    {"tree", icon_tree_16x16, Vector(16, 16)},                 // ICON_ID_TREE
+    {"fence", icon_fence_16x8px, Vector(16, 8)},               // ICON_ID_FENCE
+    {"flower", icon_flower_16x16, Vector(16, 16)},             // ICON_ID_FLOWER
+    {"rock_large", icon_rock_large_18x19px, Vector(18, 19)},   // ICON_ID_ROCK_LARGE
+    {"rock_medium", icon_rock_medium_16x14px, Vector(16, 14)}, // ICON_ID_ROCK_MEDIUM
+    {"rock_small", icon_rock_small_10x8px, Vector(10, 8)},     // ICON_ID_ROCK_SMALL
+};
+
+IconID iconIdFromName(const char *name)
+{
+    if (!name)
+        return ICON_ID_INVALID;
+
+    IconID id;
+    switch (assetHash(name))
+    {
+    case assetHash("house"):
+        id = ICON_ID_HOUSE;
+        break;
+    case assetHash("plant"):
+        id = ICON_ID_PLANT;
+        break;
+    case assetHash("tree"):
+        id = ICON_ID_TREE;
+        break;
+    case assetHash("fence"):
+        id = ICON_ID_FENCE;
+        break;
+    case assetHash("flower"):
+        id = ICON_ID_FLOWER;
+        break;
+    case assetHash("rock_large"):
+        id = ICON_ID_ROCK_LARGE;
+        break;
+    case assetHash("rock_medium"):
+        id = ICON_ID_ROCK_MEDIUM;
+        break;
+    case assetHash("rock_small"):
+        id = ICON_ID_ROCK_SMALL;
+        break;
+    default:
+        return ICON_ID_INVALID;
+    }
+
+    return assetNameMatches(name, iconRegistry[id].name) ? id : ICON_ID_INVALID;
+}
+
+IconSpec FlipWorldRun::getIconSpec(IconID id) const
+{
+    if (id <= ICON_ID_INVALID || id >= ICON_ID_COUNT)
+        return (IconSpec){.id = ICON_ID_INVALID, .icon = NULL, .pos = Vector(0, 0), .size = (Vector){0, 0}};
+
+    return (IconSpec){.id = id, .icon = iconRegistry[id].icon, .pos = Vector(0, 0), .size = iconRegistry[id].size};
+}
+
 IconSpec FlipWorldRun::getIconSpec(const char *name) const
 {
-    if (strcmp(name, "house") == 0)
-        return (IconSpec){.id = ICON_ID_HOUSE, .icon = icon_house_48x32px, .pos = Vector(0, 0), .size = (Vector){48, 32}};
-    if (strcmp(name, "plant") == 0)
-        return (IconSpec){.id = ICON_ID_PLANT, .icon = icon_plant_16x16, .pos = Vector(0, 0), .size = (Vector){16, 16}};
-    if (strcmp(name, "tree") == 0)
-        return (IconSpec){.id = ICON_ID_TREE, .icon = icon_tree_16x16, .pos = Vector(0, 0), .size = (Vector){16, 16}};
-    if (strcmp(name, "fence") == 0)
-        return (IconSpec){.id = ICON_ID_FENCE, .icon = icon_fence_16x8px, .pos = Vector(0, 0), .size = (Vector){16, 8}};
-    if (strcmp(name, "flower") == 0)
-        return (IconSpec){.id = ICON_ID_FLOWER, .icon = icon_flower_16x16, .pos = Vector(0, 0), .size = (Vector){16, 16}};
-    if (strcmp(name, "rock_large") == 0)
-        return (IconSpec){.id = ICON_ID_ROCK_LARGE, .icon = icon_rock_large_18x19px, .pos = Vector(0, 0), .size = (Vector){18, 19}};
-    if (strcmp(name, "rock_medium") == 0)
-        return (IconSpec){.id = ICON_ID_ROCK_MEDIUM, .icon = icon_rock_medium_16x14px, .pos = Vector(0, 0), .size = (Vector){16, 14}};
-    if (strcmp(name, "rock_small") == 0)
-        return (IconSpec){.id = ICON_ID_ROCK_SMALL, .icon = icon_rock_small_10x8px, .pos = Vector(0, 0), .size = (Vector){10, 8}};
-
-    return (IconSpec){.id = ICON_ID_INVALID, .icon = NULL, .pos = Vector(0, 0), .size = (Vector){0, 0}};
+    return getIconSpec(iconIdFromName(name));
 }
 
 const char *FlipWorldRun::getLevelJson(LevelIndex index) const
@@ -862,34 +801,7 @@ std::unique_ptr<Level> FlipWorldRun::getLevel(LevelIndex index, Game *game) cons
         FURI_LOG_E("FlipWorldRun", "Failed to create Level object");
         return nullptr;
     }
-    switch (index)
-    {
-    case LevelHomeWoods:
-        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(350, 210), Vector(390, 210), 2.0f, 30.0f, 0.4f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(200, 320), Vector(220, 320), 0.5f, 45.0f, 0.6f, 20.0f, 200.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(100, 80), Vector(180, 85), 2.2f, 55.0f, 0.5f, 30.0f, 300.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(400, 50), Vector(490, 50), 1.7f, 35.0f, 1.0f, 20.0f, 200.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Funny NPC", ENTITY_NPC, Vector(350, 180), Vector(350, 180), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f).release());
-        break;
-    case LevelRockWorld:
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(180, 80), Vector(160, 80), 1.0f, 32.0f, 0.5f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(220, 140), Vector(200, 140), 1.5f, 20.0f, 1.0f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(400, 200), Vector(450, 200), 2.0f, 15.0f, 1.2f, 20.0f, 200.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(600, 150), Vector(580, 150), 1.8f, 28.0f, 1.0f, 40.0f, 400.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(500, 250), Vector(480, 250), 1.2f, 30.0f, 0.6f, 10.0f, 100.0f).release());
-        break;
-    case LevelForestWorld:
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(50, 120), Vector(100, 120), 1.0f, 30.0f, 0.5f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(300, 60), Vector(250, 60), 1.5f, 20.0f, 0.8f, 30.0f, 300.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(400, 200), Vector(450, 200), 1.7f, 15.0f, 1.0f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(700, 150), Vector(650, 150), 1.2f, 25.0f, 0.6f, 10.0f, 100.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Cyclops", ENTITY_ENEMY, Vector(200, 300), Vector(250, 300), 2.0f, 18.0f, 0.9f, 20.0f, 200.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ogre", ENTITY_ENEMY, Vector(300, 300), Vector(350, 300), 1.5f, 15.0f, 1.2f, 50.0f, 500.0f).release());
-        level->entity_add(std::make_unique<Sprite>("Ghost", ENTITY_ENEMY, Vector(500, 200), Vector(550, 200), 1.3f, 20.0f, 0.7f, 40.0f, 400.0f).release());
-        break;
-    default:
-        break;
-    };
+    addLevelEntities(level.get(), index);
     return level;
 }
 
@@ -912,31 +824,52 @@ size_t FlipWorldRun::getMemoryUsage() const
 {
     size_t totalMemory = 0;
 
-    // Count chunked message memory
-    for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
+    // Count reassembly slots in use (each is a fixed-size pool buffer)
+    totalMemory += chunkedMessageCount * sizeof(ChunkedMessage::data);
+
+    // Count queued message bytes (kept as a running total by the queue)
+    totalMemory += queuedBytes;
+
+    // Count icon group memory if allocated
+    if (currentIconGroup && currentIconGroup->icons)
+    {
+        totalMemory += currentIconGroup->count * sizeof(IconSpec);
+    }
+
+    return totalMemory;
+}
+
+FlipWorldRun::SyncSnapshot *FlipWorldRun::getSyncSnapshot(uint16_t id, bool isPlayer)
+{
+    for (size_t i = 0; i < MAX_SYNC_SNAPSHOTS; i++)
     {
-        if (chunkedMessages[i].data)
+        SyncSnapshot *snapshot = &syncSnapshots[i];
+        if (snapshot->valid && snapshot->wire.id == id && ((snapshot->wire.flags & 0x20) != 0) == isPlayer)
         {
-            totalMemory += chunkedMessages[i].dataCapacity;
+            snapshot->round = syncCount;
+            return snapshot;
         }
     }
-
-    // Count queued message memory
-    for (size_t i = 0; i < MAX_QUEUED_MESSAGES; i++)
+    for (size_t i = 0; i < MAX_SYNC_SNAPSHOTS; i++)
     {
-        if (messageQueue[i].message)
+        if (!syncSnapshots[i].valid && syncSnapshots[i].round != syncCount)
         {
-            totalMemory += messageQueue[i].messageLen + 1; // +1 for null terminator
+            syncSnapshots[i].round = syncCount;
+            return &syncSnapshots[i];
         }
     }
-
-    // Count icon group memory if allocated
-    if (currentIconGroup && currentIconGroup->icons)
+    // table full: recycle slots in turn, skipping any already handed out this sync round
+    // (the evicted entity's next update is sent in full)
+    SyncSnapshot *snapshot = &syncSnapshots[syncSnapshotNext];
+    for (size_t i = 0; i < MAX_SYNC_SNAPSHOTS && snapshot->round == syncCount; i++)
     {
-        totalMemory += currentIconGroup->count * sizeof(IconSpec);
+        syncSnapshotNext = (syncSnapshotNext + 1) % MAX_SYNC_SNAPSHOTS;
+        snapshot = &syncSnapshots[syncSnapshotNext];
     }
-
-    return totalMemory;
+    syncSnapshotNext = (syncSnapshotNext + 1) % MAX_SYNC_SNAPSHOTS;
+    snapshot->valid = false;
+    snapshot->round = syncCount;
+    return snapshot;
 }
 
 bool FlipWorldRun::handleChunkedMessage(const char *message)
@@ -1041,234 +974,114 @@ bool FlipWorldRun::handleChunkedMessage(const char *message)
     }
 
     size_t dataLen = dataEnd - dataPos;
-    char *dataStr = (char *)malloc(dataLen + 1);
-    if (!dataStr)
+
+    // Validate chunk parameters
+    if (totalChunks <= 0 || totalChunks > MAX_CHUNKS_PER_MESSAGE)
     {
-        FURI_LOG_E("FlipWorldRun", "Failed to allocate memory for data string");
+        FURI_LOG_E("FlipWorldRun", "Invalid totalChunks: %d (max: %d)", totalChunks, MAX_CHUNKS_PER_MESSAGE);
         return true;
     }
-
-    memcpy(dataStr, dataPos, dataLen);
-    dataStr[dataLen] = '\0';
-
-    // if we're already using too much memory, reject new chunked messages
-    size_t currentMemoryUsage = getMemoryUsage();
-    size_t freeHeap = memmgr_get_free_heap();
-    const size_t MEMORY_PRESSURE_THRESHOLD = 12288;
-    const size_t CRITICAL_HEAP_THRESHOLD = 8192;
-
-    if (currentMemoryUsage > MEMORY_PRESSURE_THRESHOLD || freeHeap < CRITICAL_HEAP_THRESHOLD)
+    if (seqVal < 1 || seqVal > totalChunks)
     {
-        FURI_LOG_E("FlipWorldRun", "Memory pressure (used: %zu bytes, free heap: %zu bytes), rejecting chunked message",
-                   currentMemoryUsage, freeHeap);
-        free(dataStr);
-        return true; // Consumed but rejected
+        FURI_LOG_E("FlipWorldRun", "Invalid seq %d for %d chunks", seqVal, totalChunks);
+        return true;
     }
-
-    // Validate chunk parameters
-    const uint16_t MAX_REASONABLE_CHUNKS = 6;
-    const size_t MAX_CHUNK_DATA_SIZE = 50;
-
-    if (totalChunks == 0 || totalChunks > MAX_REASONABLE_CHUNKS)
+    if (dataLen > CHUNK_DATA_STRIDE)
     {
-        FURI_LOG_E("FlipWorldRun", "Invalid totalChunks: %d (max: %d)", totalChunks, MAX_REASONABLE_CHUNKS);
-        free(dataStr);
+        FURI_LOG_E("FlipWorldRun", "Chunk data too large: %zu bytes (max: %d)", dataLen, CHUNK_DATA_STRIDE);
         return true;
     }
 
     // Clean up expired messages first
     cleanupExpiredChunkedMessages();
 
-    // Find existing chunked message or create new one
+    // Find the slot already reassembling this message, or take a free one from the pool
     ChunkedMessage *chunkedMsg = nullptr;
+    ChunkedMessage *freeSlot = nullptr;
     for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
     {
-        if (chunkedMessages[i].id == messageId && chunkedMessages[i].data)
+        if (chunkedMessages[i].active && chunkedMessages[i].id == messageId)
         {
             chunkedMsg = &chunkedMessages[i];
             break;
         }
-    }
-
-    // If not found, create new one
-    if (!chunkedMsg)
-    {
-        // Check total memory usage before creating new chunked message
-        size_t totalMemoryUsed = 0;
-        for (size_t j = 0; j < MAX_CHUNKED_MESSAGES; j++)
-        {
-            if (chunkedMessages[j].data)
-            {
-                totalMemoryUsed += chunkedMessages[j].dataCapacity;
-            }
-        }
-
-        const size_t MAX_TOTAL_CHUNK_MEMORY = 6144;
-        size_t estimatedNewSize = totalChunks * MAX_CHUNK_DATA_SIZE;
-
-        if (totalMemoryUsed + estimatedNewSize > MAX_TOTAL_CHUNK_MEMORY)
-        {
-            FURI_LOG_E("FlipWorldRun", "Would exceed total chunk memory limit (%zu + %zu > %zu)",
-                       totalMemoryUsed, estimatedNewSize, MAX_TOTAL_CHUNK_MEMORY);
-            free(dataStr);
-            return true;
-        }
-
-        for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
+        if (!chunkedMessages[i].active && !freeSlot)
         {
-            if (!chunkedMessages[i].data)
-            {
-                chunkedMsg = &chunkedMessages[i];
-                chunkedMsg->id = messageId;
-                chunkedMsg->totalChunks = totalChunks;
-                chunkedMsg->receivedChunks = 0;
-                chunkedMsg->dataSize = 0;
-                chunkedMsg->dataCapacity = (totalChunks * MAX_CHUNK_DATA_SIZE < 512) ? 512 : totalChunks * MAX_CHUNK_DATA_SIZE;
-                chunkedMsg->data = (char *)malloc(chunkedMsg->dataCapacity);
-                if (!chunkedMsg->data)
-                {
-                    FURI_LOG_E("FlipWorldRun", "Failed to allocate chunked message buffer");
-                    free(dataStr);
-                    return true;
-                }
-                chunkedMsg->data[0] = '\0';
-                chunkedMessageCount++;
-                break;
-            }
+            freeSlot = &chunkedMessages[i];
         }
     }
 
     if (!chunkedMsg)
     {
-        FURI_LOG_E("FlipWorldRun", "No available slots for chunked message");
-        free(dataStr);
-        return true;
-    }
-
-    // Update last update time
-    chunkedMsg->lastUpdateTime = furi_get_tick();
-
-    // Append data to the chunked message
-    if (dataLen > 120)
-    {
-        FURI_LOG_E("FlipWorldRun", "Chunk data too large: %zu bytes (max: 120)", dataLen);
-        free(dataStr);
-        return true;
-    }
-
-    // ensure we have enough heap memory for the operation
-    size_t chunkProcessHeap = memmgr_get_free_heap();
-    if (chunkProcessHeap < 8192) // Need at least 8KB free heap for safe chunk processing
-    {
-        FURI_LOG_E("FlipWorldRun", "Insufficient heap memory for chunk processing: %zu bytes free", chunkProcessHeap);
-        free(dataStr);
-        return true;
-    }
-
-    // Check if buffer expansion is needed
-    if (chunkedMsg->dataSize + dataLen >= chunkedMsg->dataCapacity)
-    {
-        const size_t MAX_MESSAGE_SIZE = 2048;
-        size_t newCapacity = chunkedMsg->dataCapacity + 512;
-
-        // Cap the maximum size to prevent runaway growth
-        if (newCapacity > MAX_MESSAGE_SIZE)
-        {
-            FURI_LOG_E("FlipWorldRun", "Message too large, would exceed %zu bytes", MAX_MESSAGE_SIZE);
-            free(dataStr);
-            return true;
-        }
-
-        // Additional safety check before realloc
-        size_t reallocHeap = memmgr_get_free_heap();
-        if (reallocHeap < newCapacity + 4096) // Need buffer capacity + 4KB safety margin
-        {
-            FURI_LOG_E("FlipWorldRun", "Insufficient heap for buffer expansion: need %zu, have %zu",
-                       newCapacity + 4096, reallocHeap);
-            free(dataStr);
-            return true;
-        }
-
-        char *newData = (char *)realloc(chunkedMsg->data, newCapacity);
-        if (!newData)
+        if (!freeSlot)
         {
-            FURI_LOG_E("FlipWorldRun", "Failed to expand chunked message buffer to %zu bytes", newCapacity);
-            free(dataStr);
+            FURI_LOG_E("FlipWorldRun", "No available slots for chunked message");
             return true;
         }
-        chunkedMsg->data = newData;
-        chunkedMsg->dataCapacity = newCapacity;
+        chunkedMsg = freeSlot;
+        chunkedMsg->active = true;
+        chunkedMsg->id = messageId;
+        chunkedMsg->totalChunks = totalChunks;
+        chunkedMsg->receivedChunks = 0;
+        chunkedMsg->receivedMask = 0;
+        chunkedMessageCount++;
     }
-
-    // Additional bounds checking before memcpy
-    if (chunkedMsg->dataSize + dataLen >= chunkedMsg->dataCapacity)
+    else if (chunkedMsg->totalChunks != totalChunks)
     {
-        FURI_LOG_E("FlipWorldRun", "Buffer overflow prevention: dataSize %zu + dataLen %zu >= capacity %zu",
-                   chunkedMsg->dataSize, dataLen, chunkedMsg->dataCapacity);
-        free(dataStr);
+        FURI_LOG_E("FlipWorldRun", "Chunk total changed for message ID %d (%d != %d), dropping chunk",
+                   messageId, totalChunks, chunkedMsg->totalChunks);
         return true;
     }
 
-    // Append the chunk data safely
-    memcpy(chunkedMsg->data + chunkedMsg->dataSize, dataStr, dataLen);
-    chunkedMsg->dataSize += dataLen;
+    // Update last update time
+    chunkedMsg->lastUpdateTime = furi_get_tick();
 
-    // Ensure we don't write past buffer end
-    if (chunkedMsg->dataSize < chunkedMsg->dataCapacity)
-    {
-        chunkedMsg->data[chunkedMsg->dataSize] = '\0'; // Null terminate
-    }
-    else
+    // A chunk we already hold is a duplicate (retransmit or echo)
+    uint8_t seqBit = (uint8_t)(1u << (seqVal - 1));
+    if (chunkedMsg->receivedMask & seqBit)
     {
-        FURI_LOG_E("FlipWorldRun", "Cannot null-terminate: dataSize %zu >= capacity %zu",
-                   chunkedMsg->dataSize, chunkedMsg->dataCapacity);
-        free(dataStr);
+        FURI_LOG_W("FlipWorldRun", "Duplicate chunk %d of message ID %d ignored", seqVal, messageId);
         return true;
     }
 
+    // Copy the chunk straight to its place; arrival order does not matter
+    memcpy(chunkedMsg->data + (seqVal - 1) * CHUNK_DATA_STRIDE, dataPos, dataLen);
+    chunkedMsg->chunkLength[seqVal - 1] = (uint8_t)dataLen;
+    chunkedMsg->receivedMask |= seqBit;
     chunkedMsg->receivedChunks++;
 
-    // Free the dataStr since we've copied it to the chunked message buffer
-    free(dataStr);
-
     // Check if we have all chunks
-    if (chunkedMsg->receivedChunks >= chunkedMsg->totalChunks)
+    if (chunkedMsg->receivedChunks == chunkedMsg->totalChunks)
     {
-        // Validate the complete message before processing
-        if (chunkedMsg->data && chunkedMsg->dataSize > 0)
+        // Close the gaps between the fixed-stride chunks (in place, moving data towards the front)
+        size_t dataSize = 0;
+        for (uint16_t i = 0; i < chunkedMsg->totalChunks; i++)
         {
-            // Ensure null termination
-            chunkedMsg->data[chunkedMsg->dataSize] = '\0';
-
-            // Basic JSON validation - must start with { and end with }
-            if (chunkedMsg->data[0] == '{' && chunkedMsg->data[chunkedMsg->dataSize - 1] == '}')
+            if (dataSize != (size_t)i * CHUNK_DATA_STRIDE)
             {
-                // Check memory before processing to prevent crashes
-                size_t freeHeap = memmgr_get_free_heap();
-                if (freeHeap > 8192) // Only process if we have at least 8KB free heap
-                {
-                    processCompleteMultiplayerMessage(chunkedMsg->data);
-                }
-                else
-                {
-                    FURI_LOG_W("FlipWorldRun", "Skipping chunked message processing due to low memory: %zu bytes free", freeHeap);
-                }
+                memmove(chunkedMsg->data + dataSize, chunkedMsg->data + i * CHUNK_DATA_STRIDE, chunkedMsg->chunkLength[i]);
             }
+            dataSize += chunkedMsg->chunkLength[i];
         }
+        chunkedMsg->data[dataSize] = '\0';
 
-        // Clean up this chunked message
-        free(chunkedMsg->data);
-        chunkedMsg->data = nullptr;
-        chunkedMsg->id = 0;
-        chunkedMsg->totalChunks = 0;
-        chunkedMsg->receivedChunks = 0;
-        chunkedMsg->dataSize = 0;
-        chunkedMsg->dataCapacity = 0;
-        chunkedMsg->lastUpdateTime = 0;
-        if (chunkedMessageCount > 0)
+        // Basic JSON validation - must start with { and end with }
+        if (dataSize > 0 && chunkedMsg->data[0] == '{' && chunkedMsg->data[dataSize - 1] == '}')
         {
-            chunkedMessageCount--;
+            // Check memory before processing to prevent crashes
+            size_t freeHeap = memmgr_get_free_heap();
+            if (freeHeap > 8192) // Only process if we have at least 8KB free heap
+            {
+                processCompleteMultiplayerMessage(chunkedMsg->data);
+            }
+            else
+            {
+                FURI_LOG_W("FlipWorldRun", "Skipping chunked message processing due to low memory: %zu bytes free", freeHeap);
+            }
         }
+
+        // Return the slot to the pool
+        releaseChunkedMessage(chunkedMsg);
     }
 
     return true;
@@ -1282,6 +1095,13 @@ void FlipWorldRun::handleIncomingMultiplayerData(const char *message)
         return;
     }
 
+    // Binary entity-state records are small enough to never be chunked
+    if (message[0] == NET_BINARY_PREFIX)
+    {
+        processBinaryMessage(message);
+        return;
+    }
+
     // Check if message is empty or too short
     if (strlen(message) < 10)
     {
@@ -1345,121 +1165,90 @@ bool FlipWorldRun::parseEntityDataFromJson(Entity *entity, const char *jsonData)
         return false;
     }
 
-    // Memory safety check before parsing
-    size_t freeHeap = memmgr_get_free_heap();
-    if (freeHeap < 4096) // Need at least 4KB free for JSON parsing
+    // Tokenize once into a stack buffer; every field below is a view into jsonData
+    jsmntok_t tokens[MAX_ENTITY_JSON_TOKENS];
+    JsonDoc doc;
+    if (!json_doc_parse(&doc, jsonData, strlen(jsonData), tokens, MAX_ENTITY_JSON_TOKENS))
+    {
+        FURI_LOG_E("FlipWorldRun", "Failed to parse entity JSON");
+        return false;
+    }
+
+    return parseEntityDataFromJson(entity, &doc, 0);
+}
+
+bool FlipWorldRun::parseEntityDataFromJson(Entity *entity, const JsonDoc *doc, int obj)
+{
+    if (!entity || !doc)
     {
-        FURI_LOG_W("FlipWorldRun", "Skipping entity JSON parsing due to low memory: %zu bytes free", freeHeap);
         return false;
     }
 
     // Parse username and verify it matches
-    char *u = get_json_value("u", jsonData);
-    if (!u)
+    JsonView u;
+    if (!json_doc_get_view(doc, obj, "u", &u))
     {
         FURI_LOG_E("FlipWorldRun", "Failed to get username from JSON");
         return false;
     }
 
     // Check if the username matches
-    if (strcmp(u, entity->name) != 0)
+    if (!json_view_eq(u, entity->name))
     {
-        FURI_LOG_E("FlipWorldRun", "Username mismatch: expected %s, got %s", entity->name, u);
-        free(u);
+        FURI_LOG_E("FlipWorldRun", "Username mismatch: expected %s, got %.*s", entity->name, u.len, u.ptr);
         return false;
     }
-    free(u);
 
     // Parse entity data
-    char *h = get_json_value("h", jsonData);
-    char *eat = get_json_value("eat", jsonData);
-    char *d = get_json_value("d", jsonData);
-    char *xp = get_json_value("xp", jsonData);
-    char *sp = get_json_value("sp", jsonData);
-    char *x = get_json_value("x", sp);
-    char *y = get_json_value("y", sp);
-
-    if (!h || !eat || !d || !sp || !x || !y || !xp)
+    // eat and sp are sent with one decimal; read them as tenths
+    int32_t h, d, s, xp, eat_tenths, x_tenths, y_tenths;
+    if (!json_doc_get_int(doc, obj, "h", &h) ||
+        !json_doc_get_fixed(doc, obj, "eat", 1, &eat_tenths) ||
+        !json_doc_get_int(doc, obj, "d", &d) ||
+        !json_doc_get_int(doc, obj, "s", &s) ||
+        !json_doc_get_int(doc, obj, "xp", &xp) ||
+        !json_doc_get_fixed(doc, obj, "sp.x", 1, &x_tenths) ||
+        !json_doc_get_fixed(doc, obj, "sp.y", 1, &y_tenths))
     {
         FURI_LOG_E("FlipWorldRun", "Failed to parse entity data fields");
-        if (h)
-            free(h);
-        if (eat)
-            free(eat);
-        if (d)
-            free(d);
-        if (sp)
-            free(sp);
-        if (x)
-            free(x);
-        if (y)
-            free(y);
-        if (xp)
-            free(xp);
         return false;
     }
-
-    // Update entity with parsed data
-    entity->health = (float)atoi(h);
-    if (entity->health <= 0)
-    {
-        entity->health = 0;
-        entity->state = ENTITY_DEAD;
-        entity->position_set((Vector){-100, -100});
-        free(h);
-        free(eat);
-        free(d);
-        free(sp);
-        free(x);
-        free(y);
-        free(xp);
-        return true;
-    }
-
-    entity->elapsed_attack_timer = atof_(eat);
-
-    switch (atoi(d))
+    if (d < NetDirectionLeft || d > NetDirectionDown || s < 0 || s > ENTITY_DEAD)
     {
-    case 0:
-        entity->direction = ENTITY_LEFT;
-        break;
-    case 1:
-        entity->direction = ENTITY_RIGHT;
-        break;
-    case 2:
-        entity->direction = ENTITY_UP;
-        break;
-    case 3:
-        entity->direction = ENTITY_DOWN;
-        break;
-    default:
-        entity->direction = ENTITY_RIGHT;
-        break;
+        FURI_LOG_E("FlipWorldRun", "Direction or state out of range: %ld, %ld", (long)d, (long)s);
+        return false;
     }
 
-    entity->xp = (atoi)(xp);
-    entity->level = 1;
-    uint32_t xp_required = 100;
-    while (entity->level < 100 && entity->xp >= xp_required)
-    {
-        entity->level++;
-        xp_required = (uint32_t)(xp_required * 1.5);
+    // Update entity with parsed data
+    NetEntityState state;
+    state.id = netEntityId(entity);
+    state.isPlayer = entity->type == ENTITY_PLAYER;
+    state.fields = NET_FIELD_ALL;
+    state.position = Vector(x_tenths * 0.1f, y_tenths * 0.1f);
+    state.direction = (uint8_t)d;
+    state.state = (uint8_t)s;
+    state.health = (float)h;
+    state.xp = xp > 0 ? (uint32_t)xp : 0;
+    state.attackElapsed = eat_tenths * 0.1f;
+    applyEntityState(entity, &state);
+
+    // a malformed update never reaches here, so it cannot mark a good one as stale
+    int32_t seq;
+    if (json_doc_get_int(doc, obj, "q", &seq) && seq >= 0 && seq <= UINT8_MAX)
+    {
+        entity->net_seq = (uint8_t)seq;
     }
-
-    // Set position
-    entity->position_set(Vector(atof_(x), atof_(y)));
-
-    // Free the strings
-    free(h);
-    free(eat);
-    free(d);
-    free(sp);
-    free(x);
-    free(y);
-    free(xp);
     return true;
 }
 
+void FlipWorldRun::onWebsocketSent(FlipWorldApp *app, size_t bytes)
+{
+    // the send returns as soon as the bytes are queued; the worker's write time is what the UART estimate needs
+    uint32_t busyMs = app->uartTxBusyMs();
+    netLinkOnSent(&link, bytes, busyMs - lastTxBusyMs);
+    lastTxBusyMs = busyMs;
+}
+
 void FlipWorldRun::processCompleteMultiplayerMessage(const char *message)
 {
     if (!engine || !engine->getGame() || !engine->getGame()->current_level)
@@ -1492,9 +1281,18 @@ void FlipWorldRun::processCompleteMultiplayerMessage(const char *message)
 
     auto currentLevel = engine->getGame()->current_level;
 
+    // Tokenize once; type, data and the entity fields are all views into the message
+    jsmntok_t tokens[MAX_MESSAGE_JSON_TOKENS];
+    JsonDoc doc;
+    if (!json_doc_parse(&doc, message, strlen(message), tokens, MAX_MESSAGE_JSON_TOKENS))
+    {
+        FURI_LOG_E("FlipWorldRun", "Failed to parse multiplayer message: %.100s", message);
+        return;
+    }
+
     // Parse message type (we already validated it exists in processMultiplayerUpdate)
-    char *messageType = get_json_value("type", message);
-    if (!messageType)
+    JsonView messageType;
+    if (!json_doc_get_view(&doc, 0, "type", &messageType))
     {
         FURI_LOG_E("FlipWorldRun", "No 'type' field in message - may be malformed JSON");
         FURI_LOG_E("FlipWorldRun", "Message content: %.200s%s", message, strlen(message) > 200 ? "..." : "");
@@ -1502,142 +1300,195 @@ void FlipWorldRun::processCompleteMultiplayerMessage(const char *message)
     }
 
     // Additional validation for message type
-    if (strlen(messageType) == 0 || strlen(messageType) > 20 ||
-        strstr(messageType, "\"") != NULL || strstr(messageType, "}") != NULL)
+    if (messageType.len == 0 || messageType.len > 20 ||
+        memchr(messageType.ptr, '"', messageType.len) != NULL || memchr(messageType.ptr, '}', messageType.len) != NULL)
     {
-        FURI_LOG_E("FlipWorldRun", "Invalid message type: '%s'", messageType);
-        free(messageType);
+        FURI_LOG_E("FlipWorldRun", "Invalid message type: '%.*s'", messageType.len, messageType.ptr);
         return;
     }
 
-    if (strcmp(messageType, "player") == 0)
+    if (json_view_eq(messageType, "player"))
     {
         // Handle player update
-        char *playerData = get_json_value("data", message);
-        if (playerData)
+        const int playerData = json_doc_find(&doc, 0, "data");
+        JsonView usernameView;
+        if (playerData >= 0 && json_doc_get_view(&doc, playerData, "u", &usernameView))
         {
-
-            // Find the player entity by username
-            char *username = get_json_value("u", playerData);
-            if (username)
+            // Validate username before processing - reject invalid/malformed usernames
+            char username[64];
+            if (usernameView.len == 0 || usernameView.len > 50)
+            {
+                FURI_LOG_W("FlipWorldRun", "Rejecting invalid username (len: %d)", usernameView.len);
+                return;
+            }
+            json_view_copy(usernameView, username, sizeof(username));
+            if (strstr(username, "\"") != NULL || strstr(username, "}") != NULL ||
+                strstr(username, "{") != NULL || strstr(username, "total") != NULL ||
+                strstr(username, "data") != NULL || strstr(username, "seq") != NULL ||
+                strstr(username, "Rend") != NULL || strstr(username, ",") != NULL ||
+                strstr(username, ":") != NULL || strstr(username, "[") != NULL ||
+                strstr(username, "]") != NULL || username[0] == ' ' ||
+                username[strlen(username) - 1] == ' ' || isdigit(username[0]) ||
+                strlen(username) < 3 || // Require at least 3 characters for valid username
+                strstr(username, "type") != NULL || strstr(username, "player") != NULL ||
+                strstr(username, "chunk") != NULL || strstr(username, "id") != NULL)
             {
+                FURI_LOG_W("FlipWorldRun", "Rejecting invalid username: '%s' (len: %zu)", username, strlen(username));
+                return;
+            }
 
-                // Validate username before processing - reject invalid/malformed usernames
-                if (strlen(username) == 0 || strlen(username) > 50 ||
-                    strstr(username, "\"") != NULL || strstr(username, "}") != NULL ||
-                    strstr(username, "{") != NULL || strstr(username, "total") != NULL ||
-                    strstr(username, "data") != NULL || strstr(username, "seq") != NULL ||
-                    strstr(username, "Rend") != NULL || strstr(username, ",") != NULL ||
-                    strstr(username, ":") != NULL || strstr(username, "[") != NULL ||
-                    strstr(username, "]") != NULL || username[0] == ' ' ||
-                    username[strlen(username) - 1] == ' ' || isdigit(username[0]) ||
-                    strlen(username) < 3 || // Require at least 3 characters for valid username
-                    strstr(username, "type") != NULL || strstr(username, "player") != NULL ||
-                    strstr(username, "chunk") != NULL || strstr(username, "id") != NULL)
-                {
-                    FURI_LOG_W("FlipWorldRun", "Rejecting invalid username: '%s' (len: %zu)", username, strlen(username));
-                    free(username);
-                    free(playerData);
-                    free(messageType);
-                    return;
-                }
+            // Don't update self
+            if (strcmp(username, player->name) == 0 && strcmp(username, "Player") != 0)
+            {
+                return;
+            }
 
-                // Don't update self
-                if (strcmp(username, player->name) == 0 && strcmp(username, "Player") != 0)
-                {
-                    free(username);
-                    free(playerData);
-                    free(messageType);
-                    return;
-                }
+            // Look the player up by id, adding them as a remote player if they are new
+            Entity *playerEntity = addRemotePlayer(username);
 
-                Entity *playerEntity = nullptr;
-                for (int i = 0; i < currentLevel->getEntityCount(); i++)
-                {
-                    Entity *entity = currentLevel->getEntity(i);
-                    if (entity && entity->type == ENTITY_PLAYER &&
-                        strcmp(entity->name, username) == 0)
-                    {
-                        playerEntity = entity;
-                        break;
-                    }
-                }
+            // Update the player entity with received data (in lockstep every device simulates it instead)
+            if (playerEntity && !lockstep.active && !dropStaleUpdate(playerEntity, &doc, playerData))
+            {
+                parseEntityDataFromJson(playerEntity, &doc, playerData);
+            }
+        }
+    }
+    else if (json_view_eq(messageType, "enemy") && !isLobbyHost && !lockstep.active)
+    {
+        // Followers receive enemy updates from host
+        const int enemyData = json_doc_find(&doc, 0, "data");
+        int32_t netId;
+        if (enemyData >= 0 && json_doc_get_int(&doc, enemyData, "n", &netId) && netId > 0 && netId <= UINT16_MAX)
+        {
+            // Enemies share names, so they are addressed by the id the level gave them at spawn
+            Entity *entity = currentLevel->entity_find((uint16_t)netId);
+            if (entity && entity->type == ENTITY_ENEMY && !dropStaleUpdate(entity, &doc, enemyData))
+            {
+                parseEntityDataFromJson(entity, &doc, enemyData);
+            }
+        }
+    }
+    else if (json_view_eq(messageType, "join") && isLobbyHost)
+    {
+        // A follower joined: add them right away and stream them the world on the next update
+        JsonView joinUser;
+        if (player && player->name && json_doc_get_view(&doc, 0, "u", &joinUser) && !json_view_eq(joinUser, player->name))
+        {
+            char username[64];
+            json_view_copy(joinUser, username, sizeof(username));
+            addRemotePlayer(username);
+            snapshotPending = true;
+        }
+    }
+    else if (json_view_eq(messageType, "snapshot") && !isLobbyHost)
+    {
+        // The host's world snapshot: its level first, then keyframes and full records follow in order
+        int32_t levelIndex;
+        if (json_doc_get_int(&doc, 0, "l", &levelIndex))
+        {
+            switchToLevel(levelIndex);
+            snapshotReceived = true;
+        }
+    }
+    else if (json_view_eq(messageType, "ping") || json_view_eq(messageType, "pong"))
+    {
+        // Round-trip probes: echo other players' pings, time the echo of our own
+        JsonView probeUser;
+        int32_t stamp;
+        if (!player || !player->name || !json_doc_get_view(&doc, 0, "u", &probeUser) || !json_doc_get_int(&doc, 0, "t", &stamp))
+        {
+            return;
+        }
+        bool own = json_view_eq(probeUser, player->name);
+        if (json_view_eq(messageType, "ping") && !own)
+        {
+            FlipWorldApp *app = static_cast<FlipWorldApp *>(appContext);
+            char username[64];
+            json_view_copy(probeUser, username, sizeof(username));
+            sendLinkProbe(app, "pong", username, (uint32_t)stamp);
+        }
+        else if (json_view_eq(messageType, "pong") && own)
+        {
+            netLinkOnPong(&link, (uint32_t)stamp, furi_get_tick());
+        }
+    }
+    else if (json_view_eq(messageType, "level") && !isLobbyHost)
+    {
+        // Followers receive level change commands from host
+        int32_t newLevelIndex;
+        if (json_doc_get_int(&doc, 0, "level_index", &newLevelIndex))
+        {
+            switchToLevel(newLevelIndex);
+        }
+    }
+}
 
-                // If player doesn't exist, add them as a remote player
-                if (!playerEntity)
-                {
-                    if (addRemotePlayer(username))
-                    {
-                        // Try to find the newly added player
-                        for (int i = 0; i < currentLevel->getEntityCount(); i++)
-                        {
-                            Entity *entity = currentLevel->getEntity(i);
-                            if (entity && entity->type == ENTITY_PLAYER &&
-                                strcmp(entity->name, username) == 0)
-                            {
-                                playerEntity = entity;
-                                break;
-                            }
-                        }
-                    }
-                }
+void FlipWorldRun::processBinaryMessage(const char *message)
+{
+    if (!engine || !engine->getGame() || !engine->getGame()->current_level)
+    {
+        return;
+    }
 
-                // Update the player entity with received data
-                if (playerEntity)
-                {
-                    parseEntityDataFromJson(playerEntity, playerData);
-                }
+    uint8_t records[NET_BATCH_MAX_BYTES];
+    size_t len = netRecordFromText(message, strlen(message), records, sizeof(records));
+    if (len == 0)
+    {
+        FURI_LOG_E("FlipWorldRun", "Invalid binary state message: %.32s", message);
+        return;
+    }
 
-                free(username);
+    // walk the batch record by record; a malformed record ends it
+    size_t pos = 0;
+    while (pos < len)
+    {
+        size_t size = netRecordSize(records + pos, len - pos);
+        if (size == 0)
+        {
+            FURI_LOG_E("FlipWorldRun", "Malformed record at offset %zu of %zu", pos, len);
+            return;
+        }
+        if (records[pos] == NET_LEVEL_VERSION)
+        {
+            // Followers receive level change commands from host
+            if (!isLobbyHost)
+            {
+                switchToLevel(records[pos + 1]);
             }
-            free(playerData);
         }
-    }
-    else if (strcmp(messageType, "enemy") == 0 && !isLobbyHost)
-    {
-        // Followers receive enemy updates from host
-        char *enemyData = get_json_value("data", message);
-        if (enemyData)
+        else if (records[pos] == NET_INPUT_VERSION)
         {
-            char *enemyName = get_json_value("u", enemyData);
-            if (enemyName)
+            NetInputBatch batch;
+            if (netInputBatchDecode(records + pos, size, &batch))
             {
-                for (int i = 0; i < currentLevel->getEntityCount(); i++)
-                {
-                    Entity *entity = currentLevel->getEntity(i);
-                    if (entity && entity->type == ENTITY_ENEMY &&
-                        strcmp(entity->name, enemyName) == 0)
-                    {
-                        // Update the enemy entity with received data
-                        parseEntityDataFromJson(entity, enemyData);
-                        break;
-                    }
-                }
-                free(enemyName);
+                netLockstepOnInputs(&lockstep, batch.playerId, batch.session, batch.firstTick, batch.inputs, batch.count);
             }
-            free(enemyData);
         }
-    }
-    else if (strcmp(messageType, "level") == 0 && !isLobbyHost)
-    {
-        // Followers receive level change commands from host
-        char *levelIndex = get_json_value("level_index", message);
-        if (levelIndex)
+        else if (records[pos] == NET_CHECKSUM_VERSION)
         {
-            int newLevelIndex = atoi(levelIndex);
-            if (newLevelIndex >= 0 && newLevelIndex < 3 && getCurrentLevelIndex() != newLevelIndex) // Valid level indices
+            NetChecksum checksum;
+            if (netChecksumDecode(records + pos, size, &checksum) &&
+                !netLockstepOnPeerChecksum(&lockstep, checksum.session, checksum.tick, checksum.value))
             {
-                if (engine && engine->getGame())
-                {
-                    engine->getGame()->level_switch(newLevelIndex);
-                    setIconGroup(static_cast<LevelIndex>(newLevelIndex));
-                }
+                FURI_LOG_W("FlipWorldRun", "Lockstep desync with player %04x at tick %u", checksum.playerId, checksum.tick);
+                stopLockstep();
+            }
+        }
+        else if (records[pos] == NET_ROSTER_VERSION)
+        {
+            // The host started a session; a follower that cannot join it asks for the world again
+            NetRoster roster;
+            if (!isLobbyHost && netRosterDecode(records + pos, size, &roster) && !startLockstep(&roster))
+            {
+                snapshotReceived = false;
             }
-            free(levelIndex);
         }
+        else if (!lockstep.active)
+        {
+            applyEntityRecord(records + pos, size);
+        }
+        pos += size;
     }
-
-    free(messageType);
 }
 
 void FlipWorldRun::processMultiplayerUpdate()
@@ -1683,18 +1534,11 @@ void FlipWorldRun::processMultiplayerUpdate()
             // Clear ALL chunked messages immediately
             for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
             {
-                if (chunkedMessages[i].data)
+                if (chunkedMessages[i].active)
                 {
-                    FURI_LOG_W("FlipWorldRun", "Emergency clearing chunked message ID %d (%zu bytes)",
-                               chunkedMessages[i].id, chunkedMessages[i].dataCapacity);
-                    free(chunkedMessages[i].data);
-                    chunkedMessages[i].data = nullptr;
-                    chunkedMessages[i].id = 0;
-                    chunkedMessages[i].totalChunks = 0;
-                    chunkedMessages[i].receivedChunks = 0;
-                    chunkedMessages[i].dataSize = 0;
-                    chunkedMessages[i].dataCapacity = 0;
-                    chunkedMessages[i].lastUpdateTime = 0;
+                    FURI_LOG_W("FlipWorldRun", "Emergency clearing chunked message ID %d (%d/%d chunks)",
+                               chunkedMessages[i].id, chunkedMessages[i].receivedChunks, chunkedMessages[i].totalChunks);
+                    releaseChunkedMessage(&chunkedMessages[i]);
                 }
             }
             chunkedMessageCount = 0;
@@ -1702,15 +1546,7 @@ void FlipWorldRun::processMultiplayerUpdate()
             // Clear most of the message queue, keep only the most recent 5 messages
             while (queueSize > 5)
             {
-                QueuedMessage *oldMsg = &messageQueue[queueHead];
-                if (oldMsg->message)
-                {
-                    free(oldMsg->message);
-                    oldMsg->message = nullptr;
-                    oldMsg->messageLen = 0;
-                }
-                queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-                queueSize--;
+                dropQueuedMessage();
             }
 
             FURI_LOG_I("FlipWorldRun", "Emergency cleanup complete, free heap now: %zu", memmgr_get_free_heap());
@@ -1722,7 +1558,7 @@ void FlipWorldRun::processMultiplayerUpdate()
             // Force cleanup of all but the most recent chunked messages
             for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
             {
-                if (chunkedMessages[i].data && chunkedMessageCount > 2) // Keep only 2 most recent
+                if (chunkedMessages[i].active && chunkedMessageCount > 2) // Keep only 2 most recent
                 {
                     // Find oldest message to clean
                     uint32_t oldestTime = currentTime;
@@ -1730,7 +1566,7 @@ void FlipWorldRun::processMultiplayerUpdate()
 
                     for (size_t j = 0; j < MAX_CHUNKED_MESSAGES; j++)
                     {
-                        if (chunkedMessages[j].data && chunkedMessages[j].lastUpdateTime < oldestTime)
+                        if (chunkedMessages[j].active && chunkedMessages[j].lastUpdateTime < oldestTime)
                         {
                             oldestTime = chunkedMessages[j].lastUpdateTime;
                             oldestIndex = j;
@@ -1741,18 +1577,7 @@ void FlipWorldRun::processMultiplayerUpdate()
                     {
                         FURI_LOG_W("FlipWorldRun", "Emergency cleanup of chunked message ID %d",
                                    chunkedMessages[oldestIndex].id);
-                        free(chunkedMessages[oldestIndex].data);
-                        chunkedMessages[oldestIndex].data = nullptr;
-                        chunkedMessages[oldestIndex].id = 0;
-                        chunkedMessages[oldestIndex].totalChunks = 0;
-                        chunkedMessages[oldestIndex].receivedChunks = 0;
-                        chunkedMessages[oldestIndex].dataSize = 0;
-                        chunkedMessages[oldestIndex].dataCapacity = 0;
-                        chunkedMessages[oldestIndex].lastUpdateTime = 0;
-                        if (chunkedMessageCount > 0)
-                        {
-                            chunkedMessageCount--;
-                        }
+                        releaseChunkedMessage(&chunkedMessages[oldestIndex]);
                     }
                 }
             }
@@ -1760,15 +1585,7 @@ void FlipWorldRun::processMultiplayerUpdate()
             // trim the queue if it's large
             while (queueSize > MAX_QUEUED_MESSAGES * 0.7)
             {
-                QueuedMessage *oldMsg = &messageQueue[queueHead];
-                if (oldMsg->message)
-                {
-                    free(oldMsg->message);
-                    oldMsg->message = nullptr;
-                    oldMsg->messageLen = 0;
-                }
-                queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-                queueSize--;
+                dropQueuedMessage();
             }
         }
     }
@@ -1787,58 +1604,43 @@ void FlipWorldRun::processMultiplayerUpdate()
             // Trim queue if it's getting large
             while (queueSize > MAX_QUEUED_MESSAGES * 0.5) // Keep queue at 50% max
             {
-                QueuedMessage *oldMsg = &messageQueue[queueHead];
-                if (oldMsg->message)
-                {
-                    free(oldMsg->message);
-                    oldMsg->message = nullptr;
-                    oldMsg->messageLen = 0;
-                }
-                queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-                queueSize--;
+                dropQueuedMessage();
             }
 
             // Force cleanup of any chunked messages older than 2 seconds
             for (size_t i = 0; i < MAX_CHUNKED_MESSAGES; i++)
             {
-                if (chunkedMessages[i].data &&
+                if (chunkedMessages[i].active &&
                     (currentTime - chunkedMessages[i].lastUpdateTime) > 2000)
                 {
                     FURI_LOG_W("FlipWorldRun", "Preventive cleanup of chunked message ID %d", chunkedMessages[i].id);
-                    free(chunkedMessages[i].data);
-                    chunkedMessages[i].data = nullptr;
-                    chunkedMessages[i].id = 0;
-                    chunkedMessages[i].totalChunks = 0;
-                    chunkedMessages[i].receivedChunks = 0;
-                    chunkedMessages[i].dataSize = 0;
-                    chunkedMessages[i].dataCapacity = 0;
-                    chunkedMessages[i].lastUpdateTime = 0;
-                    if (chunkedMessageCount > 0)
-                    {
-                        chunkedMessageCount--;
-                    }
+                    releaseChunkedMessage(&chunkedMessages[i]);
                 }
             }
         }
     }
 
-    // Send our state to other players
+    // Run the link controller; it picks the sync interval and send pacing from measured throughput, drain and RTT
+    int players = countLevelPlayers();
+    if (netLinkUpdate(&link, queueSize, MAX_QUEUED_MESSAGES, players > 1 ? (size_t)(players - 1) : 0, currentTime))
+    {
+        FURI_LOG_D("FlipWorldRun", "Link: sync %lums pacing %lums rtt %lu/%lums uart %luB/s sent %luB/s drain %u/s queued %u/s drops %lu stale %lu%s",
+                   (unsigned long)link.syncIntervalMs, (unsigned long)link.pacingMs, (unsigned long)link.rttMs,
+                   (unsigned long)link.rttMinMs, (unsigned long)link.uartBytesPerSec, (unsigned long)link.sentBytesPerSec,
+                   link.drainPerSec, link.enqueuePerSec, (unsigned long)link.drops, (unsigned long)link.staleDrops, link.congested ? " congested" : "");
+    }
+
+    // Send our state to other players (only the heap guard overrides the controller)
     static uint32_t lastSyncAttempt = 0;
-    size_t currentMemUsage = getMemoryUsage();
     size_t freeHeap = memmgr_get_free_heap();
-
-    // Adaptive sync frequency based on memory situation
-    uint32_t adaptiveSyncInterval = syncInterval;
+    uint32_t adaptiveSyncInterval = link.syncIntervalMs;
     if (freeHeap < 12288) // If less than 12KB free heap
     {
-        adaptiveSyncInterval = syncInterval * 4; //  reduce sync frequency
-    }
-    else if (currentMemUsage > 12288 || queueSize > MAX_QUEUED_MESSAGES * 0.6) // If high memory usage or large queue
-    {
-        adaptiveSyncInterval = syncInterval * 2; // Double the sync interval
+        adaptiveSyncInterval = link.syncIntervalMs * 4; //  reduce sync frequency
     }
 
-    if (currentTime - lastSyncAttempt >= adaptiveSyncInterval)
+    // In lockstep only inputs travel; the state sync resumes when the session ends
+    if (!lockstep.active && currentTime - lastSyncAttempt >= adaptiveSyncInterval)
     {
         syncMultiplayerState();
         lastSyncAttempt = currentTime;
@@ -1848,23 +1650,57 @@ void FlipWorldRun::processMultiplayerUpdate()
     FlipWorldApp *app = static_cast<FlipWorldApp *>(appContext);
     if (app)
     {
-        const char *incomingMessage = app->getLastResponse();
-        if (incomingMessage && strlen(incomingMessage) > 0)
+        // Probe the round-trip time; any peer echoes the stamp back
+        if (netLinkPingDue(&link, currentTime) && player && player->name)
+        {
+            netLinkOnPing(&link, currentTime);
+            sendLinkProbe(app, "ping", player->name, link.pingTick);
+        }
+
+        // Late join: followers ask for the world until it arrives; the host streams it once per burst of requests
+        if (!isLobbyHost && !snapshotReceived && currentTime - lastJoinRequestTime >= JOIN_RETRY_MS)
+        {
+            sendJoinRequest(app);
+            lastJoinRequestTime = currentTime;
+        }
+        if (isLobbyHost && lockstepEndedAt != 0 && currentTime - lockstepEndedAt >= LOCKSTEP_RESTART_MS)
+        {
+            lockstepEndedAt = 0;
+            snapshotPending = true;
+        }
+        if (isLobbyHost && snapshotPending && sendWorldSnapshot(app))
+        {
+            snapshotPending = false;
+        }
+
+        // Drain the lines the UART worker queued since the last update, so none are overwritten between ticks
+        char incomingMessage[WS_LINE_MAX];
+        for (uint8_t processed = 0; processed < MAX_INCOMING_PER_UPDATE; processed++)
         {
+            size_t incomingLength = app->websocketReadLine(incomingMessage, sizeof(incomingMessage));
+            if (incomingLength == 0)
+            {
+                break;
+            }
+
             // Skip processing if we're under severe memory pressure
             size_t freeHeap = memmgr_get_free_heap();
             if (freeHeap < 6144)
             {
                 FURI_LOG_W("FlipWorldRun", "Skipping message processing due to low memory: %zu bytes free", freeHeap);
-                app->clearLastResponse(); // Still clear to prevent buildup
-                return;
+                continue; // still consume the line to prevent buildup
             }
 
             // Only process messages that look like websocket messages (have "type" field or chunk metadata)
             bool isWebsocketMessage = false;
 
+            // binary entity-state record
+            if (incomingMessage[0] == NET_BINARY_PREFIX)
+            {
+                isWebsocketMessage = true;
+            }
             //  check for proper JSON structure
-            if (incomingMessage[0] == '{' && incomingMessage[strlen(incomingMessage) - 1] == '}')
+            else if (incomingMessage[0] == '{' && incomingMessage[incomingLength - 1] == '}')
             {
                 // Check for chunked message first (has id, seq, total at top level)
                 if (strstr(incomingMessage, "\"id\"") != NULL &&
@@ -1891,8 +1727,19 @@ void FlipWorldRun::processMultiplayerUpdate()
             {
                 handleIncomingMultiplayerData(incomingMessage);
             }
+        }
+
+        // Smooth remote entities between network updates
+        if (!lockstep.active)
+        {
+            updateRemoteMotion();
+        }
 
-            app->clearLastResponse(); // Clear after processing
+        uint32_t droppedLines = app->websocketDroppedLines();
+        if (droppedLines != lastDroppedLines)
+        {
+            FURI_LOG_W("FlipWorldRun", "Incoming websocket ring overflowed: %lu lines dropped", (unsigned long)droppedLines);
+            lastDroppedLines = droppedLines;
         }
     }
 }
@@ -1906,39 +1753,35 @@ void FlipWorldRun::processWebsocketQueue(FlipWorldApp *app)
 
     uint32_t currentTime = furi_get_tick();
 
-    // throttling based on memory pressure
-    size_t memUsage = getMemoryUsage();
-    uint32_t throttleDelay = 300; // Base delay of 300ms
-
-    if (memUsage > 12288) // If using more than 12KB
-    {
-        throttleDelay = 500; // Slow down to 500ms when memory pressure detected
-    }
-    if (queueSize > 35) // If queue is very large
+    // Check if enough time has passed since last send (pacing is chosen by the link controller)
+    if (lastWebsocketSendTime != 0 && (currentTime - lastWebsocketSendTime < link.pacingMs))
     {
-        throttleDelay = 400; // Moderate slowdown for large queue
+        return; // Not enough time has passed
     }
 
-    // Check if enough time has passed since last send
-    if (lastWebsocketSendTime != 0 && (currentTime - lastWebsocketSendTime < throttleDelay))
+    // Sends only queue bytes for the UART; while it is still writing older ones, keep the message here
+    if (app->websocketTxPending() > MAX_TX_BACKLOG)
     {
-        return; // Not enough time has passed
+        return;
     }
 
-    // Send the next message in the queue
+    // Send the next message in the queue, then release its slot
     QueuedMessage *msg = &messageQueue[queueHead];
-    if (msg->message)
+    FlipperHTTPTxStatus status = app->websocketSendAsync(msg->message);
+    if (status == FlipperHTTPTxFull)
     {
-        app->websocketSend(msg->message);
-        lastWebsocketSendTime = currentTime;
-
-        // Clean up and advance queue
-        free(msg->message);
-        msg->message = nullptr;
-        msg->messageLen = 0;
-        queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-        queueSize--;
+        return; // no room in the UART stream yet; the message keeps its slot
+    }
+    if (status == FlipperHTTPTxQueued)
+    {
+        onWebsocketSent(app, msg->messageLen + 1); // +1 for the line terminator
+    }
+    else
+    {
+        netLinkOnDropped(&link); // never sendable
     }
+    lastWebsocketSendTime = currentTime;
+    dropQueuedMessage();
 }
 
 void FlipWorldRun::processWebsocketMessageQueue()
@@ -1953,19 +1796,59 @@ void FlipWorldRun::processWebsocketMessageQueue()
         // clear everything if app fails (very very unlikely)
         while (queueSize > 0)
         {
-            QueuedMessage *msg = &messageQueue[queueHead];
-            if (msg->message)
-            {
-                free(msg->message);
-                msg->message = nullptr;
-                msg->messageLen = 0;
-            }
-            queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-            queueSize--;
+            dropQueuedMessage();
         }
     }
 }
 
+void FlipWorldRun::pushRemoteMotion(Entity *entity, Vector position, uint8_t fields)
+{
+    uint32_t now = furi_get_tick();
+    RemoteMotion *slot = nullptr;
+    RemoteMotion *freeSlot = nullptr;
+    RemoteMotion *oldestSlot = &remoteMotions[0];
+    for (size_t i = 0; i < MAX_REMOTE_MOTIONS; i++)
+    {
+        RemoteMotion *candidate = &remoteMotions[i];
+        if (candidate->entity == entity)
+        {
+            slot = candidate;
+            break;
+        }
+        if (!candidate->entity && !freeSlot)
+        {
+            freeSlot = candidate;
+        }
+        else if (candidate->entity && now - candidate->motion.targetTick > now - oldestSlot->motion.targetTick)
+        {
+            oldestSlot = candidate; // least recently updated entity is evicted when the table is full
+        }
+    }
+
+    if (slot)
+    {
+        // a delta may carry one axis only; the other continues from the last received target
+        Vector target = slot->motion.target;
+        if (fields & NET_FIELD_X)
+            target.x = position.x;
+        if (fields & NET_FIELD_Y)
+            target.y = position.y;
+        netMotionPush(&slot->motion, entity->position, target, now);
+        return;
+    }
+
+    // first update for this entity: start exactly where the host says it is
+    slot = freeSlot ? freeSlot : oldestSlot;
+    Vector target = entity->position;
+    if (fields & NET_FIELD_X)
+        target.x = position.x;
+    if (fields & NET_FIELD_Y)
+        target.y = position.y;
+    slot->entity = entity;
+    netMotionReset(&slot->motion, target, now);
+    entity->position_set(target);
+}
+
 void FlipWorldRun::pveRender(Entity *entity, Draw *canvas, Game *game)
 {
     // Safety check for entity and name
@@ -2010,15 +1893,8 @@ bool FlipWorldRun::queueWebsocketMessage(const char *message)
                        queueSize, MAX_QUEUED_MESSAGES);
 
             // Drop the oldest message
-            QueuedMessage *oldMsg = &messageQueue[queueHead];
-            if (oldMsg->message)
-            {
-                free(oldMsg->message);
-                oldMsg->message = nullptr;
-                oldMsg->messageLen = 0;
-            }
-            queueHead = (queueHead + 1) % MAX_QUEUED_MESSAGES;
-            queueSize--;
+            dropQueuedMessage();
+            netLinkOnDropped(&link);
         }
     }
 
@@ -2026,35 +1902,27 @@ bool FlipWorldRun::queueWebsocketMessage(const char *message)
     {
         FURI_LOG_W("FlipWorldRun", "Message queue full (%zu/%zu), dropping message to prevent memory leak: %.50s...",
                    queueSize, MAX_QUEUED_MESSAGES, message);
+        netLinkOnDropped(&link);
         return false;
     }
 
-    // Check total memory usage before allocating
-    size_t currentMemoryUsage = getMemoryUsage();
+    // Every message must fit in one preallocated slot (one transport frame)
     size_t messageLen = strlen(message);
-    const size_t MAX_TOTAL_MEMORY = 12288;
-
-    if (currentMemoryUsage + messageLen + 1 > MAX_TOTAL_MEMORY)
-    {
-        FURI_LOG_E("FlipWorldRun", "Would exceed total memory limit (%zu + %zu > %zu), dropping message",
-                   currentMemoryUsage, messageLen + 1, MAX_TOTAL_MEMORY);
-        return false;
-    }
-
-    // Allocate and copy the message
-    char *messageCopy = (char *)malloc(messageLen + 1);
-    if (!messageCopy)
+    if (messageLen > NET_MAX_FRAME_SIZE)
     {
-        FURI_LOG_E("FlipWorldRun", "Failed to allocate memory for queued message");
+        FURI_LOG_E("FlipWorldRun", "Message too large for a queue slot (%zu > %d), dropping: %.50s...",
+                   messageLen, NET_MAX_FRAME_SIZE, message);
         return false;
     }
-    strcpy(messageCopy, message);
 
-    // Add to queue
-    messageQueue[queueTail].message = messageCopy;
-    messageQueue[queueTail].messageLen = messageLen;
+    // Copy into the slot at the tail
+    QueuedMessage *slot = &messageQueue[queueTail];
+    memcpy(slot->message, message, messageLen + 1);
+    slot->messageLen = messageLen;
+    queuedBytes += messageLen + 1;
     queueTail = (queueTail + 1) % MAX_QUEUED_MESSAGES;
     queueSize++;
+    netLinkOnQueued(&link);
 
     // Log warning if queue is getting large
     if (queueSize > MAX_QUEUED_MESSAGES * 0.6 && queueSize % 5 == 0) // Warn at 60% and only every 5th message
@@ -2066,6 +1934,32 @@ bool FlipWorldRun::queueWebsocketMessage(const char *message)
     return true;
 }
 
+void FlipWorldRun::releaseChunkedMessage(ChunkedMessage *chunkedMsg)
+{
+    if (chunkedMsg->active && chunkedMessageCount > 0)
+    {
+        chunkedMessageCount--;
+    }
+    chunkedMsg->active = false;
+    chunkedMsg->id = 0;
+    chunkedMsg->totalChunks = 0;
+    chunkedMsg->receivedChunks = 0;
+    chunkedMsg->receivedMask = 0;
+    chunkedMsg->lastUpdateTime = 0;
+    chunkedMsg->data[0] = '\0';
+}
+
+void FlipWorldRun::releaseRemoteMotion(Entity *entity)
+{
+    for (size_t i = 0; i < MAX_REMOTE_MOTIONS; i++)
+    {
+        if (!entity || remoteMotions[i].entity == entity)
+        {
+            remoteMotions[i].entity = nullptr;
+        }
+    }
+}
+
 bool FlipWorldRun::removeRemotePlayer(const char *username)
 {
     // Only remove remote players in PvE mode
@@ -2094,6 +1988,8 @@ bool FlipWorldRun::removeRemotePlayer(const char *username)
                 continue;
             }
 
+            releaseRemoteMotion(entity);
+
             // Free the allocated username memory before removing the entity
             if (entity->name)
             {
@@ -2121,26 +2017,266 @@ bool FlipWorldRun::safeWebsocketSend(FlipWorldApp *app, const char *message)
     return queueWebsocketMessage(message);
 }
 
-void FlipWorldRun::sendMessageWithChunking(FlipWorldApp *app, const char *message)
+bool FlipWorldRun::sendEntityKeyframe(FlipWorldApp *app, Entity *entity)
 {
-    if (!app || !message)
+    if (!app || !entity || (entity->type != ENTITY_PLAYER && entity->type != ENTITY_ENEMY))
+    {
+        return false;
+    }
+
+    // Create message with type and data; a keyframe is numbered in the same sequence as the entity's records.
+    // Only the entity's owner numbers its updates: a relayed copy (join snapshot) keeps the last number applied
+    // The number only sticks once the keyframe is queued, so a failed send leaves no gap behind it
+    const bool owned = entity == player.get() || (entity->type == ENTITY_ENEMY && isLobbyHost);
+    const uint8_t previousSeq = entity->net_seq;
+    if (owned)
+    {
+        entity->net_seq = netSeqNext(previousSeq);
+    }
+    char message[MAX_SYNC_MESSAGE_SIZE];
+    JsonWriter writer;
+    json_writer_init(&writer, message, sizeof(message));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "type");
+    json_writer_string(&writer, entity->type == ENTITY_PLAYER ? "player" : "enemy");
+    json_writer_key(&writer, "data");
+    bool built = entityToJson(entity, &writer, true); // websocket format
+    json_writer_object_end(&writer);
+    if (!built || !json_writer_finish(&writer))
+    {
+        FURI_LOG_E("FlipWorldRun", "Entity state does not fit in sync message");
+        entity->net_seq = previousSeq;
+        return false;
+    }
+
+    // Send message with chunking support; the keyframe becomes the new delta baseline
+    if (!sendMessageWithChunking(app, message))
+    {
+        entity->net_seq = previousSeq;
+        return false;
+    }
+    if (!owned)
+    {
+        return true;
+    }
+    NetEntityState state;
+    netEntityStateFromEntity(entity, &state);
+    SyncSnapshot *snapshot = getSyncSnapshot(state.id, state.isPlayer);
+    netWireStateFromEntityState(&state, &snapshot->wire);
+    snapshot->valid = true;
+    return true;
+}
+
+void FlipWorldRun::sendJoinRequest(FlipWorldApp *app)
+{
+    if (!app || !player || !player->name)
+    {
+        return;
+    }
+
+    char hello[NET_MAX_FRAME_SIZE + 1];
+    JsonWriter writer;
+    json_writer_init(&writer, hello, sizeof(hello));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "type");
+    json_writer_string(&writer, "join");
+    json_writer_key(&writer, "u");
+    json_writer_string(&writer, player->name);
+    json_writer_object_end(&writer);
+    if (json_writer_finish(&writer))
+    {
+        safeWebsocketSend(app, hello);
+    }
+}
+
+void FlipWorldRun::sendLinkProbe(FlipWorldApp *app, const char *type, const char *username, uint32_t stamp)
+{
+    if (!app)
     {
         return;
     }
 
+    // probes skip the queue so the measured time is the link's, not our own queue's
+    char probe[NET_MAX_FRAME_SIZE + 1];
+    JsonWriter writer;
+    json_writer_init(&writer, probe, sizeof(probe));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "type");
+    json_writer_string(&writer, type);
+    json_writer_key(&writer, "u");
+    json_writer_string(&writer, username);
+    json_writer_key(&writer, "t");
+    json_writer_uint(&writer, stamp & NET_LINK_STAMP_MASK);
+    json_writer_object_end(&writer);
+    if (json_writer_finish(&writer))
+    {
+        app->websocketSend(probe);
+    }
+}
+
+bool FlipWorldRun::sendLockstepRoster(FlipWorldApp *app)
+{
+    if (!app || !player || !engine || !engine->getGame() || !engine->getGame()->current_level)
+    {
+        return false;
+    }
+
+    NetRoster roster = {};
+    roster.session = ++lockstepSession;
+    roster.levelIndex = (uint8_t)getCurrentLevelIndex();
+    auto currentLevel = engine->getGame()->current_level;
+    for (int i = 0; i < currentLevel->getEntityCount() && roster.count < NET_ROSTER_MAX; i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (entity && entity->type == ENTITY_PLAYER)
+        {
+            roster.players[roster.count] = netEntityId(entity);
+            roster.xp[roster.count] = entity->xp > 0 ? (uint32_t)entity->xp : 0;
+            roster.count++;
+        }
+    }
+    if (roster.count < 2)
+    {
+        return false; // nobody to play with; the lobby runs normally until someone joins
+    }
+
+    uint8_t record[4 + NET_ROSTER_MAX * 6];
+    char text[NET_MAX_FRAME_SIZE + 1];
+    size_t len = netRosterEncode(&roster, record, sizeof(record));
+    if (len == 0 || !netRecordToText(record, len, text, sizeof(text)) || !safeWebsocketSend(app, text))
+    {
+        return false;
+    }
+    if (!startLockstep(&roster))
+    {
+        FURI_LOG_E("FlipWorldRun", "Failed to start lockstep session %u", roster.session);
+        return false;
+    }
+    return true;
+}
+
+size_t FlipWorldRun::sendStateBatches(FlipWorldApp *app, Entity *const *entities, size_t count, int levelIndex, size_t maxFrames, bool keyframe)
+{
+    // One pending record per entity that changed since its baseline
+    struct SyncCandidate
+    {
+        SyncSnapshot *snapshot; // delta baseline to update once sent
+        NetWireState wire;      // quantized current state
+        uint8_t fields;         // NET_FIELD_* mask to send
+        uint8_t priority;       // higher is packed first
+    };
+    SyncCandidate candidates[MAX_SYNC_SNAPSHOTS];
+    size_t candidateCount = 0;
+
+    for (size_t i = 0; i < count && candidateCount < MAX_SYNC_SNAPSHOTS; i++)
+    {
+        NetEntityState state;
+        SyncCandidate candidate;
+        netEntityStateFromEntity(entities[i], &state);
+        netWireStateFromEntityState(&state, &candidate.wire);
+        candidate.snapshot = getSyncSnapshot(candidate.wire.id, state.isPlayer);
+        // a keyframe sends every entity as a full record, so peers recover from lost deltas
+        candidate.fields = candidate.snapshot->valid && !keyframe ? netWireStateDiff(&candidate.wire, &candidate.snapshot->wire) : NET_FIELD_ALL;
+        if (candidate.fields == 0)
+        {
+            continue; // nothing changed, nothing to send
+        }
+        // number every update that may go out (one that misses this round only leaves a gap)
+        entities[i]->net_seq = netSeqNext(entities[i]->net_seq);
+        candidate.wire.seq = entities[i]->net_seq;
+
+        // players first, then entities peers have no baseline for, then state/health changes, then movement
+        candidate.priority = (state.isPlayer ? 8 : 0) +
+                             (candidate.fields == NET_FIELD_ALL ? 4 : 0) +
+                             ((candidate.fields & (NET_FIELD_FLAGS | NET_FIELD_HEALTH)) ? 2 : 0) +
+                             ((candidate.fields & (NET_FIELD_X | NET_FIELD_Y)) ? 1 : 0);
+
+        // insertion sort by priority (stable, so level order breaks ties)
+        size_t pos = candidateCount++;
+        while (pos > 0 && candidates[pos - 1].priority < candidate.priority)
+        {
+            candidates[pos] = candidates[pos - 1];
+            pos--;
+        }
+        candidates[pos] = candidate;
+    }
+
+    // Fill frames greedily; the level record leads the first frame so followers switch before applying entities
+    uint8_t frame[NET_BATCH_MAX_BYTES];
+    size_t frameLen = 0;
+    size_t frameStart = 0;
+    size_t framesSent = 0;
+    if (candidateCount == 0)
+    {
+        return 0; // the level rides along with entity updates
+    }
+    if (levelIndex >= 0)
+    {
+        frameLen = netLevelEncode((uint8_t)levelIndex, frame, sizeof(frame));
+    }
+
+    auto flush = [&](size_t frameEnd) -> bool
+    {
+        char text[NET_MAX_FRAME_SIZE + 1];
+        if (frameLen == 0 || !netRecordToText(frame, frameLen, text, sizeof(text)) || !safeWebsocketSend(app, text))
+        {
+            return false;
+        }
+        for (size_t j = frameStart; j < frameEnd; j++)
+        {
+            candidates[j].snapshot->wire = candidates[j].wire;
+            candidates[j].snapshot->valid = true;
+        }
+        framesSent++;
+        frameLen = 0;
+        frameStart = frameEnd;
+        return true;
+    };
+
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        uint8_t record[NET_ENTITY_STATE_SIZE];
+        size_t len = netWireStateEncodeDelta(&candidates[i].wire, candidates[i].fields, record, sizeof(record));
+        if (len == 0)
+        {
+            continue;
+        }
+        if (frameLen + len > sizeof(frame))
+        {
+            if (framesSent >= maxFrames || !flush(i) || framesSent >= maxFrames)
+            {
+                return framesSent; // the rest waits for the next sync
+            }
+        }
+        memcpy(frame + frameLen, record, len);
+        frameLen += len;
+    }
+    if (framesSent < maxFrames)
+    {
+        flush(candidateCount);
+    }
+    return framesSent;
+}
+
+bool FlipWorldRun::sendMessageWithChunking(FlipWorldApp *app, const char *message)
+{
+    if (!app || !message)
+    {
+        return false;
+    }
+
     // if this doesnt work... we definitely need another approach lol
     // i think instead we should just fix FlipperHTTP handle large websocket messages
     // and then we can just send the message as-is without chunking
     // but we made it this far sooo.. let's use it until then
 
-    const size_t MAX_WEBSOCKET_SIZE = 80;
+    const size_t MAX_WEBSOCKET_SIZE = NET_MAX_FRAME_SIZE;
     size_t messageLen = strlen(message);
 
     // If message fits within limit, send as-is with throttling
     if (messageLen <= MAX_WEBSOCKET_SIZE)
     {
-        safeWebsocketSend(app, message);
-        return;
+        return safeWebsocketSend(app, message);
     }
 
     // Generate unique message ID
@@ -2149,8 +2285,17 @@ void FlipWorldRun::sendMessageWithChunking(FlipWorldApp *app, const char *messag
 
     // Calculate metadata overhead dynamically for better accuracy
     char testHeader[64];
-    int maxHeaderLen = snprintf(testHeader, sizeof(testHeader), "{\"id\":%d,\"seq\":999,\"total\":999,\"data\":\"", messageId);
-    const size_t METADATA_OVERHEAD = maxHeaderLen + 2; // +2 for closing "}
+    JsonWriter headerWriter;
+    json_writer_init(&headerWriter, testHeader, sizeof(testHeader));
+    json_writer_object_start(&headerWriter);
+    json_writer_key(&headerWriter, "id");
+    json_writer_uint(&headerWriter, messageId);
+    json_writer_key(&headerWriter, "seq");
+    json_writer_uint(&headerWriter, 999);
+    json_writer_key(&headerWriter, "total");
+    json_writer_uint(&headerWriter, 999);
+    json_writer_key(&headerWriter, "data");
+    const size_t METADATA_OVERHEAD = json_writer_length(&headerWriter) + 3; // +3 for the quotes around data and closing }
     const size_t MAX_DATA_SIZE = MAX_WEBSOCKET_SIZE - METADATA_OVERHEAD;
 
     size_t messagePos = 0;
@@ -2161,10 +2306,10 @@ void FlipWorldRun::sendMessageWithChunking(FlipWorldApp *app, const char *messag
         size_t start;
         size_t length;
     };
-    ChunkBoundary boundaries[6];
+    ChunkBoundary boundaries[MAX_CHUNKS_PER_MESSAGE];
     size_t boundaryCount = 0;
 
-    while (messagePos < messageLen && boundaryCount < 6)
+    while (messagePos < messageLen && boundaryCount < MAX_CHUNKS_PER_MESSAGE)
     {
         size_t chunkStart = messagePos;
         size_t maxChunkSize = (messageLen - messagePos > MAX_DATA_SIZE) ? MAX_DATA_SIZE : (messageLen - messagePos);
@@ -2212,63 +2357,144 @@ void FlipWorldRun::sendMessageWithChunking(FlipWorldApp *app, const char *messag
         boundaries[boundaryCount].length = actualChunkSize;
         boundaryCount++;
 
-        messagePos += actualChunkSize;
+        messagePos += actualChunkSize;
+    }
+    if (messagePos < messageLen)
+    {
+        FURI_LOG_E("FlipWorldRun", "Message needs more than %d chunks, skipping", MAX_CHUNKS_PER_MESSAGE);
+        return false;
+    }
+
+    // Second pass: send the chunks (all or nothing approach)
+    // First, check if we have enough queue space for all chunks
+    if (queueSize + boundaryCount > MAX_QUEUED_MESSAGES)
+    {
+        FURI_LOG_E("FlipWorldRun", "Not enough queue space for %zu chunks (need %zu, have %zu free), skipping entire message",
+                   boundaryCount, boundaryCount, MAX_QUEUED_MESSAGES - queueSize);
+        return false; // Skip this entire message to avoid partial sends
+    }
+
+    // We have enough space, send all chunks (the receiver drops the message if one goes missing)
+    bool sent = true;
+    for (size_t i = 0; i < boundaryCount; i++)
+    {
+        size_t chunkStart = boundaries[i].start;
+        size_t chunkLength = boundaries[i].length;
+
+        // Build the complete chunk; data is carried verbatim (unescaped) as the receiver expects
+        char chunk[MAX_WEBSOCKET_SIZE + 1];
+        JsonWriter writer;
+        json_writer_init(&writer, chunk, sizeof(chunk));
+        json_writer_object_start(&writer);
+        json_writer_key(&writer, "id");
+        json_writer_uint(&writer, messageId);
+        json_writer_key(&writer, "seq");
+        json_writer_uint(&writer, (uint32_t)(i + 1));
+        json_writer_key(&writer, "total");
+        json_writer_uint(&writer, (uint32_t)boundaryCount);
+        json_writer_key(&writer, "data");
+        json_writer_string_verbatim(&writer, message + chunkStart, chunkLength);
+        json_writer_object_end(&writer);
+        if (!json_writer_finish(&writer))
+        {
+            FURI_LOG_E("FlipWorldRun", "Chunk %zu does not fit in %zu bytes, skipping", i + 1, MAX_WEBSOCKET_SIZE);
+            sent = false;
+            continue;
+        }
+
+        if (!safeWebsocketSend(app, chunk))
+        {
+            FURI_LOG_E("FlipWorldRun", "Unexpected failure to send/queue chunk %zu", i + 1);
+            sent = false;
+        }
     }
+    return sent;
+}
 
-    // Second pass: send the chunks (all or nothing approach)
-    // First, check if we have enough queue space for all chunks
-    if (queueSize + boundaryCount > MAX_QUEUED_MESSAGES)
+bool FlipWorldRun::sendWorldSnapshot(FlipWorldApp *app)
+{
+    if (!app || !engine || !engine->getGame() || !engine->getGame()->current_level)
     {
-        FURI_LOG_E("FlipWorldRun", "Not enough queue space for %zu chunks (need %zu, have %zu free), skipping entire message",
-                   boundaryCount, boundaryCount, MAX_QUEUED_MESSAGES - queueSize);
-        return; // Skip this entire message to avoid partial sends
+        return false;
     }
 
-    // Check if memory pressure would prevent queueing all chunks
-    size_t currentMemoryUsage = getMemoryUsage();
-    size_t estimatedChunkMemory = boundaryCount * 60;
-    const size_t MAX_TOTAL_MEMORY = 12288;
-
-    if (currentMemoryUsage + estimatedChunkMemory > MAX_TOTAL_MEMORY)
+    // the burst must not crowd out what is already waiting; try again next update if it would
+    if (queueSize > MAX_QUEUED_MESSAGES / 4)
     {
-        FURI_LOG_E("FlipWorldRun", "Would exceed memory limit with %zu chunks (%zu + %zu > %zu), skipping message",
-                   boundaryCount, currentMemoryUsage, estimatedChunkMemory, MAX_TOTAL_MEMORY);
-        return; // Skip this entire message to avoid partial sends
+        return false;
     }
 
-    // We have enough space, send all chunks
-    for (size_t i = 0; i < boundaryCount; i++)
+    // Header: the level, so the joiner switches level before any entity arrives
+    char header[NET_MAX_FRAME_SIZE + 1];
+    JsonWriter writer;
+    json_writer_init(&writer, header, sizeof(header));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "type");
+    json_writer_string(&writer, "snapshot");
+    json_writer_key(&writer, "l");
+    json_writer_int(&writer, getCurrentLevelIndex());
+    json_writer_object_end(&writer);
+    if (!json_writer_finish(&writer) || !safeWebsocketSend(app, header))
     {
-        size_t chunkStart = boundaries[i].start;
-        size_t chunkLength = boundaries[i].length;
+        return false;
+    }
 
-        // Build chunk header with actual total count
-        char chunkHeader[64];
-        int headerLen = snprintf(chunkHeader, sizeof(chunkHeader), "{\"id\":%d,\"seq\":%zu,\"total\":%zu,\"data\":\"",
-                                 messageId, i + 1, boundaryCount);
+    // Players as JSON keyframes: the joiner learns their usernames and stats instead of addRemotePlayer's defaults.
+    // Without them the joiner never creates the players, so a keyframe that is not queued keeps the snapshot
+    // pending and the whole burst goes out again on a later update
+    auto currentLevel = engine->getGame()->current_level;
+    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (entity && entity->type == ENTITY_PLAYER && !sendEntityKeyframe(app, entity))
+        {
+            return false;
+        }
+    }
 
-        // Build the complete chunk
-        char chunk[MAX_WEBSOCKET_SIZE + 1];
-        strcpy(chunk, chunkHeader);
-        int pos = headerLen;
+    // Lockstep: instead of the enemies' state, every device respawns the level for a new session
+    if (lockstepEnabled && sendLockstepRoster(app))
+    {
+        return true;
+    }
 
-        // Add the chunk data
-        for (size_t j = 0; j < chunkLength && pos < (int)sizeof(chunk) - 3; j++)
+    // Every enemy as a full record, packed behind the level record; peers that are already
+    // in sync apply them too, and they become everyone's new delta baseline
+    uint8_t frame[NET_BATCH_MAX_BYTES];
+    size_t frameLen = netLevelEncode((uint8_t)getCurrentLevelIndex(), frame, sizeof(frame));
+    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (!entity || entity->type != ENTITY_ENEMY)
         {
-            chunk[pos++] = message[chunkStart + j];
+            continue;
         }
+        entity->net_seq = netSeqNext(entity->net_seq);
+        NetEntityState state;
+        NetWireState wire;
+        netEntityStateFromEntity(entity, &state);
+        netWireStateFromEntityState(&state, &wire);
 
-        // Close JSON
-        chunk[pos++] = '"';
-        chunk[pos++] = '}';
-        chunk[pos] = '\0';
-
-        if (!safeWebsocketSend(app, chunk))
+        uint8_t record[NET_ENTITY_STATE_SIZE];
+        size_t len = netWireStateEncode(&wire, record, sizeof(record));
+        if (frameLen + len > sizeof(frame))
         {
-            FURI_LOG_E("FlipWorldRun", "Unexpected failure to send/queue chunk %zu", i + 1);
-            // Continue anyway since we pre-checked queue space
+            char text[NET_MAX_FRAME_SIZE + 1];
+            if (!netRecordToText(frame, frameLen, text, sizeof(text)) || !safeWebsocketSend(app, text))
+            {
+                return false;
+            }
+            frameLen = 0;
         }
+        memcpy(frame + frameLen, record, len);
+        frameLen += len;
+
+        SyncSnapshot *snapshot = getSyncSnapshot(wire.id, false);
+        snapshot->wire = wire;
+        snapshot->valid = true;
     }
+    char text[NET_MAX_FRAME_SIZE + 1];
+    return netRecordToText(frame, frameLen, text, sizeof(text)) && safeWebsocketSend(app, text);
 }
 
 bool FlipWorldRun::setAppContext(void *context)
@@ -2279,6 +2505,8 @@ bool FlipWorldRun::setAppContext(void *context)
         return false;
     }
     appContext = context;
+    // UART time spent before this point (HTTP requests, the websocket start) is not multiplayer traffic
+    lastTxBusyMs = static_cast<FlipWorldApp *>(context)->uartTxBusyMs();
     return true;
 }
 
@@ -2312,23 +2540,34 @@ bool FlipWorldRun::setIconGroup(LevelIndex index)
         currentIconGroup->count = 0;
     }
 
+    // Tokenize the level once; both passes walk the same token buffer
+    JsonDoc doc;
+    if (!json_doc_parse_alloc(&doc, json_data, strlen(json_data)))
+    {
+        FURI_LOG_E("Game", "Failed to parse level JSON");
+        return false;
+    }
+    const int json_array = json_doc_find(&doc, 0, "json_data");
+    JsonArrayIter iter;
+    if (!json_array_iter_init(&iter, &doc, json_array))
+    {
+        FURI_LOG_E("Game", "Level JSON has no json_data array");
+        json_doc_free(&doc);
+        return false;
+    }
+
     // Pass 1: Count the total number of icons.
     int total_icons = 0;
     for (int i = 0; i < MAX_WORLD_OBJECTS; i++)
     {
-        char *data = get_json_array_value("json_data", i, json_data);
-        if (!data)
+        int data = json_array_iter_next(&iter);
+        if (data < 0)
             break;
-        char *amount = get_json_value("a", data);
-        if (amount)
+        int32_t amount;
+        if (json_doc_get_int(&doc, data, "a", &amount))
         {
-            int count = atoi(amount);
-            if (count < 1)
-                count = 1;
-            total_icons += count;
-            free(amount);
+            total_icons += amount < 1 ? 1 : amount;
         }
-        free(data);
     }
 
     currentIconGroup->count = total_icons;
@@ -2336,64 +2575,68 @@ bool FlipWorldRun::setIconGroup(LevelIndex index)
     if (!currentIconGroup->icons)
     {
         FURI_LOG_E("Game", "Failed to allocate icon group array for %d icons", total_icons);
+        json_doc_free(&doc);
         return false;
     }
 
     // Pass 2: Parse the JSON to fill the icon specs.
     int spec_index = 0;
+    json_array_iter_init(&iter, &doc, json_array);
     for (int i = 0; i < MAX_WORLD_OBJECTS; i++)
     {
-        char *data = get_json_array_value("json_data", i, json_data);
-        if (!data)
+        int data = json_array_iter_next(&iter);
+        if (data < 0)
             break;
 
         /*
-        i - icon name
+        i - icon name or registry ID
         x - x position
         y - y position
         a - amount
         h - horizontal (true/false)
         */
 
-        char *icon_str = get_json_value("i", data);
-        char *x_str = get_json_value("x", data);
-        char *y_str = get_json_value("y", data);
-        char *amount_str = get_json_value("a", data);
-        char *horizontal_str = get_json_value("h", data);
-
-        if (!icon_str || !x_str || !y_str || !amount_str || !horizontal_str)
+        const int icon_tok = json_doc_find(&doc, data, "i");
+        int32_t count;
+        float base_x, base_y;
+        bool is_horizontal;
+        if (icon_tok < 0 ||
+            !json_doc_get_float(&doc, data, "x", &base_x) ||
+            !json_doc_get_float(&doc, data, "y", &base_y) ||
+            !json_doc_get_int(&doc, data, "a", &count) ||
+            !json_doc_get_bool(&doc, data, "h", &is_horizontal))
         {
             FURI_LOG_E("Game", "Incomplete icon data");
-            if (icon_str)
-                free(icon_str);
-            if (x_str)
-                free(x_str);
-            if (y_str)
-                free(y_str);
-            if (amount_str)
-                free(amount_str);
-            if (horizontal_str)
-                free(horizontal_str);
-            free(data);
             continue;
         }
 
-        int count = atoi(amount_str);
         if (count < 1)
             count = 1;
-        float base_x = atof_(x_str);
-        float base_y = atof_(y_str);
-        bool is_horizontal = (strcmp(horizontal_str, "true") == 0);
         int spacing = 17;
 
+        // "i" is either a registry ID or an icon name; resolve it once per element
+        IconID icon_id;
+        if (doc.tokens[icon_tok].type == JSMN_PRIMITIVE)
+        {
+            int32_t raw_id;
+            icon_id = json_doc_get_int(&doc, data, "i", &raw_id) ? (IconID)raw_id : ICON_ID_INVALID;
+        }
+        else
+        {
+            char icon_name[24];
+            json_view_copy(json_doc_view(&doc, icon_tok), icon_name, sizeof(icon_name));
+            icon_id = iconIdFromName(icon_name);
+        }
+        const IconSpec base_spec = getIconSpec(icon_id);
+        if (!base_spec.icon)
+        {
+            FURI_LOG_E("Game", "Icon name not recognized");
+            continue;
+        }
+
         for (int j = 0; j < count; j++)
         {
-            IconSpec spec = getIconSpec(icon_str);
-            if (!spec.icon)
-            {
-                FURI_LOG_E("Game", "Icon name not recognized");
-                continue;
-            }
+            IconSpec spec = base_spec;
             if (is_horizontal)
             {
                 spec.pos.x = base_x + (j * spacing);
@@ -2406,15 +2649,13 @@ bool FlipWorldRun::setIconGroup(LevelIndex index)
             }
             currentIconGroup->icons[spec_index++] = spec;
         }
-
-        free(icon_str);
-        free(x_str);
-        free(y_str);
-        free(amount_str);
-        free(horizontal_str);
-        free(data);
     }
 
+    json_doc_free(&doc);
+
+    // skipped elements leave no gaps, so only count the filled specs
+    currentIconGroup->count = spec_index;
+
     return true;
 }
 
@@ -2518,10 +2759,146 @@ bool FlipWorldRun::startGame()
         draw->text(Vector(0, 10), "Starting single player game...", ColorBlack);
     }
 
+    // The host decides whether the lobby runs in lockstep; followers follow its roster
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(appContext);
+    char lockstepSetting[8];
+    lockstepEnabled = isPvEMode && isLobbyHost && app &&
+                      app->loadChar("lockstep", lockstepSetting, sizeof(lockstepSetting)) &&
+                      strcmp(lockstepSetting, "On") == 0;
+
     isGameRunning = true; // Set the flag to indicate game is running
     return true;
 }
 
+bool FlipWorldRun::startLockstep(const NetRoster *roster)
+{
+    if (!roster || !player || !engine || !engine->getGame() || roster->levelIndex > LevelForestWorld)
+    {
+        return false;
+    }
+
+    switchToLevel(roster->levelIndex);
+    Game *game = engine->getGame();
+    auto currentLevel = game->current_level;
+
+    // every player of the session has to be known here before anything is reset
+    const uint16_t localId = netEntityId(player.get());
+    Entity *players[NET_ROSTER_MAX];
+    for (uint8_t i = 0; i < roster->count; i++)
+    {
+        players[i] = roster->players[i] == localId ? player.get() : currentLevel->entity_find(roster->players[i]);
+        if (!players[i] || players[i]->type != ENTITY_PLAYER)
+        {
+            FURI_LOG_W("FlipWorldRun", "Lockstep session %u has unknown player %04x", roster->session, roster->players[i]);
+            return false;
+        }
+    }
+
+    // the same starting state everywhere: a freshly spawned level and freshly spawned players
+    releaseRemoteMotion(nullptr);
+    currentLevel->clear_spawned();
+    addLevelEntities(currentLevel, static_cast<LevelIndex>(roster->levelIndex));
+    for (uint8_t i = 0; i < roster->count; i++)
+    {
+        Player::spawn(players[i], (float)roster->xp[i]);
+    }
+    if (!netLockstepStart(&lockstep, roster->players, roster->count, localId, roster->session, InputKeyMAX))
+    {
+        return false;
+    }
+    player->updateCamera(game);
+    FURI_LOG_I("FlipWorldRun", "Lockstep session %u started with %u players", roster->session, roster->count);
+    return true;
+}
+
+void FlipWorldRun::stepLockstep(const uint8_t *inputs)
+{
+    Game *game = engine->getGame();
+    auto currentLevel = game->current_level;
+
+    const uint16_t localId = netEntityId(player.get());
+    Entity *players[NET_ROSTER_MAX];
+    uint8_t pending[NET_ROSTER_MAX];
+    for (uint8_t slot = 0; slot < lockstep.playerCount; slot++)
+    {
+        players[slot] = lockstep.players[slot] == localId ? player.get() : currentLevel->entity_find(lockstep.players[slot]);
+        pending[slot] = inputs[slot];
+    }
+
+    // Enemies and NPCs first, as Level::update does (players are added after them), but the players are
+    // visited in roster order: the level's own order differs between devices. An attack consumes the input.
+    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (!entity || !entity->is_active || entity->type == ENTITY_PLAYER)
+        {
+            continue;
+        }
+        entity->update(game);
+        for (int j = 0; j < currentLevel->getEntityCount(); j++)
+        {
+            Entity *other = currentLevel->getEntity(j);
+            if (other && other != entity && other->type != ENTITY_PLAYER && currentLevel->is_collision(entity, other))
+            {
+                game->input = InputKeyMAX;
+                entity->collision(other, game);
+            }
+        }
+        for (uint8_t slot = 0; slot < lockstep.playerCount; slot++)
+        {
+            if (players[slot] && currentLevel->is_collision(entity, players[slot]))
+            {
+                game->input = pending[slot];
+                entity->collision(players[slot], game);
+                pending[slot] = game->input;
+            }
+        }
+    }
+
+    for (uint8_t slot = 0; slot < lockstep.playerCount; slot++)
+    {
+        if (players[slot])
+        {
+            Player::step(players[slot], pending[slot], game, currentIconGroup);
+        }
+    }
+    game->input = InputKeyMAX;
+    player->updateCamera(game);
+}
+
+void FlipWorldRun::stopLockstep()
+{
+    if (!lockstep.active)
+    {
+        return;
+    }
+    FURI_LOG_I("FlipWorldRun", "Lockstep session %u ended at tick %lu", lockstep.session, (unsigned long)lockstep.tick);
+    netLockstepStop(&lockstep);
+    if (isLobbyHost)
+    {
+        lockstepEndedAt = furi_get_tick() | 1; // 0 means no restart pending
+    }
+    else
+    {
+        // ask again unless the host's next session arrives first
+        snapshotReceived = false;
+        lastJoinRequestTime = furi_get_tick();
+    }
+}
+
+void FlipWorldRun::switchToLevel(int32_t levelIndex)
+{
+    if (levelIndex >= 0 && levelIndex < 3 && getCurrentLevelIndex() != levelIndex) // Valid level indices
+    {
+        if (engine && engine->getGame())
+        {
+            releaseRemoteMotion(nullptr); // the old level's entities are about to be destroyed
+            engine->getGame()->level_switch(levelIndex);
+            setIconGroup(static_cast<LevelIndex>(levelIndex));
+        }
+    }
+}
+
 void FlipWorldRun::syncMultiplayerState()
 {
     // Only sync in PvE mode
@@ -2539,14 +2916,8 @@ void FlipWorldRun::syncMultiplayerState()
     // Check if enough time has passed since last sync
     uint32_t currentTime = furi_get_tick();
 
-    // If queue is getting full, increase sync interval to prevent overflow
-    uint32_t effectiveSyncInterval = syncInterval;
-    if (queueSize > MAX_QUEUED_MESSAGES * 0.7) // If queue is 70% full
-    {
-        effectiveSyncInterval = syncInterval * 2; // Double the interval
-    }
-
-    if (currentTime - lastSyncTime < effectiveSyncInterval)
+    // The link controller already backs the interval off when the queue fills up
+    if (currentTime - lastSyncTime < link.syncIntervalMs)
     {
         return;
     }
@@ -2559,115 +2930,129 @@ void FlipWorldRun::syncMultiplayerState()
 
     auto currentLevel = engine->getGame()->current_level;
 
-    if (isLobbyHost)
+    // Every FULL_STATE_INTERVAL-th sync sends full records of every entity (loss recovery);
+    // the rest send deltas and skip entities that have not changed
+    const bool fullState = (syncCount++ % FULL_STATE_INTERVAL) == 0;
+
+    // Peers create remote players only from a JSON keyframe, which carries the username, so ours
+    // goes out once per level and again whenever a player we had not seen there shows up
+    const int playerCount = countLevelPlayers();
+    const int levelIndex = (int)getCurrentLevelIndex();
+    if (player && (levelIndex != announcedLevel || playerCount > announcedPlayers))
     {
-        // Host sends all entity states (player + enemies)
-        // Limit number of entities per sync if queue is getting full
-        int maxEntitiesToSync = currentLevel->getEntityCount();
-        if (queueSize > MAX_QUEUED_MESSAGES * 0.5) // If queue is 50% full
+        if (sendEntityKeyframe(app, player.get()))
         {
-            maxEntitiesToSync = 2; // Only sync 2 entities at a time
+            announcedLevel = levelIndex;
+            announcedPlayers = playerCount;
         }
+    }
+    else
+    {
+        announcedPlayers = playerCount; // a player leaving lets the next newcomer trigger it again
+    }
 
-        int entitiesSynced = 0;
-        for (int i = 0; i < currentLevel->getEntityCount() && entitiesSynced < maxEntitiesToSync; i++)
+    // Players and enemies this device is responsible for: the host's players and relevant enemies, only our player otherwise
+    Entity *entities[MAX_SYNC_SNAPSHOTS];
+    size_t entityCount = 0;
+    if (!isLobbyHost)
+    {
+        for (int i = 0; i < currentLevel->getEntityCount(); i++)
         {
             Entity *entity = currentLevel->getEntity(i);
-            if (!entity)
-                continue;
-
-            const char *entityJson = entityToJson(entity, true); // websocket format
-            if (entityJson)
+            if (entity && entity->type == ENTITY_PLAYER)
             {
-                // Calculate required buffer size and allocate dynamically
-                size_t entityJsonLen = strlen(entityJson);
-                size_t messageSize = entityJsonLen + 64; // Extra space for wrapper JSON
-                char *message = (char *)malloc(messageSize);
-
-                if (!message)
-                {
-                    FURI_LOG_E("FlipWorldRun", "Failed to allocate message buffer");
-                    free((void *)entityJson);
-                    continue;
-                }
-
-                // Create message with type and data
-                if (entity->type == ENTITY_PLAYER)
-                {
-                    snprintf(message, messageSize, "{\"type\":\"player\",\"data\":%s}", entityJson);
-                }
-                else if (entity->type == ENTITY_ENEMY)
-                {
-                    snprintf(message, messageSize, "{\"type\":\"enemy\",\"data\":%s}", entityJson);
-                }
-                else
-                {
-                    free((void *)entityJson); // Free allocated memory
-                    free(message);
-                    continue; // Skip NPCs and other entity types
-                }
-
-                // Send message with chunking support
-                sendMessageWithChunking(app, message);
-                entitiesSynced++;
-
-                free((void *)entityJson); // Free allocated memory after use
-                free(message);            // Free message buffer
+                entities[entityCount++] = entity; // Follower sends only their player state
+                break;
             }
         }
-
-        // Send current level info
-        char levelMessage[128];
-        snprintf(levelMessage, sizeof(levelMessage),
-                 "{\"type\":\"level\",\"level_index\":%d}",
-                 getCurrentLevelIndex());
-        safeWebsocketSend(app, levelMessage);
     }
     else
     {
-        // Follower sends only their player state
-        if (player)
+        // Every frame is broadcast, so an enemy matters if any follower can (almost) see it.
+        // Followers' player updates carry their position and the camera follows the player,
+        // so their views are known without extra fields on the wire.
+        Vector views[MAX_REMOTE_VIEWERS];
+        size_t viewCount = 0;
+        for (int i = 0; i < currentLevel->getEntityCount() && viewCount < MAX_REMOTE_VIEWERS; i++)
         {
-            // Find the player entity in the current level
-            Entity *playerEntity = nullptr;
-            for (int i = 0; i < currentLevel->getEntityCount(); i++)
+            Entity *entity = currentLevel->getEntity(i);
+            if (entity && entity->type == ENTITY_PLAYER && entity != player.get())
             {
-                Entity *entity = currentLevel->getEntity(i);
-                if (entity && entity->type == ENTITY_PLAYER)
-                {
-                    playerEntity = entity;
-                    break;
-                }
+                views[viewCount++] = entity->position;
             }
+        }
+
+        // players first, then enemies in view ordered by closeness; out-of-view enemies take turns
+        uint32_t distances[MAX_SYNC_SNAPSHOTS];
+        int nextFar = -1;  // first out-of-view enemy at or after the cursor
+        int firstFar = -1; // first out-of-view enemy overall (wrap-around)
+        for (int i = 0; i < currentLevel->getEntityCount(); i++)
+        {
+            Entity *entity = currentLevel->getEntity(i);
+            if (!entity || (entity->type != ENTITY_PLAYER && entity->type != ENTITY_ENEMY))
+                continue; // Skip NPCs and other entity types
 
-            if (playerEntity)
+            uint32_t distance = 0;
+            if (entity->type == ENTITY_ENEMY)
             {
-                const char *entityJson = entityToJson(playerEntity, true); // websocket format
-                if (entityJson)
+                bool inView = false;
+                distance = UINT32_MAX;
+                for (size_t v = 0; v < viewCount; v++)
                 {
-                    // Calculate required buffer size and allocate dynamically
-                    size_t entityJsonLen = strlen(entityJson);
-                    size_t messageSize = entityJsonLen + 64; // Extra space for wrapper JSON
-                    char *message = (char *)malloc(messageSize);
-
-                    if (!message)
+                    float dx = entity->position.x - views[v].x;
+                    float dy = entity->position.y - views[v].y;
+                    dx = dx < 0 ? -dx : dx;
+                    dy = dy < 0 ? -dy : dy;
+                    if (dx <= VIEW_HALF_WIDTH + VIEW_MARGIN && dy <= VIEW_HALF_HEIGHT + VIEW_MARGIN)
                     {
-                        FURI_LOG_E("FlipWorldRun", "Failed to allocate message buffer");
-                        free((void *)entityJson);
-                        return;
+                        inView = true;
+                        if ((uint32_t)(dx + dy) < distance)
+                            distance = (uint32_t)(dx + dy);
                     }
+                }
+                if (!inView)
+                {
+                    if (nextFar < 0 && i >= relevanceCursor)
+                        nextFar = i;
+                    if (firstFar < 0)
+                        firstFar = i;
+                    continue;
+                }
+                distance++; // players (0) always sort ahead
+            }
 
-                    snprintf(message, messageSize, "{\"type\":\"player\",\"data\":%s}", entityJson);
-
-                    // Send message with chunking support
-                    sendMessageWithChunking(app, message);
-
-                    free((void *)entityJson); // Free allocated memory after use
-                    free(message);            // Free message buffer
+            // insertion by distance; when full, the farthest entry gives way
+            size_t pos = entityCount < MAX_SYNC_SNAPSHOTS ? entityCount++ : MAX_SYNC_SNAPSHOTS;
+            while (pos > 0 && distances[pos - 1] > distance)
+            {
+                if (pos < MAX_SYNC_SNAPSHOTS)
+                {
+                    entities[pos] = entities[pos - 1];
+                    distances[pos] = distances[pos - 1];
                 }
+                pos--;
+            }
+            if (pos < MAX_SYNC_SNAPSHOTS)
+            {
+                entities[pos] = entity;
+                distances[pos] = distance;
             }
         }
+
+        // one out-of-view enemy per round, in level order, so none is starved of updates
+        int farIndex = nextFar >= 0 ? nextFar : firstFar;
+        if (farIndex >= 0 && entityCount < MAX_SYNC_SNAPSHOTS)
+        {
+            entities[entityCount++] = currentLevel->getEntity(farIndex);
+            relevanceCursor = farIndex + 1;
+        }
     }
+
+    // Pack every changed entity (every entity on a keyframe, and the host's level) into as few frames
+    // as possible; when the queue is half full only the highest-priority frame goes out
+    size_t freeSlots = queueSize < MAX_QUEUED_MESSAGES ? MAX_QUEUED_MESSAGES - queueSize : 0;
+    size_t maxFrames = queueSize > MAX_QUEUED_MESSAGES * 0.5 ? 1 : freeSlots;
+    sendStateBatches(app, entities, entityCount, isLobbyHost ? levelIndex : -1, maxFrames, fullState);
 }
 
 void FlipWorldRun::updateDraw(Canvas *canvas)
@@ -2724,3 +3109,135 @@ void FlipWorldRun::updateInput(InputEvent *event)
         this->inputManager();
     }
 }
+
+void FlipWorldRun::updateLockstep(InputKey input)
+{
+    if (!lockstep.active || !player || !engine || !engine->getGame() || !engine->getGame()->current_level)
+    {
+        return;
+    }
+
+    Game *game = engine->getGame();
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(appContext);
+    const uint16_t localId = netEntityId(player.get());
+
+    // Schedule this frame's input; batches skip the queue (they are tiny and every tick waits on them)
+    netLockstepLocalInput(&lockstep, (uint8_t)input);
+    NetInputBatch batch;
+    batch.count = netLockstepOutgoing(&lockstep, &batch.firstTick, batch.inputs, NET_INPUT_MAX_TICKS);
+    if (batch.count > 0 && app)
+    {
+        batch.playerId = localId;
+        batch.session = lockstep.session;
+        uint8_t record[7 + NET_INPUT_MAX_TICKS / 2];
+        char text[NET_MAX_FRAME_SIZE + 1];
+        size_t len = netInputBatchEncode(&batch, record, sizeof(record));
+        if (len > 0 && netRecordToText(record, len, text, sizeof(text)) && app->websocketSend(text))
+        {
+            onWebsocketSent(app, strlen(text) + 1);
+        }
+    }
+
+    // One tick per frame, a few more while a peer is ahead of us
+    for (uint8_t ran = 0; ran < NET_LOCKSTEP_MAX_CATCHUP && netLockstepReady(&lockstep) && (ran == 0 || netLockstepBehind(&lockstep)); ran++)
+    {
+        stepLockstep(netLockstepTickInputs(&lockstep));
+        netLockstepAdvance(&lockstep);
+        if (!netLockstepChecksumDue(&lockstep))
+        {
+            continue;
+        }
+
+        // Hash in an order every device shares: spawned entities in level order, then the players by slot
+        auto currentLevel = game->current_level;
+        uint32_t hash = 2166136261u;
+        for (int i = 0; i < currentLevel->getEntityCount(); i++)
+        {
+            Entity *entity = currentLevel->getEntity(i);
+            if (entity && entity->type != ENTITY_PLAYER)
+            {
+                hash = netLockstepHash(hash, entity);
+            }
+        }
+        for (uint8_t slot = 0; slot < lockstep.playerCount; slot++)
+        {
+            Entity *entity = lockstep.players[slot] == localId ? player.get() : currentLevel->entity_find(lockstep.players[slot]);
+            if (entity)
+            {
+                hash = netLockstepHash(hash, entity);
+            }
+        }
+        netLockstepOnOwnChecksum(&lockstep, lockstep.tick, hash);
+
+        NetChecksum checksum = {localId, lockstep.session, (uint16_t)lockstep.tick, hash};
+        uint8_t record[NET_CHECKSUM_RECORD_SIZE];
+        char text[NET_MAX_FRAME_SIZE + 1];
+        if (app && netChecksumEncode(&checksum, record, sizeof(record)) && netRecordToText(record, sizeof(record), text, sizeof(text)))
+        {
+            safeWebsocketSend(app, text);
+        }
+    }
+
+    // A peer that stopped sending ends the session; the host drops it (it is re-added if it says hello again)
+    if (netLockstepStalled(&lockstep, furi_get_tick()))
+    {
+        uint8_t missing = netLockstepMissing(&lockstep);
+        FURI_LOG_W("FlipWorldRun", "Lockstep stalled at tick %lu waiting for %02x", (unsigned long)lockstep.tick, missing);
+        for (uint8_t slot = 0; isLobbyHost && slot < lockstep.playerCount; slot++)
+        {
+            Entity *entity = game->current_level->entity_find(lockstep.players[slot]);
+            if ((missing & (1u << slot)) && slot != lockstep.localSlot && entity && entity->type == ENTITY_PLAYER)
+            {
+                removeRemotePlayer(entity->name);
+            }
+        }
+        stopLockstep();
+        return;
+    }
+
+    // Every device sees the level cleared on the same tick and moves on to the next one
+    int enemies = 0;
+    bool cleared = true;
+    for (int i = 0; i < game->current_level->getEntityCount() && cleared; i++)
+    {
+        Entity *entity = game->current_level->getEntity(i);
+        if (entity && entity->type == ENTITY_ENEMY)
+        {
+            enemies++;
+            cleared = entity->state == ENTITY_DEAD;
+        }
+    }
+    if (enemies > 0 && cleared)
+    {
+        stopLockstep();
+        switchToLevel((getCurrentLevelIndex() + 1) % 3); // same order as Player::checkForLevelCompletion
+    }
+}
+
+void FlipWorldRun::updateRemoteMotion()
+{
+    if (!engine || !engine->getGame() || !engine->getGame()->current_level)
+    {
+        return;
+    }
+
+    // walk the level rather than the table so a stale slot is never dereferenced
+    auto currentLevel = engine->getGame()->current_level;
+    uint32_t now = furi_get_tick();
+    for (int i = 0; i < currentLevel->getEntityCount(); i++)
+    {
+        Entity *entity = currentLevel->getEntity(i);
+        if (!entity || entity->state == ENTITY_DEAD)
+        {
+            continue;
+        }
+        for (size_t j = 0; j < MAX_REMOTE_MOTIONS; j++)
+        {
+            if (remoteMotions[j].entity == entity)
+            {
+                entity->position_set(netMotionSample(&remoteMotions[j].motion, now));
+                break;
+            }
+        }
+    }
+}
@@ -3,33 +3,71 @@
 #include "engine/engine.hpp"
 #include "run/general.hpp"
 #include "run/player.hpp"
+#include "run/interpolation.hpp"
+#include "run/link.hpp"
+#include "run/lockstep.hpp"
+#include "run/protocol.hpp"
+#include "jsmn/jsmn_writer.h"
 
 class FlipWorldApp;
 
-// Structure to hold chunked message data
+#define MAX_CHUNKS_PER_MESSAGE 6            // Most chunks one message is split into
+#define CHUNK_DATA_STRIDE NET_MAX_FRAME_SIZE // Reassembly bytes reserved per chunk (a chunk's data never exceeds its frame)
+#define MAX_TX_BACKLOG (2 * (NET_MAX_FRAME_SIZE + 1)) // UART bytes still unwritten above which queued messages wait
+
+// Preallocated reassembly slot for one chunked message; chunk seq N lands at data[(N - 1) * CHUNK_DATA_STRIDE]
 struct ChunkedMessage
 {
-    uint16_t id;
-    uint16_t totalChunks;
-    uint16_t receivedChunks;
-    char *data;
-    size_t dataSize;
-    size_t dataCapacity;
-    uint32_t lastUpdateTime;
+    uint16_t id;                                                 // message id
+    uint16_t totalChunks;                                        // chunks expected
+    uint16_t receivedChunks;                                     // distinct chunks received
+    uint8_t receivedMask;                                        // bit (seq - 1) set once that chunk arrived
+    uint8_t chunkLength[MAX_CHUNKS_PER_MESSAGE];                 // data length of each received chunk
+    bool active;                                                 // slot is reassembling a message
+    uint32_t lastUpdateTime;                                     // tick of the last chunk
+    char data[MAX_CHUNKS_PER_MESSAGE * CHUNK_DATA_STRIDE + 1];   // chunk data at fixed stride, compacted in place when complete
 };
 
-// Structure to hold queued websocket messages
+// One preallocated slot of the outgoing websocket queue (a single transport frame)
 struct QueuedMessage
 {
-    char *message;
+    char message[NET_MAX_FRAME_SIZE + 1];
     size_t messageLen;
 };
 
 class FlipWorldRun
 {
 private:
-    static const size_t MAX_CHUNKED_MESSAGES = 6; // Maximum number of concurrent chunked messages
-    static const size_t MAX_QUEUED_MESSAGES = 35; // Maximum number of queued websocket messages
+    static const size_t MAX_CHUNKED_MESSAGES = 6;     // Maximum number of concurrent chunked messages
+    static const size_t MAX_QUEUED_MESSAGES = 35;     // Maximum number of queued websocket messages
+    static const size_t MAX_ENTITY_JSON_TOKENS = 32;  // Token buffer size for parsing one entity update
+    static const size_t MAX_MESSAGE_JSON_TOKENS = 40; // Token buffer size for parsing one multiplayer message
+    static const size_t MAX_SYNC_MESSAGE_SIZE = 256;  // Stack buffer size for one outgoing entity sync message
+    static const uint32_t FULL_STATE_INTERVAL = 5;    // Every Nth sync sends full binary records of every entity instead of deltas
+    static const size_t MAX_SYNC_SNAPSHOTS = 16;      // Entities tracked for delta replication
+    static const uint8_t MAX_INCOMING_PER_UPDATE = 8; // Incoming websocket lines handled per update (the rest wait in the ring)
+    static const size_t MAX_REMOTE_MOTIONS = 16;      // Remote entities smoothed between network updates
+    static const size_t MAX_REMOTE_VIEWERS = 8;       // Followers whose view the host considers when choosing what to sync
+    static const int VIEW_HALF_WIDTH = 64;            // Half the 128x64 screen; the camera is centered on the player
+    static const int VIEW_HALF_HEIGHT = 32;           // Half the 128x64 screen
+    static const int VIEW_MARGIN = 32;                // Enemies this close to a view are synced before they walk into it
+    static const uint32_t JOIN_RETRY_MS = 3000;       // Followers repeat their join hello until the host's snapshot arrives
+    static const uint32_t LOCKSTEP_RESTART_MS = 1000; // Host: pause between the end of a lockstep session and the next one
+    //
+    // Last state sent for one entity (delta baseline)
+    struct SyncSnapshot
+    {
+        NetWireState wire; // quantized state last sent
+        bool valid;        // slot holds a baseline
+        uint32_t round;    // sync round that last handed out this slot
+    };
+    //
+    // Smoothed motion of one remote entity (entity is only compared, never dereferenced, once stale)
+    struct RemoteMotion
+    {
+        Entity *entity;   // entity being smoothed (nullptr when the slot is free)
+        NetMotion motion; // interpolation/extrapolation state
+    };
     //
     size_t chunkedMessageCount = 0;                       // Current number of chunked messages being processed
     ChunkedMessage chunkedMessages[MAX_CHUNKED_MESSAGES]; // Array to hold chunked messages
@@ -39,29 +77,68 @@ private:
     bool inputHeld = false;                               // Flag to check if input is held
     bool isGameRunning = false;                           // Flag to check if the game is running
     bool isPvEMode = false;                               // Flag to determine if we're in PvE (multiplayer) mode
+    uint32_t lastDroppedLines = 0;                        // Incoming websocket lines dropped when last reported
     InputKey lastInput = InputKeyMAX;                     // Last input key pressed
+    uint32_t lastJoinRequestTime = 0;                     // Last time we asked the host for a world snapshot
     uint32_t lastSyncTime = 0;                            // Last time we sent a multiplayer sync message
+    uint32_t lastTxBusyMs = 0;                            // UART write time already reported to the link controller
     uint32_t lastWebsocketSendTime = 0;                   // Last time any websocket message was sent (for throttling)
+    NetLinkStats link = {};                               // Link measurements and the adaptive sync interval/pacing
+    NetLockstep lockstep = {};                            // Lockstep session (only inputs travel while it is active)
+    bool lockstepEnabled = false;                         // Host: run the lobby in lockstep (from the "lockstep" setting)
+    uint32_t lockstepEndedAt = 0;                         // Host: when the last session ended (0: no restart pending)
+    uint8_t lockstepSession = 0;                          // Host: number of the last session started
     QueuedMessage messageQueue[MAX_QUEUED_MESSAGES];      // Queue for websocket messages
     std::unique_ptr<Player> player;                       // Player instance
     size_t queueHead = 0;                                 // Head of the message queue
     size_t queueTail = 0;                                 // Tail of the message queue
     size_t queueSize = 0;                                 // Current size of the message queue
+    size_t queuedBytes = 0;                               // Bytes held in the queue slots (running total)
+    RemoteMotion remoteMotions[MAX_REMOTE_MOTIONS] = {};  // Remote entities currently being smoothed
     bool shouldReturnToMenu = false;                      // Flag to signal return to menu
-    uint32_t syncInterval = 1000;                         // Sync interval in milliseconds (1 time per second)
+    bool snapshotPending = false;                         // Host: a follower joined and is waiting for the world snapshot
+    bool snapshotReceived = false;                        // Follower: the host's world snapshot has arrived
+    int announcedLevel = -1;                              // Level our player's JSON keyframe (with the username) was last sent in
+    int announcedPlayers = 0;                             // Players in that level when it was sent
+    int relevanceCursor = 0;                              // Level index the next out-of-view enemy is picked from (round-robin)
+    uint32_t syncCount = 0;                               // Number of sync rounds sent (selects keyframe vs delta)
+    SyncSnapshot syncSnapshots[MAX_SYNC_SNAPSHOTS] = {};  // Per-entity last-sent state for delta replication
+    size_t syncSnapshotNext = 0;                          // Next snapshot slot to recycle when the table is full
     //
-    int atoi(const char *nptr) { return (int)strtol(nptr, NULL, 10); }    // convert string to integer
+    void addLevelEntities(Level *level, LevelIndex index) const;          // Spawn a level's enemies and NPCs (same order, so same net ids, on every device)
+    void applyEntityRecord(const uint8_t *record, size_t size);           // Apply one binary record to the matching entity (stale ones are dropped)
+    void applyEntityState(Entity *entity, const NetEntityState *state);   // Apply a decoded sync update to an entity
     void cleanupExpiredChunkedMessages();                                 // Clean up expired chunked messages
+    int countLevelPlayers();                                              // Players (ours included) in the current level
     void debounceInput();                                                 // debounce input to prevent multiple actions from a single press
+    void dropQueuedMessage();                                             // Release the oldest slot of the websocket queue
+    bool dropStaleUpdate(Entity *entity, const JsonDoc *doc, int obj);    // True (and counted) if a JSON update is older than the last one applied
+    void onWebsocketSent(FlipWorldApp *app, size_t bytes);                // Report a queued send and the UART time spent since the last one to the link controller
+    void releaseChunkedMessage(ChunkedMessage *chunkedMsg);               // Return a reassembly slot to the pool
+    void releaseRemoteMotion(Entity *entity);                             // Stop smoothing an entity (nullptr: all entities)
+    SyncSnapshot *getSyncSnapshot(uint16_t id, bool isPlayer);            // Find or allocate the delta baseline for an entity
     bool handleChunkedMessage(const char *message);                       // Handle chunked message assembly
     void handleIncomingMultiplayerData(const char *message);              // Handle incoming websocket messages (PvE mode only)
     void inputManager();                                                  // manage input for the game, called from updateInput
     void processCompleteMultiplayerMessage(const char *message);          // Process a complete multiplayer message (after chunk assembly)
-    void processWebsocketQueue(FlipWorldApp *app);                        // Process queued websocket messages with 100ms throttling
+    void processBinaryMessage(const char *message);                       // Process a binary ('~'-prefixed) batch of state records
+    void processWebsocketQueue(FlipWorldApp *app);                        // Process queued websocket messages (paced, and held while the UART is backed up)
+    void pushRemoteMotion(Entity *entity, Vector position, uint8_t fields); // Smooth a remote entity towards the received NET_FIELD_X/Y axes
     bool queueWebsocketMessage(const char *message);                      // Queue a websocket message for sending
     bool safeWebsocketSend(FlipWorldApp *app, const char *message);       // Send websocket message with 100ms throttling
-    void sendMessageWithChunking(FlipWorldApp *app, const char *message); // Send websocket message with chunking support for large messages
+    void sendLinkProbe(FlipWorldApp *app, const char *type, const char *username, uint32_t stamp); // Send a ping/pong round-trip probe immediately
+    bool sendEntityKeyframe(FlipWorldApp *app, Entity *entity);           // Send one entity's full state as a JSON keyframe
+    void sendJoinRequest(FlipWorldApp *app);                              // Announce ourselves to the host and ask for a world snapshot
+    bool sendLockstepRoster(FlipWorldApp *app);                           // Host: start a lockstep session with the players in the level (false if alone)
+    size_t sendStateBatches(FlipWorldApp *app, Entity *const *entities, size_t count, int levelIndex, size_t maxFrames, bool keyframe); // Send changed (keyframe: all) entities as packed binary frames; returns frames sent
+    bool sendMessageWithChunking(FlipWorldApp *app, const char *message); // Send websocket message with chunking support for large messages (false if not queued)
+    bool sendWorldSnapshot(FlipWorldApp *app);                            // Host: queue the level and every entity's full state in one burst
+    bool startLockstep(const NetRoster *roster);                          // Respawn the level and the roster's players, then begin the session
+    void stepLockstep(const uint8_t *inputs);                             // Simulate one lockstep tick with every player's input
+    void stopLockstep();                                                  // End the session (the host restarts it, followers ask again)
+    void switchToLevel(int32_t levelIndex);                               // Switch to the host's level if it differs from ours
     void syncMultiplayerState();                                          // Send multiplayer state updates (PvE mode only)
+    void updateRemoteMotion();                                            // Move smoothed remote entities to their positions for this frame
     static void pveRender(Entity *entity, Draw *canvas, Game *game);      // Callback for PvE entity
 public:
     FlipWorldRun();
@@ -71,24 +148,28 @@ public:
     IconGroupContext *currentIconGroup = nullptr; // Pointer to the current icon group context
     bool shouldDebounce = false;                  // public for Player access
     //
-    bool addRemotePlayer(const char *username);                                    // Add a remote player to the current level (PvE mode only)
+    Entity *addRemotePlayer(const char *username);                                 // Find or add a remote player in the current level (PvE mode only)
     void endGame();                                                                // end the game and return to the submenu
     bool entityJsonUpdate(Entity *entity);                                         // Update entity properties from JSON data
-    const char *entityToJson(Entity *entity, bool websocketParsing = false) const; // Convert entity properties to JSON string
+    bool entityToJson(Entity *entity, JsonWriter *writer, bool websocketParsing = false) const; // Write entity properties as one JSON object into writer; the caller finishes it
     InputKey getCurrentInput() const { return lastInput; }                         // Get the last input key pressed
     const char *getLevelJson(LevelIndex index) const;                              // Get the JSON data for a level by index
     GameEngine *getEngine() const { return engine.get(); }                         // Get the game engine instance
     Draw *getDraw() const { return draw.get(); }                                   // Get the Draw instance
     LevelIndex getCurrentLevelIndex() const;                                       // Get the current level index
+    IconSpec getIconSpec(IconID id) const;                                         // Get the icon specification by registry ID
     IconSpec getIconSpec(const char *name) const;                                  // Get the icon specification by name
     std::unique_ptr<Level> getLevel(LevelIndex index, Game *game = nullptr) const; // Get a level by index
     const char *getLevelName(LevelIndex index) const;                              // Get the name of a level by index
+    const NetLinkStats &getLinkStats() const { return link; }                      // Live link measurements and controller outputs (for tuning)
     size_t getMemoryUsage() const;                                                 // Get current memory usage in bytes
     bool isActive() const { return shouldReturnToMenu == false; }                  // Check if the game is active
     bool isHost() const { return isLobbyHost; }                                    // Check if this player is the lobby host
     bool isInPvEMode() const { return isPvEMode; }                                 // Check if in PvE mode
+    bool isLockstepActive() const { return lockstep.active; }                      // Check if a lockstep session drives the simulation
     bool isRunning() const { return isGameRunning; }                               // Check if the game engine is running
     bool parseEntityDataFromJson(Entity *entity, const char *jsonData);            // Parse entity data directly from JSON string
+    bool parseEntityDataFromJson(Entity *entity, const JsonDoc *doc, int obj);     // Parse entity data from an object token in a parsed document
     void processMultiplayerUpdate();                                               // Process multiplayer updates each frame (PvE mode only)
     void processWebsocketMessageQueue();                                           // Process the websocket message queue (call this regularly)
     bool removeRemotePlayer(const char *username);                                 // Remove a remote player from the current level (PvE mode only)
@@ -103,4 +184,5 @@ public:
     bool startGame();                                                              // start the actual game
     void updateDraw(Canvas *canvas);                                               // update and draw the run
     void updateInput(InputEvent *event);                                           // update input for the run
+    void updateLockstep(InputKey input);                                           // Schedule this frame's input and run the lockstep ticks that are ready
 };
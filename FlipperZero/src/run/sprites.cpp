@@ -2,6 +2,47 @@
 #include "run/assets.hpp"
 #include <math.h>
 
+// Sprite registry indexed by SpriteID
+static const struct
+{
+    const char *name;
+    const uint8_t *left;
+    const uint8_t *right;
+    Vector size;
+} spriteRegistry[SPRITE_ID_COUNT] = {
+    {"Cyclops", enemy_left_cyclops_10x11px, enemy_right_cyclops_10x11px, Vector(10, 11)}, // SPRITE_ID_CYCLOPS
+    {"Ogre", enemy_left_ogre_10x13px, enemy_right_ogre_10x13px, Vector(10, 13)},         // SPRITE_ID_OGRE
+    {"Ghost", enemy_left_ghost_15x15px, enemy_right_ghost_15x15px, Vector(15, 15)},      // SPRITE_ID_GHOST
+    {"Funny NPC", npc_left_funny_15x21px, npc_right_funny_15x21px, Vector(15, 21)},      // SPRITE_ID_FUNNY_NPC
+};
+
+SpriteID spriteIdFromName(const char *name)
+{
+    if (!name)
+        return SPRITE_ID_INVALID;
+
+    SpriteID id;
+    switch (assetHash(name))
+    {
+    case assetHash("Cyclops"):
+        id = SPRITE_ID_CYCLOPS;
+        break;
+    case assetHash("Ogre"):
+        id = SPRITE_ID_OGRE;
+        break;
+    case assetHash("Ghost"):
+        id = SPRITE_ID_GHOST;
+        break;
+    case assetHash("Funny NPC"):
+        id = SPRITE_ID_FUNNY_NPC;
+        break;
+    default:
+        return SPRITE_ID_INVALID;
+    }
+
+    return assetNameMatches(name, spriteRegistry[id].name) ? id : SPRITE_ID_INVALID;
+}
+
 Sprite::Sprite(const char *name, EntityType type, Vector position, Vector endPosition, float move_timer, float speed, float attack_timer, float strength, float health)
     : Entity(
           name,
@@ -21,33 +62,13 @@ Sprite::Sprite(const char *name, EntityType type, Vector position, Vector endPos
     this->strength = strength;
     this->health = health;
 
-    if (strcmp(name, "Cyclops") == 0)
-    {
-        sprite = enemy_left_cyclops_10x11px;
-        sprite_left = enemy_left_cyclops_10x11px;
-        sprite_right = enemy_right_cyclops_10x11px;
-        size = Vector(10, 11);
-    }
-    else if (strcmp(name, "Ogre") == 0)
-    {
-        sprite = enemy_left_ogre_10x13px;
-        sprite_left = enemy_left_ogre_10x13px;
-        sprite_right = enemy_right_ogre_10x13px;
-        size = Vector(10, 13);
-    }
-    else if (strcmp(name, "Ghost") == 0)
-    {
-        sprite = enemy_left_ghost_15x15px;
-        sprite_left = enemy_left_ghost_15x15px;
-        sprite_right = enemy_right_ghost_15x15px;
-        size = Vector(15, 15);
-    }
-    else if (strcmp(name, "Funny NPC") == 0)
+    SpriteID id = spriteIdFromName(name);
+    if (id != SPRITE_ID_INVALID)
     {
-        sprite = npc_left_funny_15x21px;
-        sprite_left = npc_left_funny_15x21px;
-        sprite_right = npc_right_funny_15x21px;
-        size = Vector(15, 21);
+        sprite = spriteRegistry[id].left;
+        sprite_left = spriteRegistry[id].left;
+        sprite_right = spriteRegistry[id].right;
+        size = spriteRegistry[id].size;
     }
     else
     {
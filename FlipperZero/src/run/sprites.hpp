@@ -3,6 +3,19 @@
 #include "engine/entity.hpp"
 #include "engine/vector.hpp"
 #include "engine/game.hpp"
+#include "run/general.hpp"
+
+typedef enum
+{
+    SPRITE_ID_INVALID = -1,
+    SPRITE_ID_CYCLOPS,
+    SPRITE_ID_OGRE,
+    SPRITE_ID_GHOST,
+    SPRITE_ID_FUNNY_NPC,
+    SPRITE_ID_COUNT, // number of registered sprites (not a sprite)
+} SpriteID;
+
+SpriteID spriteIdFromName(const char *name); // Resolve a sprite name (e.g. "Cyclops") to its registry ID
 
 class Sprite : public Entity
 {
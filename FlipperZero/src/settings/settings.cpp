@@ -70,6 +70,7 @@ bool FlipWorldSettings::init(ViewDispatcher **view_dispatcher, void *appContext)
     variable_item_connect = variable_item_list_add(variable_item_list, "[Connect To WiFi]", 1, nullptr, nullptr);
     variable_item_user_name = variable_item_list_add(variable_item_list, "User Name", 1, nullptr, nullptr);
     variable_item_user_pass = variable_item_list_add(variable_item_list, "User Password", 1, nullptr, nullptr);
+    variable_item_lockstep = variable_item_list_add(variable_item_list, "Lockstep", 2, lockstepChangedCallback, this);
 
     char loaded_ssid[64];
     char loaded_pass[64];
@@ -107,6 +108,11 @@ bool FlipWorldSettings::init(ViewDispatcher **view_dispatcher, void *appContext)
     {
         variable_item_set_current_value_text(variable_item_user_pass, "");
     }
+    // lockstep applies to lobbies this device hosts
+    char loaded_lockstep[8];
+    bool lockstep = app->loadChar("lockstep", loaded_lockstep, sizeof(loaded_lockstep)) && strcmp(loaded_lockstep, "On") == 0;
+    variable_item_set_current_value_index(variable_item_lockstep, lockstep ? 1 : 0);
+    variable_item_set_current_value_text(variable_item_lockstep, lockstep ? "On" : "Off");
 
     return true;
 }
@@ -222,6 +228,15 @@ bool FlipWorldSettings::initTextInput(uint32_t view)
     return false;
 }
 
+void FlipWorldSettings::lockstepChangedCallback(VariableItem *item)
+{
+    FlipWorldSettings *settings = (FlipWorldSettings *)variable_item_get_context(item);
+    FlipWorldApp *app = static_cast<FlipWorldApp *>(settings->appContext);
+    const char *value = variable_item_get_current_value_index(item) == 1 ? "On" : "Off";
+    variable_item_set_current_value_text(item, value);
+    app->saveChar("lockstep", value);
+}
+
 void FlipWorldSettings::settingsItemSelected(uint32_t index)
 {
     switch (index)
@@ -10,6 +10,7 @@ typedef enum
     SettingsViewConnect = 2,
     SettingsViewUserName = 3,
     SettingsViewUserPass = 4,
+    SettingsViewLockstep = 5,
 } SettingsViewChoice;
 
 class FlipWorldSettings
@@ -30,12 +31,14 @@ private:
     VariableItem *variable_item_wifi_pass = nullptr; // variable item for WiFi Password
     VariableItem *variable_item_user_name = nullptr; // variable item for User Name
     VariableItem *variable_item_user_pass = nullptr; // variable item for User Password
+    VariableItem *variable_item_lockstep = nullptr;  // variable item for the lockstep multiplayer toggle
     ViewDispatcher **view_dispatcher_ref = nullptr;  // reference to the view dispatcher
 
     static uint32_t callbackToSubmenu(void *context);                        // callback to switch to the main menu
     static uint32_t callbackToSettings(void *context);                       // callback to switch to the settings view
     void freeTextInput();                                                    // free the text input resources
     bool initTextInput(uint32_t view);                                       // initialize the text input for a specific view
+    static void lockstepChangedCallback(VariableItem *item);                 // callback for the lockstep toggle
     static void settingsItemSelectedCallback(void *context, uint32_t index); // callback for settings item selection
     bool startTextInput(uint32_t view);                                      // start the text input for a specific view
     void textUpdated(uint32_t view);                                         // update the text input based on the view
@@ -0,0 +1,79 @@
+#include <gui/elements.h>
+
+// Drawing is not under test; the engine only needs the symbols to link
+
+void canvas_clear(Canvas *canvas) { UNUSED(canvas); }
+void canvas_reset(Canvas *canvas) { UNUSED(canvas); }
+void canvas_set_color(Canvas *canvas, Color color)
+{
+    UNUSED(canvas);
+    UNUSED(color);
+}
+void canvas_set_font(Canvas *canvas, Font font)
+{
+    UNUSED(canvas);
+    UNUSED(font);
+}
+void canvas_set_custom_u8g2_font(Canvas *canvas, const uint8_t *font)
+{
+    UNUSED(canvas);
+    UNUSED(font);
+}
+void canvas_draw_str(Canvas *canvas, int32_t x, int32_t y, const char *str)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(str);
+}
+void canvas_draw_box(Canvas *canvas, int32_t x, int32_t y, size_t width, size_t height)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+}
+void canvas_draw_frame(Canvas *canvas, int32_t x, int32_t y, size_t width, size_t height)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+}
+void canvas_draw_line(Canvas *canvas, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    UNUSED(canvas);
+    UNUSED(x1);
+    UNUSED(y1);
+    UNUSED(x2);
+    UNUSED(y2);
+}
+void canvas_draw_dot(Canvas *canvas, int32_t x, int32_t y)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+}
+void canvas_draw_circle(Canvas *canvas, int32_t x, int32_t y, size_t radius)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(radius);
+}
+void canvas_draw_icon(Canvas *canvas, int32_t x, int32_t y, const Icon *icon)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(icon);
+}
+void elements_multiline_text(Canvas *canvas, int32_t x, int32_t y, const char *text)
+{
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(text);
+}
@@ -0,0 +1,414 @@
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <gui/view_dispatcher.h>
+#include <gui/modules/loading.h>
+
+// Single-threaded stand-ins for the kernel, UART and storage: enough to drive FlipperHTTP's
+// worker and response handlers from a test, nothing more
+
+static uint32_t stubTick = 1;
+static uint32_t stubFlags = 0;
+static uint32_t stubIdleFlags = 0;
+static char stubSerial[2048];
+static size_t stubSerialLen = 0;
+
+uint32_t furi_get_tick(void) { return stubTick; }
+uint32_t furi_ms_to_ticks(uint32_t ms) { return ms; }
+void furi_delay_ms(uint32_t ms) { stubTick += ms; }
+void furi_stub_advance_ms(uint32_t ms) { stubTick += ms; }
+void furi_stub_set_idle_flags(uint32_t flags) { stubIdleFlags = flags; }
+
+void *furi_record_open(const char *name) { return (void *)name; }
+void furi_record_close(const char *name) { UNUSED(name); }
+size_t memmgr_heap_get_max_free_block(void) { return 64 * 1024; }
+
+// Strings
+struct FuriString
+{
+    char *data;
+    size_t len;
+    size_t size;
+};
+
+static void stringFit(FuriString *string, size_t len)
+{
+    if (len + 1 > string->size)
+    {
+        string->size = len + 1 > string->size * 2 ? len + 1 : string->size * 2;
+        string->data = (char *)realloc(string->data, string->size);
+    }
+}
+
+FuriString *furi_string_alloc(void)
+{
+    FuriString *string = (FuriString *)calloc(1, sizeof(FuriString));
+    stringFit(string, 0);
+    string->data[0] = '\0';
+    return string;
+}
+FuriString *furi_string_alloc_set_str(const char *str)
+{
+    FuriString *string = furi_string_alloc();
+    furi_string_cat_str(string, str);
+    return string;
+}
+void furi_string_free(FuriString *string)
+{
+    free(string->data);
+    free(string);
+}
+void furi_string_push_back(FuriString *string, char c)
+{
+    stringFit(string, string->len + 1);
+    string->data[string->len++] = c;
+    string->data[string->len] = '\0';
+}
+void furi_string_reset(FuriString *string)
+{
+    string->len = 0;
+    string->data[0] = '\0';
+}
+void furi_string_reserve(FuriString *string, size_t size) { stringFit(string, size); }
+void furi_string_cat_str(FuriString *string, const char *str)
+{
+    size_t len = strlen(str);
+    stringFit(string, string->len + len);
+    memcpy(string->data + string->len, str, len + 1);
+    string->len += len;
+}
+void furi_string_set_n(FuriString *string, const FuriString *source, size_t start, size_t length)
+{
+    if (start > source->len)
+        start = source->len;
+    if (length > source->len - start)
+        length = source->len - start;
+    char *copy = (char *)malloc(length + 1);
+    memcpy(copy, source->data + start, length);
+    copy[length] = '\0';
+    furi_string_reset(string);
+    furi_string_cat_str(string, copy);
+    free(copy);
+}
+void furi_string_right(FuriString *string, size_t start)
+{
+    if (start >= string->len)
+    {
+        furi_string_reset(string);
+        return;
+    }
+    memmove(string->data, string->data + start, string->len - start + 1);
+    string->len -= start;
+}
+size_t furi_string_search_str(const FuriString *string, const char *needle, size_t start)
+{
+    if (start > string->len)
+        return (size_t)-1;
+    const char *found = strstr(string->data + start, needle);
+    return found ? (size_t)(found - string->data) : (size_t)-1;
+}
+const char *furi_string_get_cstr(const FuriString *string) { return string->data; }
+
+// Stream buffers: a plain byte ring
+struct FuriStreamBuffer
+{
+    uint8_t *data;
+    size_t size;
+    size_t head;
+    size_t len;
+};
+
+FuriStreamBuffer *furi_stream_buffer_alloc(size_t size, size_t trigger_level)
+{
+    UNUSED(trigger_level);
+    FuriStreamBuffer *stream = (FuriStreamBuffer *)calloc(1, sizeof(FuriStreamBuffer));
+    stream->data = (uint8_t *)malloc(size);
+    stream->size = size;
+    return stream;
+}
+void furi_stream_buffer_free(FuriStreamBuffer *stream)
+{
+    free(stream->data);
+    free(stream);
+}
+size_t furi_stream_buffer_send(FuriStreamBuffer *stream, const void *data, size_t length, uint32_t timeout)
+{
+    UNUSED(timeout);
+    const uint8_t *bytes = (const uint8_t *)data;
+    size_t sent = 0;
+    for (; sent < length && stream->len < stream->size; sent++)
+        stream->data[(stream->head + stream->len++) % stream->size] = bytes[sent];
+    return sent;
+}
+size_t furi_stream_buffer_receive(FuriStreamBuffer *stream, void *data, size_t length, uint32_t timeout)
+{
+    UNUSED(timeout);
+    uint8_t *bytes = (uint8_t *)data;
+    size_t received = 0;
+    for (; received < length && stream->len > 0; received++, stream->len--)
+    {
+        bytes[received] = stream->data[stream->head];
+        stream->head = (stream->head + 1) % stream->size;
+    }
+    return received;
+}
+bool furi_stream_buffer_is_empty(FuriStreamBuffer *stream) { return stream->len == 0; }
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer *stream) { return stream->size - stream->len; }
+
+// Threads never start; their flags collect until the test runs the thread function
+FuriThread *furi_thread_alloc(void) { return (FuriThread *)malloc(1); }
+void furi_thread_set_name(FuriThread *thread, const char *name)
+{
+    UNUSED(thread);
+    UNUSED(name);
+}
+void furi_thread_set_stack_size(FuriThread *thread, size_t size)
+{
+    UNUSED(thread);
+    UNUSED(size);
+}
+void furi_thread_set_context(FuriThread *thread, void *context)
+{
+    UNUSED(thread);
+    UNUSED(context);
+}
+void furi_thread_set_callback(FuriThread *thread, FuriThreadCallback callback)
+{
+    UNUSED(thread);
+    UNUSED(callback);
+}
+void furi_thread_start(FuriThread *thread) { UNUSED(thread); }
+bool furi_thread_join(FuriThread *thread)
+{
+    UNUSED(thread);
+    return true;
+}
+void furi_thread_free(FuriThread *thread) { free(thread); }
+FuriThreadId furi_thread_get_id(FuriThread *thread) { return (FuriThreadId)thread; }
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags)
+{
+    UNUSED(thread_id);
+    stubFlags |= flags;
+    return stubFlags;
+}
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    UNUSED(options);
+    UNUSED(timeout);
+    uint32_t events = stubFlags & flags;
+    stubFlags &= ~events;
+    return events ? events : stubIdleFlags;
+}
+
+// Timers run only when a test fires them
+struct FuriTimer
+{
+    FuriTimerCallback callback;
+    void *context;
+    bool running;
+};
+
+FuriTimer *furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void *context)
+{
+    UNUSED(type);
+    FuriTimer *timer = (FuriTimer *)calloc(1, sizeof(FuriTimer));
+    timer->callback = callback;
+    timer->context = context;
+    return timer;
+}
+void furi_timer_free(FuriTimer *timer) { free(timer); }
+FuriStatus furi_timer_start(FuriTimer *timer, uint32_t ticks)
+{
+    UNUSED(ticks);
+    timer->running = true;
+    return FuriStatusOk;
+}
+FuriStatus furi_timer_restart(FuriTimer *timer, uint32_t ticks) { return furi_timer_start(timer, ticks); }
+FuriStatus furi_timer_stop(FuriTimer *timer)
+{
+    timer->running = false;
+    return FuriStatusOk;
+}
+uint32_t furi_timer_is_running(FuriTimer *timer) { return timer->running; }
+void furi_timer_set_thread_priority(FuriTimerThreadPriority priority) { UNUSED(priority); }
+void furi_stub_fire_timer(FuriTimer *timer)
+{
+    if (timer->running)
+    {
+        timer->running = false;
+        timer->callback(timer->context);
+    }
+}
+
+// Mutexes: one thread, so only misuse is worth catching
+struct FuriMutex
+{
+    bool locked;
+};
+
+FuriMutex *furi_mutex_alloc(FuriMutexType type)
+{
+    UNUSED(type);
+    return (FuriMutex *)calloc(1, sizeof(FuriMutex));
+}
+void furi_mutex_free(FuriMutex *mutex) { free(mutex); }
+FuriStatus furi_mutex_acquire(FuriMutex *mutex, uint32_t timeout)
+{
+    UNUSED(timeout);
+    if (mutex->locked)
+        abort(); // would deadlock on the device
+    mutex->locked = true;
+    return FuriStatusOk;
+}
+FuriStatus furi_mutex_release(FuriMutex *mutex)
+{
+    mutex->locked = false;
+    return FuriStatusOk;
+}
+
+// UART: writes are logged for the test, nothing is ever received on its own
+bool furi_hal_serial_control_is_busy(FuriHalSerialId id)
+{
+    UNUSED(id);
+    return false;
+}
+FuriHalSerialHandle *furi_hal_serial_control_acquire(FuriHalSerialId id)
+{
+    UNUSED(id);
+    return (FuriHalSerialHandle *)stubSerial;
+}
+void furi_hal_serial_control_release(FuriHalSerialHandle *handle) { UNUSED(handle); }
+void furi_hal_serial_init(FuriHalSerialHandle *handle, uint32_t baud)
+{
+    UNUSED(handle);
+    UNUSED(baud);
+}
+void furi_hal_serial_deinit(FuriHalSerialHandle *handle) { UNUSED(handle); }
+void furi_hal_serial_enable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+void furi_hal_serial_disable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+void furi_hal_serial_async_rx_start(FuriHalSerialHandle *handle, FuriHalSerialAsyncRxCallback callback, void *context, bool report_errors)
+{
+    UNUSED(handle);
+    UNUSED(callback);
+    UNUSED(context);
+    UNUSED(report_errors);
+}
+void furi_hal_serial_async_rx_stop(FuriHalSerialHandle *handle) { UNUSED(handle); }
+bool furi_hal_serial_async_rx_available(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+    return false;
+}
+uint8_t furi_hal_serial_async_rx(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+    return 0;
+}
+void furi_hal_serial_tx(FuriHalSerialHandle *handle, const uint8_t *buffer, size_t size)
+{
+    UNUSED(handle);
+    if (size > sizeof(stubSerial) - 1 - stubSerialLen)
+        size = sizeof(stubSerial) - 1 - stubSerialLen;
+    memcpy(stubSerial + stubSerialLen, buffer, size);
+    stubSerialLen += size;
+    stubSerial[stubSerialLen] = '\0';
+}
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle *handle) { UNUSED(handle); }
+const char *furi_stub_serial_written(void) { return stubSerial; }
+void furi_stub_serial_reset(void)
+{
+    stubSerialLen = 0;
+    stubSerial[0] = '\0';
+}
+
+// Storage: files accept every write and read back empty
+struct File
+{
+    bool open;
+};
+
+File *storage_file_alloc(Storage *storage)
+{
+    UNUSED(storage);
+    return (File *)calloc(1, sizeof(File));
+}
+void storage_file_free(File *file) { free(file); }
+bool storage_file_open(File *file, const char *path, FS_AccessMode access_mode, FS_OpenMode open_mode)
+{
+    UNUSED(path);
+    UNUSED(access_mode);
+    UNUSED(open_mode);
+    file->open = true;
+    return true;
+}
+bool storage_file_close(File *file)
+{
+    file->open = false;
+    return true;
+}
+size_t storage_file_read(File *file, void *buffer, size_t size)
+{
+    UNUSED(file);
+    UNUSED(buffer);
+    UNUSED(size);
+    return 0;
+}
+size_t storage_file_write(File *file, const void *buffer, size_t size)
+{
+    UNUSED(buffer);
+    return file->open ? size : 0;
+}
+uint64_t storage_file_size(File *file)
+{
+    UNUSED(file);
+    return 0;
+}
+FS_Error storage_file_get_error(File *file)
+{
+    UNUSED(file);
+    return FSE_OK;
+}
+bool storage_file_exists(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    UNUSED(path);
+    return false;
+}
+bool storage_simply_remove_recursive(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    UNUSED(path);
+    return true;
+}
+
+// Views are not under test
+void view_dispatcher_switch_to_view(ViewDispatcher *view_dispatcher, uint32_t view_id)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+}
+void view_dispatcher_add_view(ViewDispatcher *view_dispatcher, uint32_t view_id, View *view)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+    UNUSED(view);
+}
+void view_dispatcher_remove_view(ViewDispatcher *view_dispatcher, uint32_t view_id)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+}
+Loading *loading_alloc(void) { return NULL; }
+void loading_free(Loading *loading) { UNUSED(loading); }
+View *loading_get_view(Loading *loading)
+{
+    UNUSED(loading);
+    return NULL;
+}
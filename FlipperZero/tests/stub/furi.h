@@ -0,0 +1,114 @@
+#pragma once
+// Host build: just enough of the Flipper SDK for the engine, protocol and FlipperHTTP sources
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+
+#define FURI_LOG_E(tag, ...) ((void)(tag))
+#define FURI_LOG_W(tag, ...) ((void)(tag))
+#define FURI_LOG_I(tag, ...) ((void)(tag))
+#define FURI_LOG_D(tag, ...) ((void)(tag))
+#define UNUSED(x) (void)(x)
+#define furi_check(x) ((void)(x))
+#define furi_assert(x) ((void)(x))
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#define FuriWaitForever 0xFFFFFFFFU
+#define FuriFlagWaitAny 0
+#define FuriFlagError 0x80000000U
+
+    typedef struct FuriString FuriString;
+    typedef struct FuriStreamBuffer FuriStreamBuffer;
+    typedef struct FuriThread FuriThread;
+    typedef void *FuriThreadId;
+    typedef struct FuriTimer FuriTimer;
+    typedef struct FuriMutex FuriMutex;
+    typedef enum
+    {
+        FuriStatusOk = 0,
+        FuriStatusErrorTimeout = -2
+    } FuriStatus;
+    typedef enum
+    {
+        FuriMutexTypeNormal
+    } FuriMutexType;
+    typedef enum
+    {
+        FuriTimerTypeOnce,
+        FuriTimerTypePeriodic
+    } FuriTimerType;
+    typedef enum
+    {
+        FuriTimerThreadPriorityNormal,
+        FuriTimerThreadPriorityElevated
+    } FuriTimerThreadPriority;
+    typedef void (*FuriTimerCallback)(void *context);
+    typedef int32_t (*FuriThreadCallback)(void *context);
+
+    FuriString *furi_string_alloc(void);
+    FuriString *furi_string_alloc_set_str(const char *str);
+    void furi_string_free(FuriString *string);
+    void furi_string_push_back(FuriString *string, char c);
+    void furi_string_reset(FuriString *string);
+    void furi_string_reserve(FuriString *string, size_t size);
+    void furi_string_cat_str(FuriString *string, const char *str);
+    void furi_string_set_n(FuriString *string, const FuriString *source, size_t start, size_t length);
+    void furi_string_right(FuriString *string, size_t start);
+    size_t furi_string_search_str(const FuriString *string, const char *needle, size_t start);
+    const char *furi_string_get_cstr(const FuriString *string);
+
+    FuriStreamBuffer *furi_stream_buffer_alloc(size_t size, size_t trigger_level);
+    void furi_stream_buffer_free(FuriStreamBuffer *stream);
+    size_t furi_stream_buffer_send(FuriStreamBuffer *stream, const void *data, size_t length, uint32_t timeout);
+    size_t furi_stream_buffer_receive(FuriStreamBuffer *stream, void *data, size_t length, uint32_t timeout);
+    bool furi_stream_buffer_is_empty(FuriStreamBuffer *stream);
+    size_t furi_stream_buffer_spaces_available(FuriStreamBuffer *stream);
+
+    FuriThread *furi_thread_alloc(void);
+    void furi_thread_set_name(FuriThread *thread, const char *name);
+    void furi_thread_set_stack_size(FuriThread *thread, size_t size);
+    void furi_thread_set_context(FuriThread *thread, void *context);
+    void furi_thread_set_callback(FuriThread *thread, FuriThreadCallback callback);
+    void furi_thread_start(FuriThread *thread);
+    bool furi_thread_join(FuriThread *thread);
+    void furi_thread_free(FuriThread *thread);
+    FuriThreadId furi_thread_get_id(FuriThread *thread);
+    uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags);
+    uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+    FuriTimer *furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void *context);
+    void furi_timer_free(FuriTimer *timer);
+    FuriStatus furi_timer_start(FuriTimer *timer, uint32_t ticks);
+    FuriStatus furi_timer_restart(FuriTimer *timer, uint32_t ticks);
+    FuriStatus furi_timer_stop(FuriTimer *timer);
+    uint32_t furi_timer_is_running(FuriTimer *timer);
+    void furi_timer_set_thread_priority(FuriTimerThreadPriority priority);
+
+    FuriMutex *furi_mutex_alloc(FuriMutexType type);
+    void furi_mutex_free(FuriMutex *mutex);
+    FuriStatus furi_mutex_acquire(FuriMutex *mutex, uint32_t timeout);
+    FuriStatus furi_mutex_release(FuriMutex *mutex);
+
+    uint32_t furi_get_tick(void);
+    uint32_t furi_ms_to_ticks(uint32_t ms);
+    void furi_delay_ms(uint32_t ms);
+    void *furi_record_open(const char *name);
+    void furi_record_close(const char *name);
+    size_t memmgr_heap_get_max_free_block(void);
+
+    // Host only: the tests play the scheduler. Threads never run on their own; a test calls the
+    // thread function itself, which sees the flags set so far and then the idle flags.
+    void furi_stub_set_idle_flags(uint32_t flags); // returned by furi_thread_flags_wait once nothing is pending
+    void furi_stub_fire_timer(FuriTimer *timer);   // runs a started timer's callback now
+    void furi_stub_advance_ms(uint32_t ms);        // moves furi_get_tick forward (1 tick per ms)
+#ifdef __cplusplus
+}
+#endif
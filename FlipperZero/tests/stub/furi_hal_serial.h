@@ -0,0 +1,47 @@
+#pragma once
+#include <furi.h>
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    typedef struct FuriHalSerialHandle FuriHalSerialHandle;
+    typedef enum
+    {
+        FuriHalSerialIdUsart,
+        FuriHalSerialIdLpuart
+    } FuriHalSerialId;
+    typedef enum
+    {
+        FuriHalSerialDirectionTx,
+        FuriHalSerialDirectionRx
+    } FuriHalSerialDirection;
+    typedef enum
+    {
+        FuriHalSerialRxEventData = (1 << 0),
+        FuriHalSerialRxEventIdle = (1 << 1),
+        FuriHalSerialRxEventFrameError = (1 << 2),
+        FuriHalSerialRxEventNoiseError = (1 << 3),
+        FuriHalSerialRxEventOverrunError = (1 << 4)
+    } FuriHalSerialRxEvent;
+    typedef void (*FuriHalSerialAsyncRxCallback)(FuriHalSerialHandle *handle, FuriHalSerialRxEvent event, void *context);
+
+    bool furi_hal_serial_control_is_busy(FuriHalSerialId id);
+    FuriHalSerialHandle *furi_hal_serial_control_acquire(FuriHalSerialId id);
+    void furi_hal_serial_control_release(FuriHalSerialHandle *handle);
+    void furi_hal_serial_init(FuriHalSerialHandle *handle, uint32_t baud);
+    void furi_hal_serial_deinit(FuriHalSerialHandle *handle);
+    void furi_hal_serial_enable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction);
+    void furi_hal_serial_disable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction);
+    void furi_hal_serial_async_rx_start(FuriHalSerialHandle *handle, FuriHalSerialAsyncRxCallback callback, void *context, bool report_errors);
+    void furi_hal_serial_async_rx_stop(FuriHalSerialHandle *handle);
+    bool furi_hal_serial_async_rx_available(FuriHalSerialHandle *handle);
+    uint8_t furi_hal_serial_async_rx(FuriHalSerialHandle *handle);
+    void furi_hal_serial_tx(FuriHalSerialHandle *handle, const uint8_t *buffer, size_t size);
+    void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle *handle);
+
+    // Host only: everything written to the UART since the last reset, NUL-terminated
+    const char *furi_stub_serial_written(void);
+    void furi_stub_serial_reset(void);
+#ifdef __cplusplus
+}
+#endif
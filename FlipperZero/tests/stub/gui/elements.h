@@ -0,0 +1,10 @@
+#pragma once
+#include <gui/gui.h>
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    void elements_multiline_text(Canvas *canvas, int32_t x, int32_t y, const char *text);
+#ifdef __cplusplus
+}
+#endif
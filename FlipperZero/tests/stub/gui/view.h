@@ -0,0 +1,4 @@
+#pragma once
+#include <gui/gui.h>
+
+typedef struct View View;
@@ -0,0 +1,13 @@
+#pragma once
+#include <gui/view.h>
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    typedef struct ViewDispatcher ViewDispatcher;
+    void view_dispatcher_switch_to_view(ViewDispatcher *view_dispatcher, uint32_t view_id);
+    void view_dispatcher_add_view(ViewDispatcher *view_dispatcher, uint32_t view_id, View *view);
+    void view_dispatcher_remove_view(ViewDispatcher *view_dispatcher, uint32_t view_id);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+#include <furi.h>
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#define RECORD_STORAGE "storage"
+#define STORAGE_EXT_PATH_PREFIX "/ext"
+    typedef struct Storage Storage;
+    typedef struct File File;
+    typedef enum
+    {
+        FSAM_READ = 1,
+        FSAM_WRITE = 2,
+        FSAM_READ_WRITE = 3
+    } FS_AccessMode;
+    typedef enum
+    {
+        FSOM_OPEN_EXISTING = 1,
+        FSOM_OPEN_ALWAYS = 2,
+        FSOM_OPEN_APPEND = 4,
+        FSOM_CREATE_NEW = 8,
+        FSOM_CREATE_ALWAYS = 16
+    } FS_OpenMode;
+    typedef enum
+    {
+        FSE_OK = 0
+    } FS_Error;
+
+    File *storage_file_alloc(Storage *storage);
+    void storage_file_free(File *file);
+    bool storage_file_open(File *file, const char *path, FS_AccessMode access_mode, FS_OpenMode open_mode);
+    bool storage_file_close(File *file);
+    size_t storage_file_read(File *file, void *buffer, size_t size);
+    size_t storage_file_write(File *file, const void *buffer, size_t size);
+    uint64_t storage_file_size(File *file);
+    FS_Error storage_file_get_error(File *file);
+    bool storage_file_exists(Storage *storage, const char *path);
+    bool storage_simply_remove_recursive(Storage *storage, const char *path);
+#ifdef __cplusplus
+}
+#endif
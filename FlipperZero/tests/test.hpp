@@ -0,0 +1,32 @@
+#pragma once
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Minimal check harness: a failed CHECK reports itself and fails the run, the test keeps going
+extern int testFailures;
+
+#define CHECK(cond)                                                       \
+    do                                                                    \
+    {                                                                     \
+        if (!(cond))                                                      \
+        {                                                                 \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            testFailures++;                                               \
+        }                                                                 \
+    } while (0)
+
+void testHttp(void);          // FlipperHTTP: direct and queued requests share the line
+void testInterpolation(void); // remote motion: snapping, blending and the prediction horizon
+void testJson(void);          // JSON writer and streaming parser
+void testLevel(void);         // net id map: lookups across erase and reinsert
+void testLink(void);          // link controller: lost pings and peer resets
+void testLockstep(void);      // lockstep: input ring, stalls and checksums
+void testProtocol(void);      // record codec and sequence wrap
+
+#ifdef __cplusplus
+}
+#endif
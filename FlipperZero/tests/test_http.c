@@ -0,0 +1,118 @@
+#include "test.hpp"
+// The worker and the response handlers are static, so the test is built into the same unit
+#include "flipper_http/flipper_http.c"
+
+typedef struct
+{
+    int calls;
+    FlipperHTTPRequestResult result;
+    char body[32];
+} QueuedResult;
+
+static void queuedDone(const FlipperHTTPResponse *response, void *context)
+{
+    QueuedResult *done = (QueuedResult *)context;
+    done->calls++;
+    done->result = response->result;
+    snprintf(done->body, sizeof(done->body), "%s", response->body ? response->body : "");
+}
+
+// Let the worker handle everything signalled so far, then stop it
+static void runWorker(FlipperHTTP *fhttp)
+{
+    furi_stub_set_idle_flags(WorkerEvtStop);
+    flipper_http_worker(fhttp);
+}
+
+// The board answers: the bytes arrive the way the UART ISR would queue them
+static void boardSends(FlipperHTTP *fhttp, const char *text)
+{
+    furi_stream_buffer_send(fhttp->flipper_http_stream, text, strlen(text), 0);
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtRxDone);
+    runWorker(fhttp);
+}
+
+static bool lineBusy(FlipperHTTP *fhttp)
+{
+    furi_mutex_acquire(fhttp->queue_mutex, FuriWaitForever);
+    bool busy = fhttp->line_busy;
+    furi_mutex_release(fhttp->queue_mutex);
+    return busy;
+}
+
+static void testDirectThenQueued(FlipperHTTP *fhttp)
+{
+    QueuedResult done = {0};
+    furi_stub_serial_reset();
+    snprintf(fhttp->file_path, sizeof(fhttp->file_path), "/ext/direct.txt");
+
+    // the send itself leaves state IDLE; the line must stay claimed regardless
+    CHECK(flipper_http_request(fhttp, GET, "http://direct", NULL, NULL));
+    CHECK(fhttp->state == IDLE);
+    CHECK(lineBusy(fhttp));
+    CHECK(furi_timer_is_running(fhttp->get_timeout_timer));
+
+    CHECK(flipper_http_queue_request(fhttp, GET, "http://queued", NULL, NULL, "/ext/queued.txt", 64, 1000, queuedDone, &done));
+    runWorker(fhttp);
+    CHECK(strstr(furi_stub_serial_written(), "[GET]http://direct") != NULL);
+    CHECK(strstr(furi_stub_serial_written(), "http://queued") == NULL);
+    CHECK(fhttp->queue_current == NULL);
+
+    // nothing else may start on the line either
+    CHECK(!flipper_http_request(fhttp, GET, "http://other", NULL, NULL));
+    CHECK(!flipper_http_websocket_start(fhttp, "ws://other", 80, NULL));
+
+    // the direct answer ends: the queued request goes out behind it
+    boardSends(fhttp, "[GET/SUCCESS]{\"Status-Code\":200,\"Content-Length\":2}\nok\n[GET/END]\n");
+    CHECK(strstr(furi_stub_serial_written(), "[GET]http://queued") != NULL);
+    CHECK(fhttp->queue_current != NULL);
+    CHECK(lineBusy(fhttp));
+
+    // and owns the line the same way, whatever state says
+    CHECK(fhttp->state != RECEIVING);
+    CHECK(!flipper_http_request(fhttp, GET, "http://other", NULL, NULL));
+    CHECK(strstr(furi_stub_serial_written(), "http://other") == NULL);
+
+    boardSends(fhttp, "[GET/SUCCESS]{\"Status-Code\":200,\"Content-Length\":5}\nhello\n[GET/END]\n");
+    CHECK(!lineBusy(fhttp));
+    CHECK(flipper_http_queue_poll(fhttp) == 1);
+    CHECK(done.calls == 1);
+    CHECK(done.result == FlipperHTTPRequestOk);
+    CHECK(strcmp(done.body, "hello") == 0);
+}
+
+static void testDirectTimeout(FlipperHTTP *fhttp)
+{
+    furi_stub_serial_reset();
+
+    // the board never answers: the timeout hands the line back
+    CHECK(flipper_http_request(fhttp, GET, "http://silent", NULL, NULL));
+    CHECK(lineBusy(fhttp));
+    furi_stub_fire_timer(fhttp->get_timeout_timer);
+    runWorker(fhttp);
+    CHECK(!lineBusy(fhttp));
+
+    // a late answer may still come, so the next request waits out the drain time
+    CHECK(fhttp->queue_draining);
+    CHECK(!flipper_http_request(fhttp, GET, "http://next", NULL, NULL));
+    furi_stub_advance_ms(HTTP_QUEUE_DRAIN_MS);
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtQueue);
+    runWorker(fhttp);
+    CHECK(!fhttp->queue_draining);
+    CHECK(flipper_http_request(fhttp, GET, "http://next", NULL, NULL));
+    boardSends(fhttp, "[ERROR] not found\n");
+    CHECK(!lineBusy(fhttp));
+}
+
+void testHttp(void)
+{
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    CHECK(fhttp != NULL);
+    if (!fhttp)
+    {
+        return;
+    }
+    testDirectThenQueued(fhttp);
+    testDirectTimeout(fhttp);
+    flipper_http_free(fhttp);
+}
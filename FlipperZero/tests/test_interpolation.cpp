@@ -0,0 +1,83 @@
+#include "test.hpp"
+#include "run/interpolation.hpp"
+#include <math.h>
+
+static bool near(Vector v, float x, float y)
+{
+    return fabsf(v.x - x) < 0.001f && fabsf(v.y - y) < 0.001f;
+}
+
+static void testNoHistory()
+{
+    // nothing but the spawn position: it stays put however late it is drawn
+    NetMotion motion;
+    netMotionReset(&motion, Vector(10, 20), 1000);
+    CHECK(near(netMotionSample(&motion, 1000), 10, 20));
+    CHECK(near(netMotionSample(&motion, 1000 + 10 * NET_MOTION_MAX_EXTRAPOLATION_MS), 10, 20));
+
+    // one update after a stall gives a position but no velocity to extrapolate with
+    netMotionPush(&motion, Vector(10, 20), Vector(14, 20), 1000 + NET_MOTION_MAX_INTERVAL_MS + 1);
+    CHECK(motion.velocity.x == 0 && motion.velocity.y == 0);
+    CHECK(near(netMotionSample(&motion, 1000 + 3 * NET_MOTION_MAX_INTERVAL_MS), 14, 20));
+}
+
+static void testSnap()
+{
+    NetMotion motion;
+    netMotionReset(&motion, Vector(0, 0), 0);
+
+    // at the snap distance the correction still glides
+    netMotionPush(&motion, Vector(0, 0), Vector(NET_MOTION_SNAP_DISTANCE, 0), 100);
+    CHECK(near(netMotionSample(&motion, 100), 0, 0));
+
+    // past it (a respawn, a level change) the entity jumps and forgets its velocity
+    netMotionPush(&motion, Vector(0, 0), Vector(0, NET_MOTION_SNAP_DISTANCE + 1), 200);
+    CHECK(near(netMotionSample(&motion, 200), 0, NET_MOTION_SNAP_DISTANCE + 1));
+    CHECK(near(netMotionSample(&motion, 900), 0, NET_MOTION_SNAP_DISTANCE + 1));
+}
+
+static void testBlend()
+{
+    // two updates 100 ms apart: 0.1 px/ms, corrected over half the interval
+    NetMotion motion;
+    netMotionReset(&motion, Vector(0, 0), 0);
+    netMotionPush(&motion, Vector(0, 0), Vector(10, 0), 100);
+    CHECK(motion.blendMs == 50 && motion.horizonMs == 100);
+
+    CHECK(near(netMotionSample(&motion, 100), 0, 0));    // still drawn where it was
+    CHECK(near(netMotionSample(&motion, 125), 6.25f, 0)); // halfway from 0 onto the path at 12.5
+    CHECK(near(netMotionSample(&motion, 150), 15, 0));    // on the predicted path
+
+    // a late update blends from where the entity was drawn, not from the old target
+    netMotionPush(&motion, Vector(15, 0), Vector(20, 0), 200);
+    CHECK(near(netMotionSample(&motion, 200), 15, 0));
+    CHECK(near(netMotionSample(&motion, 250), 25, 0));
+}
+
+static void testHorizon()
+{
+    // prediction stops one update interval after the last update
+    NetMotion motion;
+    netMotionReset(&motion, Vector(0, 0), 0);
+    netMotionPush(&motion, Vector(0, 0), Vector(0, 10), 100);
+    CHECK(near(netMotionSample(&motion, 200), 0, 20));
+    CHECK(near(netMotionSample(&motion, 5000), 0, 20));
+
+    // a slow link predicts no further than the extrapolation limit, and blends no longer than the blend limit
+    const uint32_t interval = NET_MOTION_MAX_EXTRAPOLATION_MS + 500;
+    netMotionReset(&motion, Vector(0, 0), 0);
+    netMotionPush(&motion, Vector(0, 0), Vector(30, 0), interval);
+    CHECK(motion.horizonMs == NET_MOTION_MAX_EXTRAPOLATION_MS);
+    CHECK(motion.blendMs == NET_MOTION_MAX_BLEND_MS);
+    float limit = 30 + 30.0f / interval * NET_MOTION_MAX_EXTRAPOLATION_MS;
+    CHECK(near(netMotionSample(&motion, interval + NET_MOTION_MAX_EXTRAPOLATION_MS), limit, 0));
+    CHECK(near(netMotionSample(&motion, interval + 10 * NET_MOTION_MAX_EXTRAPOLATION_MS), limit, 0));
+}
+
+void testInterpolation()
+{
+    testNoHistory();
+    testSnap();
+    testBlend();
+    testHorizon();
+}
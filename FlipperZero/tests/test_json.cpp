@@ -0,0 +1,174 @@
+#include "test.hpp"
+#include <string.h>
+#include "jsmn/jsmn_stream.h"
+#include "jsmn/jsmn_writer.h"
+
+static void testWriterValues()
+{
+    char buffer[128];
+    JsonWriter writer;
+    json_writer_init(&writer, buffer, sizeof(buffer));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "s");
+    json_writer_string(&writer, "a\"b\\c\n");
+    json_writer_key(&writer, "i");
+    json_writer_int(&writer, -42);
+    json_writer_key(&writer, "u");
+    json_writer_uint(&writer, 4000000000u);
+    json_writer_key(&writer, "f");
+    json_writer_fixed(&writer, -1.25f, 1);
+    json_writer_key(&writer, "z");
+    json_writer_fixed(&writer, 0.04f, 1);
+    json_writer_key(&writer, "a");
+    json_writer_array_start(&writer);
+    json_writer_bool(&writer, true);
+    json_writer_bool(&writer, false);
+    json_writer_raw(&writer, "{}", 2);
+    json_writer_array_end(&writer);
+    json_writer_object_end(&writer);
+    const char *json = json_writer_finish(&writer);
+    CHECK(json != NULL);
+    CHECK(json && strcmp(json, "{\"s\":\"a\\\"b\\\\c\\n\",\"i\":-42,\"u\":4000000000,\"f\":-1.3,\"z\":0.0,\"a\":[true,false,{}]}") == 0);
+    CHECK(json_writer_length(&writer) == strlen(buffer));
+}
+
+static void testWriterNested()
+{
+    // an object written inside a caller's wrapper, the way sendEntityKeyframe wraps entityToJson
+    char buffer[96];
+    JsonWriter writer;
+    json_writer_init(&writer, buffer, sizeof(buffer));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "type");
+    json_writer_string(&writer, "player");
+    json_writer_key(&writer, "data");
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "u");
+    json_writer_string(&writer, "tester");
+    json_writer_object_end(&writer);
+
+    // the inner object is complete but the wrapper is not: fine so far, not finished yet
+    CHECK(json_writer_ok(&writer));
+    CHECK(json_writer_finish(&writer) == NULL);
+
+    json_writer_object_end(&writer);
+    const char *json = json_writer_finish(&writer);
+    CHECK(json && strcmp(json, "{\"type\":\"player\",\"data\":{\"u\":\"tester\"}}") == 0);
+}
+
+static void testWriterOverflow()
+{
+    char buffer[16];
+    JsonWriter writer;
+    json_writer_init(&writer, buffer, sizeof(buffer));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "name");
+    json_writer_string(&writer, "much too long for the buffer");
+    json_writer_object_end(&writer);
+    CHECK(!json_writer_ok(&writer));
+    CHECK(json_writer_finish(&writer) == NULL);
+    CHECK(strlen(buffer) < sizeof(buffer)); // still terminated
+
+    // a key without its value, or a close without an open, is invalid
+    json_writer_init(&writer, buffer, sizeof(buffer));
+    json_writer_object_start(&writer);
+    json_writer_key(&writer, "k");
+    json_writer_object_end(&writer);
+    CHECK(!json_writer_ok(&writer));
+    json_writer_init(&writer, buffer, sizeof(buffer));
+    json_writer_array_end(&writer);
+    CHECK(!json_writer_ok(&writer));
+}
+
+struct StreamEvent
+{
+    JsonStreamEvent event;
+    char path[JSON_STREAM_MAX_PATH];
+    char value[JSON_STREAM_MAX_VALUE];
+};
+
+struct StreamLog
+{
+    StreamEvent events[32];
+    int count;
+};
+
+static void streamCollect(void *context, JsonStreamEvent event, const char *path, const char *value, size_t value_len)
+{
+    StreamLog *log = (StreamLog *)context;
+    if (log->count >= 32)
+        return;
+    StreamEvent *entry = &log->events[log->count++];
+    entry->event = event;
+    snprintf(entry->path, sizeof(entry->path), "%s", path ? path : "<null>");
+    snprintf(entry->value, sizeof(entry->value), "%.*s", (int)value_len, value ? value : "");
+}
+
+static const StreamEvent *streamFind(const StreamLog *log, JsonStreamEvent event, const char *path)
+{
+    for (int i = 0; i < log->count; i++)
+    {
+        if (log->events[i].event == event && strcmp(log->events[i].path, path) == 0)
+            return &log->events[i];
+    }
+    return nullptr;
+}
+
+static void testStreamPaths()
+{
+    const char *json = "{\"username\":\"tester\",\"game_stats\":{\"xp\":120,\"alive\":true},"
+                       "\"lobbies\":[{\"id\":\"a\\\"b\"},{\"id\":\"c\"},{\"id\":\"d\"}]}";
+    // every split point must give the same events
+    for (size_t split = 0; split <= strlen(json); split += 7)
+    {
+        StreamLog log = {};
+        JsonStream stream;
+        json_stream_init(&stream, streamCollect, &log);
+        CHECK(json_stream_feed(&stream, json, split));
+        CHECK(json_stream_feed(&stream, json + split, strlen(json) - split));
+        CHECK(json_stream_finish(&stream));
+
+        const StreamEvent *event = streamFind(&log, JSON_STREAM_STRING, "username");
+        CHECK(event && strcmp(event->value, "tester") == 0);
+        event = streamFind(&log, JSON_STREAM_PRIMITIVE, "game_stats.xp");
+        CHECK(event && strcmp(event->value, "120") == 0);
+        event = streamFind(&log, JSON_STREAM_PRIMITIVE, "game_stats.alive");
+        CHECK(event && strcmp(event->value, "true") == 0);
+        CHECK(streamFind(&log, JSON_STREAM_OBJECT_END, "game_stats") != nullptr);
+        event = streamFind(&log, JSON_STREAM_STRING, "lobbies[0].id");
+        CHECK(event && strcmp(event->value, "a\"b") == 0);
+        event = streamFind(&log, JSON_STREAM_STRING, "lobbies[2].id");
+        CHECK(event && strcmp(event->value, "d") == 0);
+        CHECK(streamFind(&log, JSON_STREAM_ARRAY_END, "lobbies") != nullptr);
+    }
+}
+
+static void testStreamErrors()
+{
+    StreamLog log = {};
+    JsonStream stream;
+    json_stream_init(&stream, streamCollect, &log);
+    CHECK(!json_stream_feed(&stream, "{\"a\":}", 6));
+
+    // an unfinished document does not finish
+    json_stream_init(&stream, streamCollect, &log);
+    CHECK(json_stream_feed(&stream, "{\"a\":[1,2", 9));
+    CHECK(!json_stream_finish(&stream));
+
+    // nesting past the fixed depth is refused instead of overrunning the state arrays
+    char deep[2 * JSON_STREAM_MAX_DEPTH + 3];
+    size_t len = 0;
+    for (int i = 0; i <= JSON_STREAM_MAX_DEPTH; i++)
+        deep[len++] = '[';
+    json_stream_init(&stream, streamCollect, &log);
+    CHECK(!json_stream_feed(&stream, deep, len));
+}
+
+void testJson()
+{
+    testWriterValues();
+    testWriterNested();
+    testWriterOverflow();
+    testStreamPaths();
+    testStreamErrors();
+}
@@ -0,0 +1,148 @@
+#include "test.hpp"
+#include "engine/game.hpp"
+
+// Same hash as Level's net_map_home, so the test can build probe runs that collide on purpose
+static int homeSlot(uint16_t netId)
+{
+    return (int)(((uint32_t)netId * 40503u) >> 10) & (LEVEL_NET_MAP_SIZE - 1);
+}
+
+static Entity *makeEnemy(uint16_t netId)
+{
+    Entity *entity = new Entity("enemy", ENTITY_ENEMY, Vector(0, 0), Vector(10, 10), nullptr);
+    entity->net_id = netId; // 0: the level numbers it in spawn order
+    return entity;
+}
+
+static void testSpawnOrder(Level *level)
+{
+    Entity *first = makeEnemy(0);
+    Entity *second = makeEnemy(0);
+    level->entity_add(first);
+    level->entity_add(second);
+    CHECK(first->net_id == 1);
+    CHECK(second->net_id == 2);
+    CHECK(level->entity_find(1) == first);
+    CHECK(level->entity_find(2) == second);
+    CHECK(level->entity_find(0) == nullptr);
+    CHECK(level->entity_find(3) == nullptr);
+
+    level->clear();
+    CHECK(level->entity_find(1) == nullptr);
+    Entity *again = makeEnemy(0);
+    level->entity_add(again);
+    CHECK(again->net_id == 1); // a cleared level numbers from the start again
+    level->clear();
+}
+
+static void testEraseReinsert(Level *level)
+{
+    // ids sharing one home slot form a single probe run; erasing from its head or middle
+    // must shift the rest back so none of them becomes unreachable
+    const int home = homeSlot(0x4000);
+    uint16_t run[5];
+    int found = 0;
+    for (uint32_t id = 0x4000; id <= UINT16_MAX && found < 5; id++)
+    {
+        if (homeSlot((uint16_t)id) == home)
+            run[found++] = (uint16_t)id;
+    }
+    CHECK(found == 5);
+    // a neighbour whose home is the next slot gets pushed behind the run
+    uint16_t neighbour = 0;
+    for (uint32_t id = 0x6000; id <= UINT16_MAX && neighbour == 0; id++)
+    {
+        if (homeSlot((uint16_t)id) == ((home + 1) & (LEVEL_NET_MAP_SIZE - 1)))
+            neighbour = (uint16_t)id;
+    }
+    CHECK(neighbour != 0);
+
+    Entity *entities[5];
+    for (int i = 0; i < 5; i++)
+    {
+        entities[i] = makeEnemy(run[i]);
+        level->entity_add(entities[i]);
+    }
+    Entity *pushed = makeEnemy(neighbour);
+    level->entity_add(pushed);
+    for (int i = 0; i < 5; i++)
+        CHECK(level->entity_find(run[i]) == entities[i]);
+    CHECK(level->entity_find(neighbour) == pushed);
+
+    // erase the head, then one from the middle
+    level->entity_remove(entities[0]);
+    level->entity_remove(entities[2]);
+    CHECK(level->entity_find(run[0]) == nullptr);
+    CHECK(level->entity_find(run[2]) == nullptr);
+    CHECK(level->entity_find(run[1]) == entities[1]);
+    CHECK(level->entity_find(run[3]) == entities[3]);
+    CHECK(level->entity_find(run[4]) == entities[4]);
+    CHECK(level->entity_find(neighbour) == pushed);
+
+    // reinsert under the erased ids
+    entities[0] = makeEnemy(run[0]);
+    entities[2] = makeEnemy(run[2]);
+    level->entity_add(entities[2]);
+    level->entity_add(entities[0]);
+    for (int i = 0; i < 5; i++)
+        CHECK(level->entity_find(run[i]) == entities[i]);
+    CHECK(level->entity_find(neighbour) == pushed);
+
+    // erase everything in a scrambled order
+    const int order[] = {3, 0, 4, 1, 2};
+    for (int i = 0; i < 5; i++)
+    {
+        level->entity_remove(entities[order[i]]);
+        CHECK(level->entity_find(run[order[i]]) == nullptr);
+        for (int j = i + 1; j < 5; j++)
+            CHECK(level->entity_find(run[order[j]]) == entities[order[j]]);
+        CHECK(level->entity_find(neighbour) == pushed);
+    }
+    level->entity_remove(pushed);
+    CHECK(level->entity_find(neighbour) == nullptr);
+}
+
+static void testChurn(Level *level)
+{
+    // many erase/reinsert rounds near the load limit must keep every live id reachable
+    const int live = LEVEL_NET_MAP_MAX_LOAD;
+    Entity *entities[live];
+    for (int i = 0; i < live; i++)
+    {
+        entities[i] = makeEnemy((uint16_t)(1 + i * 7));
+        level->entity_add(entities[i]);
+    }
+    uint16_t nextId = 1000;
+    for (int round = 0; round < 200; round++)
+    {
+        int slot = (round * 13) % live;
+        level->entity_remove(entities[slot]);
+        entities[slot] = makeEnemy(nextId++);
+        level->entity_add(entities[slot]);
+        if (round % 20 == 0)
+        {
+            for (int i = 0; i < live; i++)
+                CHECK(level->entity_find(entities[i]->net_id) == entities[i]);
+        }
+    }
+    for (int i = 0; i < live; i++)
+        CHECK(level->entity_find(entities[i]->net_id) == entities[i]);
+
+    // one more than the map indexes: it joins the level but is not found by id
+    Entity *extra = makeEnemy(60000);
+    level->entity_add(extra);
+    CHECK(level->entity_find(60000) == nullptr);
+    CHECK(level->getEntityCount() == live + 1);
+    level->clear();
+}
+
+void testLevel()
+{
+    Draw draw(nullptr);
+    Game game("test", Vector(128, 64), &draw);
+    Level *level = new Level("test", Vector(128, 64), &game);
+    testSpawnOrder(level);
+    testEraseReinsert(level);
+    testChurn(level);
+    delete level;
+}
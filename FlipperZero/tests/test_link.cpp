@@ -0,0 +1,71 @@
+#include "test.hpp"
+#include "run/link.hpp"
+
+static const size_t QUEUE_CAPACITY = 16;
+
+// Send a ping at tick and let it time out, closing every window on the way
+static uint32_t losePing(NetLinkStats *link, uint32_t tick, size_t peers)
+{
+    netLinkOnPing(link, tick);
+    uint32_t end = tick + NET_LINK_PING_TIMEOUT_MS + NET_LINK_WINDOW_MS;
+    for (uint32_t t = tick + NET_LINK_WINDOW_MS; t <= end; t += NET_LINK_WINDOW_MS)
+        netLinkUpdate(link, 0, QUEUE_CAPACITY, peers, t);
+    return end;
+}
+
+static void testAlone()
+{
+    // nobody echoes a ping in an empty level; that must not read as congestion
+    NetLinkStats link;
+    netLinkInit(&link, 1000);
+    uint32_t tick = 1000;
+    for (int i = 0; i < 5; i++)
+        tick = losePing(&link, tick, 0);
+    CHECK(!link.congested);
+    CHECK(link.syncIntervalMs < NET_LINK_SYNC_DEFAULT_MS);
+}
+
+static void testLostPing()
+{
+    NetLinkStats link;
+    netLinkInit(&link, 1000);
+    netLinkOnPing(&link, 1000);
+    CHECK(netLinkOnPong(&link, 1000, 1040));
+    CHECK(link.rttMs == 40);
+    CHECK(!netLinkOnPong(&link, 1000, 1050)); // already answered
+
+    // once a peer has answered, a timeout is a lost ping
+    uint32_t interval = link.syncIntervalMs;
+    losePing(&link, 3000, 1);
+    CHECK(link.congested);
+    CHECK(link.syncIntervalMs > interval);
+}
+
+static void testPeersLeave()
+{
+    NetLinkStats link;
+    netLinkInit(&link, 1000);
+    netLinkOnPing(&link, 1000);
+    CHECK(netLinkOnPong(&link, 1000, 1040));
+    uint32_t tick = losePing(&link, 3000, 1);
+    CHECK(link.syncIntervalMs > NET_LINK_SYNC_DEFAULT_MS);
+    netLinkOnDropped(&link);
+
+    // the last peer leaves: defaults again, the cumulative counters survive
+    netLinkUpdate(&link, 0, QUEUE_CAPACITY, 0, tick + 1);
+    CHECK(link.syncIntervalMs == NET_LINK_SYNC_DEFAULT_MS);
+    CHECK(link.pacingMs == NET_LINK_PACING_DEFAULT_MS);
+    CHECK(link.rttMs == 0 && link.rttMinMs == 0);
+    CHECK(link.drops == 1);
+
+    // and pings go unanswered without counting until a new peer answers
+    losePing(&link, tick + 1, 0);
+    CHECK(!link.congested);
+}
+
+void testLink()
+{
+    testAlone();
+    testLostPing();
+    testPeersLeave();
+}
@@ -0,0 +1,170 @@
+#include "test.hpp"
+#include "run/lockstep.hpp"
+#include "engine/entity.hpp"
+
+static const uint16_t PLAYER_A = 300;
+static const uint16_t PLAYER_B = 20;
+static const uint8_t SESSION = 5;
+static const uint8_t IDLE = 0;
+
+// Distinct non-idle press for every tick, so a misplaced input shows
+static uint8_t press(uint32_t tick, int slot)
+{
+    return (uint8_t)((tick * 3 + slot) % 15 + 1);
+}
+
+// Hand one peer's due batch to the other, the way the record would travel
+static void deliver(NetLockstep *from, uint16_t fromId, NetLockstep *to)
+{
+    uint16_t firstTick = 0;
+    uint8_t inputs[NET_INPUT_MAX_TICKS];
+    uint8_t count = netLockstepOutgoing(from, &firstTick, inputs, sizeof(inputs));
+    if (count > 0)
+        CHECK(netLockstepOnInputs(to, fromId, from->session, firstTick, inputs, count));
+}
+
+static void testStart()
+{
+    NetLockstep ls;
+    const uint16_t players[] = {PLAYER_A, PLAYER_B};
+    CHECK(!netLockstepStart(&ls, players, 2, 999, SESSION, IDLE)); // not one of the players
+    CHECK(!ls.active);
+
+    CHECK(netLockstepStart(&ls, players, 2, PLAYER_A, SESSION, IDLE));
+    CHECK(ls.players[0] == PLAYER_B && ls.players[1] == PLAYER_A); // simulated in id order
+    CHECK(ls.localSlot == 1);
+    CHECK(netLockstepSlot(&ls, PLAYER_B) == 0);
+    CHECK(netLockstepSlot(&ls, 999) == -1);
+
+    // the first ticks need nobody's input
+    for (uint32_t t = 0; t < NET_LOCKSTEP_INPUT_DELAY; t++)
+    {
+        netLockstepLocalInput(&ls, IDLE);
+        CHECK(netLockstepReady(&ls));
+        netLockstepAdvance(&ls);
+    }
+    netLockstepLocalInput(&ls, IDLE);
+    CHECK(!netLockstepReady(&ls));
+
+    // foreign batches are refused
+    const uint8_t inputs[] = {1, 2};
+    CHECK(!netLockstepOnInputs(&ls, PLAYER_B, SESSION + 1, 8, inputs, 2));
+    CHECK(!netLockstepOnInputs(&ls, 999, SESSION, 8, inputs, 2));
+    CHECK(!netLockstepOnInputs(&ls, PLAYER_A, SESSION, 8, inputs, 2)); // our own slot
+}
+
+static void testRingWrap()
+{
+    // two peers run several times round the input ring, exchanging only their batches
+    NetLockstep a, b;
+    const uint16_t players[] = {PLAYER_A, PLAYER_B};
+    CHECK(netLockstepStart(&a, players, 2, PLAYER_A, SESSION, IDLE));
+    CHECK(netLockstepStart(&b, players, 2, PLAYER_B, SESSION, IDLE));
+
+    const uint32_t target = NET_LOCKSTEP_WINDOW * 4 + 3;
+    int frames = 0;
+    bool matched = true;
+    while ((a.tick < target || b.tick < target) && frames++ < 4000)
+    {
+        netLockstepLocalInput(&a, press(a.tick, a.localSlot));
+        netLockstepLocalInput(&b, press(b.tick, b.localSlot));
+        deliver(&a, PLAYER_A, &b);
+        deliver(&b, PLAYER_B, &a);
+
+        // the same tick must see the same inputs on both devices, each pressed delay - 1 frames before
+        if (netLockstepReady(&a) && a.tick < target)
+        {
+            const uint8_t *inputs = netLockstepTickInputs(&a);
+            if (a.tick >= NET_LOCKSTEP_INPUT_DELAY)
+            {
+                uint32_t pressed = a.tick - (NET_LOCKSTEP_INPUT_DELAY - 1);
+                matched &= inputs[0] == press(pressed, 0) && inputs[1] == press(pressed, 1);
+            }
+            netLockstepAdvance(&a);
+        }
+        if (netLockstepReady(&b) && b.tick < target)
+        {
+            const uint8_t *inputs = netLockstepTickInputs(&b);
+            if (b.tick >= NET_LOCKSTEP_INPUT_DELAY)
+            {
+                uint32_t pressed = b.tick - (NET_LOCKSTEP_INPUT_DELAY - 1);
+                matched &= inputs[0] == press(pressed, 0) && inputs[1] == press(pressed, 1);
+            }
+            netLockstepAdvance(&b);
+        }
+    }
+    CHECK(a.tick == target && b.tick == target);
+    CHECK(matched);
+}
+
+static void testStall()
+{
+    NetLockstep ls;
+    const uint16_t players[] = {PLAYER_A, PLAYER_B};
+    CHECK(netLockstepStart(&ls, players, 2, PLAYER_A, SESSION, IDLE));
+
+    // a lap round the ring with the peer's input arriving tick by tick, then the peer goes quiet
+    const uint8_t idle[] = {IDLE};
+    while (ls.tick < NET_LOCKSTEP_WINDOW + NET_LOCKSTEP_INPUT_DELAY)
+    {
+        netLockstepLocalInput(&ls, IDLE);
+        if (ls.tick >= NET_LOCKSTEP_INPUT_DELAY)
+            CHECK(netLockstepOnInputs(&ls, PLAYER_B, SESSION, (uint16_t)ls.tick, idle, 1));
+        CHECK(netLockstepReady(&ls));
+        netLockstepAdvance(&ls);
+    }
+    netLockstepLocalInput(&ls, IDLE);
+
+    // the peer's input for this tick never came; last lap's does not count
+    CHECK(!netLockstepReady(&ls));
+    CHECK(netLockstepMissing(&ls) == (1u << netLockstepSlot(&ls, PLAYER_B)));
+    CHECK(!netLockstepStalled(&ls, 1000));
+    CHECK(!netLockstepStalled(&ls, 1000 + NET_LOCKSTEP_STALL_MS - 1));
+    CHECK(netLockstepStalled(&ls, 1000 + NET_LOCKSTEP_STALL_MS));
+
+    // input past the ring would overwrite live ticks and is dropped; the missing one unblocks
+    const uint8_t late[] = {3};
+    CHECK(netLockstepOnInputs(&ls, PLAYER_B, SESSION, (uint16_t)(ls.tick + NET_LOCKSTEP_WINDOW), late, 1));
+    CHECK(!netLockstepReady(&ls));
+    CHECK(netLockstepOnInputs(&ls, PLAYER_B, SESSION, (uint16_t)ls.tick, late, 1));
+    CHECK(netLockstepReady(&ls));
+    CHECK(netLockstepMissing(&ls) == 0);
+    CHECK(netLockstepTickInputs(&ls)[netLockstepSlot(&ls, PLAYER_B)] == 3);
+    CHECK(!netLockstepStalled(&ls, 1000 + 2 * NET_LOCKSTEP_STALL_MS));
+}
+
+static void testChecksum()
+{
+    NetLockstep ls;
+    const uint16_t players[] = {PLAYER_A, PLAYER_B};
+    CHECK(netLockstepStart(&ls, players, 2, PLAYER_A, SESSION, IDLE));
+    ls.tick = NET_LOCKSTEP_CHECKSUM_TICKS;
+    CHECK(netLockstepChecksumDue(&ls));
+
+    netLockstepOnOwnChecksum(&ls, NET_LOCKSTEP_CHECKSUM_TICKS, 0x12345678u);
+    CHECK(netLockstepOnPeerChecksum(&ls, SESSION, NET_LOCKSTEP_CHECKSUM_TICKS, 0x12345678u));
+    CHECK(ls.desyncs == 0);
+    CHECK(!netLockstepOnPeerChecksum(&ls, SESSION, NET_LOCKSTEP_CHECKSUM_TICKS, 0x12345679u));
+    CHECK(ls.desyncs == 1);
+
+    // another session, or a tick not hashed here yet, is not a desync
+    CHECK(netLockstepOnPeerChecksum(&ls, SESSION + 1, NET_LOCKSTEP_CHECKSUM_TICKS, 1));
+    CHECK(netLockstepOnPeerChecksum(&ls, SESSION, 2 * NET_LOCKSTEP_CHECKSUM_TICKS, 1));
+    CHECK(ls.desyncs == 1);
+
+    // the hash ignores float noise below its quantum but not a real difference
+    Entity first("enemy", ENTITY_ENEMY, Vector(10.0f, 20.0f), Vector(10, 10), nullptr);
+    Entity second("enemy", ENTITY_ENEMY, Vector(10.01f, 20.0f), Vector(10, 10), nullptr);
+    const uint32_t seed = 2166136261u;
+    CHECK(netLockstepHash(seed, &first) == netLockstepHash(seed, &second));
+    second.position.x = 10.5f;
+    CHECK(netLockstepHash(seed, &first) != netLockstepHash(seed, &second));
+}
+
+void testLockstep()
+{
+    testStart();
+    testRingWrap();
+    testStall();
+    testChecksum();
+}
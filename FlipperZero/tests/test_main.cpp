@@ -0,0 +1,21 @@
+#include "test.hpp"
+
+int testFailures = 0;
+
+int main()
+{
+    testJson();
+    testHttp();
+    testProtocol();
+    testLockstep();
+    testInterpolation();
+    testLevel();
+    testLink();
+    if (testFailures > 0)
+    {
+        printf("%d check(s) failed\n", testFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,283 @@
+#include "test.hpp"
+#include "run/protocol.hpp"
+
+static NetWireState sampleWire(bool isPlayer)
+{
+    NetEntityState state = {};
+    state.id = isPlayer ? netPlayerId("tester") : 7;
+    state.seq = 42;
+    state.isPlayer = isPlayer;
+    state.fields = NET_FIELD_ALL;
+    state.position = Vector(123.25f, -45.5f);
+    state.direction = NetDirectionUp;
+    state.state = ENTITY_ATTACKING;
+    state.health = 87;
+    state.xp = 70000; // saturates to 65535 on the wire
+    state.attackElapsed = 1.3f;
+    NetWireState wire;
+    netWireStateFromEntityState(&state, &wire);
+    return wire;
+}
+
+static void testFullRecord()
+{
+    NetWireState wire = sampleWire(true);
+    uint8_t record[NET_ENTITY_STATE_SIZE];
+    CHECK(netWireStateEncode(&wire, record, sizeof(record) - 1) == 0);
+    size_t size = netWireStateEncode(&wire, record, sizeof(record));
+    CHECK(size == NET_ENTITY_STATE_SIZE);
+    CHECK(netRecordSize(record, size) == size);
+
+    // through the text armor and back
+    char text[NET_ENTITY_STATE_TEXT_SIZE];
+    CHECK(netRecordToText(record, size, text, sizeof(text)));
+    CHECK(text[0] == NET_BINARY_PREFIX);
+    CHECK(strlen(text) == NET_ENTITY_STATE_TEXT_SIZE - 1);
+    uint8_t decoded[NET_ENTITY_STATE_SIZE];
+    CHECK(netRecordFromText(text, strlen(text), decoded, sizeof(decoded)) == size);
+    CHECK(memcmp(record, decoded, size) == 0);
+
+    NetEntityState state;
+    CHECK(netEntityStateDecode(decoded, size, &state));
+    CHECK(state.id == wire.id);
+    CHECK(state.seq == 42);
+    CHECK(state.isPlayer);
+    CHECK(state.fields == NET_FIELD_ALL);
+    CHECK(state.position.x == 123.25f && state.position.y == -45.5f);
+    CHECK(state.direction == NetDirectionUp);
+    CHECK(state.state == ENTITY_ATTACKING);
+    CHECK(state.health == 87);
+    CHECK(state.xp == UINT16_MAX);
+
+    // decoding and quantizing again gives the same wire state
+    NetWireState again;
+    netWireStateFromEntityState(&state, &again);
+    CHECK(netWireStateDiff(&again, &wire) == 0);
+
+    // truncated records are refused
+    CHECK(netRecordSize(record, size - 1) == 0);
+    CHECK(!netEntityStateDecode(record, size - 1, &state));
+}
+
+static void testDeltaRecord()
+{
+    NetWireState previous = sampleWire(false);
+    NetWireState current = previous;
+    current.x += 4;
+    current.health -= 10;
+    uint8_t fields = netWireStateDiff(&current, &previous);
+    CHECK(fields == (NET_FIELD_X | NET_FIELD_HEALTH));
+
+    uint8_t record[NET_ENTITY_STATE_SIZE];
+    size_t size = netWireStateEncodeDelta(&current, fields, record, sizeof(record));
+    CHECK(size == 5 + 2 + 2);
+    CHECK(record[0] == NET_DELTA_VERSION);
+    CHECK(netRecordSize(record, size) == size);
+
+    uint16_t id;
+    uint8_t seq;
+    CHECK(netRecordHeader(record, size, &id, &seq));
+    CHECK(id == current.id && seq == current.seq);
+
+    NetEntityState state;
+    CHECK(netEntityStateDecode(record, size, &state));
+    CHECK(state.fields == fields);
+    CHECK(!state.isPlayer);
+    CHECK(state.position.x == (current.x * 0.25f));
+    CHECK(state.health == current.health);
+
+    // every field changed: the full record is the shorter encoding
+    CHECK(netWireStateEncodeDelta(&current, NET_FIELD_ALL, record, sizeof(record)) == NET_ENTITY_STATE_SIZE);
+    CHECK(record[0] == NET_STATE_VERSION);
+}
+
+static void testBatch()
+{
+    // a level record and two entity records back to back, as sendStateBatches packs them
+    uint8_t batch[NET_BATCH_MAX_BYTES];
+    size_t len = netLevelEncode(3, batch, sizeof(batch));
+    NetWireState player = sampleWire(true);
+    NetWireState enemy = sampleWire(false);
+    len += netWireStateEncode(&player, batch + len, sizeof(batch) - len);
+    len += netWireStateEncodeDelta(&enemy, NET_FIELD_FLAGS, batch + len, sizeof(batch) - len);
+    CHECK(len == NET_LEVEL_RECORD_SIZE + NET_ENTITY_STATE_SIZE + 6);
+
+    char text[NET_MAX_FRAME_SIZE + 1];
+    CHECK(netRecordToText(batch, len, text, sizeof(text)));
+    uint8_t decoded[NET_BATCH_MAX_BYTES];
+    size_t decodedLen = netRecordFromText(text, strlen(text), decoded, sizeof(decoded));
+    CHECK(decodedLen == len);
+
+    // walk the records the way processBinaryMessage does
+    size_t pos = 0;
+    int records = 0;
+    while (pos < decodedLen)
+    {
+        size_t size = netRecordSize(decoded + pos, decodedLen - pos);
+        CHECK(size > 0);
+        if (size == 0)
+            break;
+        pos += size;
+        records++;
+    }
+    CHECK(records == 3);
+    CHECK(decoded[0] == NET_LEVEL_VERSION && decoded[1] == 3);
+}
+
+static void testBase64()
+{
+    const uint8_t data[] = {0x00, 0xFF, 0x10, 0x80, 0x7F};
+    char text[16];
+    for (size_t len = 1; len <= sizeof(data); len++)
+    {
+        CHECK(netBase64Encode(data, len, text, sizeof(text)) == NET_BASE64_SIZE(len));
+        uint8_t out[sizeof(data)];
+        CHECK(netBase64Decode(text, strlen(text), out, sizeof(out)) == len);
+        CHECK(memcmp(out, data, len) == 0);
+    }
+    uint8_t out[8];
+    CHECK(netBase64Decode("AP8=", 4, out, sizeof(out)) == 2); // padding from other encoders
+    CHECK(netBase64Decode("A*8", 3, out, sizeof(out)) == 0);
+    CHECK(netBase64Decode("A", 1, out, sizeof(out)) == 0);
+    CHECK(netBase64Encode(data, sizeof(data), text, NET_BASE64_SIZE(sizeof(data))) == 0); // no room for the NUL
+}
+
+static void testSeqWrap()
+{
+    // 0 means "none yet" and is never produced
+    CHECK(netSeqNext(1) == 2);
+    CHECK(netSeqNext(254) == 255);
+    CHECK(netSeqNext(255) == 1);
+    uint8_t seq = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        seq = netSeqNext(seq);
+        CHECK(seq != 0);
+    }
+
+    // nothing applied yet: everything is new
+    CHECK(!netSeqIsStale(0, 0));
+    CHECK(!netSeqIsStale(0, 200));
+
+    // duplicates and late updates inside the window are stale, newer ones are not
+    CHECK(netSeqIsStale(100, 100));
+    CHECK(netSeqIsStale(100, 99));
+    CHECK(netSeqIsStale(100, 100 - NET_SEQ_REORDER_WINDOW + 1));
+    CHECK(!netSeqIsStale(100, 100 - NET_SEQ_REORDER_WINDOW)); // far behind: the sender restarted
+    CHECK(!netSeqIsStale(100, 101));
+
+    // across the wrap
+    CHECK(!netSeqIsStale(255, netSeqNext(255)));
+    CHECK(netSeqIsStale(1, 255));
+    CHECK(netSeqIsStale(3, 250));
+    CHECK(!netSeqIsStale(250, 3));
+}
+
+static void testInputRecord()
+{
+    // odd and even counts: the last nibble of an odd batch is padding
+    for (uint8_t count = 1; count <= NET_INPUT_MAX_TICKS; count += 5)
+    {
+        NetInputBatch batch = {};
+        batch.playerId = netPlayerId("tester");
+        batch.session = 9;
+        batch.firstTick = 0xFFFE; // wraps inside the batch
+        batch.count = count;
+        for (uint8_t i = 0; i < count; i++)
+            batch.inputs[i] = (uint8_t)((i * 7 + 3) & 0x0F);
+
+        uint8_t record[7 + NET_INPUT_MAX_TICKS / 2];
+        size_t size = netInputBatchEncode(&batch, record, sizeof(record));
+        CHECK(size == 7 + (count + 1) / 2u);
+        CHECK(netInputBatchEncode(&batch, record, size - 1) == 0);
+        CHECK(netRecordSize(record, size) == size);
+
+        NetInputBatch decoded;
+        CHECK(netInputBatchDecode(record, size, &decoded));
+        CHECK(decoded.playerId == batch.playerId && decoded.session == 9 && decoded.firstTick == 0xFFFE);
+        CHECK(decoded.count == count);
+        CHECK(memcmp(decoded.inputs, batch.inputs, count) == 0);
+
+        // every truncation is refused
+        for (size_t len = 0; len < size; len++)
+        {
+            CHECK(!netInputBatchDecode(record, len, &decoded));
+            CHECK(netRecordSize(record, len) == 0);
+        }
+    }
+
+    NetInputBatch empty = {};
+    uint8_t record[16];
+    CHECK(netInputBatchEncode(&empty, record, sizeof(record)) == 0);
+    empty.count = NET_INPUT_MAX_TICKS + 1;
+    CHECK(netInputBatchEncode(&empty, record, sizeof(record)) == 0);
+}
+
+static void testChecksumRecord()
+{
+    NetChecksum checksum = {};
+    checksum.playerId = 0xBEEF;
+    checksum.session = 3;
+    checksum.tick = 640;
+    checksum.value = 0xDEADBEEFu;
+    uint8_t record[NET_CHECKSUM_RECORD_SIZE];
+    CHECK(netChecksumEncode(&checksum, record, sizeof(record) - 1) == 0);
+    CHECK(netChecksumEncode(&checksum, record, sizeof(record)) == NET_CHECKSUM_RECORD_SIZE);
+    CHECK(netRecordSize(record, sizeof(record)) == NET_CHECKSUM_RECORD_SIZE);
+
+    NetChecksum decoded;
+    CHECK(netChecksumDecode(record, sizeof(record), &decoded));
+    CHECK(decoded.playerId == 0xBEEF && decoded.session == 3 && decoded.tick == 640);
+    CHECK(decoded.value == 0xDEADBEEFu);
+    for (size_t len = 0; len < sizeof(record); len++)
+        CHECK(!netChecksumDecode(record, len, &decoded));
+    record[0] = NET_INPUT_VERSION;
+    CHECK(!netChecksumDecode(record, sizeof(record), &decoded));
+}
+
+static void testRosterRecord()
+{
+    NetRoster roster = {};
+    roster.session = 200;
+    roster.levelIndex = 2;
+    roster.count = NET_ROSTER_MAX;
+    for (uint8_t i = 0; i < roster.count; i++)
+    {
+        roster.players[i] = (uint16_t)(1000 + i * 311);
+        roster.xp[i] = 70000u * (i + 1); // past 16 bits
+    }
+    uint8_t record[4 + NET_ROSTER_MAX * 6];
+    size_t size = netRosterEncode(&roster, record, sizeof(record));
+    CHECK(size == sizeof(record));
+    CHECK(netRosterEncode(&roster, record, size - 1) == 0);
+    CHECK(netRecordSize(record, size) == size);
+
+    NetRoster decoded;
+    CHECK(netRosterDecode(record, size, &decoded));
+    CHECK(decoded.session == 200 && decoded.levelIndex == 2 && decoded.count == NET_ROSTER_MAX);
+    for (uint8_t i = 0; i < roster.count; i++)
+        CHECK(decoded.players[i] == roster.players[i] && decoded.xp[i] == roster.xp[i]);
+    for (size_t len = 0; len < size; len++)
+    {
+        CHECK(!netRosterDecode(record, len, &decoded));
+        CHECK(netRecordSize(record, len) == 0);
+    }
+
+    // a count the record cannot hold is malformed
+    record[3] = NET_ROSTER_MAX + 1;
+    CHECK(!netRosterDecode(record, sizeof(record), &decoded));
+    record[3] = 0;
+    CHECK(!netRosterDecode(record, sizeof(record), &decoded));
+}
+
+void testProtocol()
+{
+    testFullRecord();
+    testDeltaRecord();
+    testInputRecord();
+    testChecksumRecord();
+    testRosterRecord();
+    testBatch();
+    testBase64();
+    testSeqWrap();
+}
@@ -2,6 +2,7 @@
 #include <ArduinoJson.h>
 #include "assets.h"
 #include "player.h"
+#include "registry.h"
 
 typedef enum
 {
@@ -27,61 +28,127 @@ typedef enum
     ICON_ID_ROCK_LARGE,           // Large rock
     ICON_ID_ROCK_MEDIUM,          // Medium rock
     ICON_ID_ROCK_SMALL,           // Small rock
+    ICON_ID_COUNT,                // Number of registered icons
 } IconID;
 
 typedef struct
 {
     IconID id;
+    const char *name;
     uint8_t *data;
     Vector size;
 } IconContext;
 
-static IconContext icon_context_get(const char *name)
+// Icon registry indexed by IconID; level data may reference an icon by name or by its ID
+static const IconContext icon_registry[ICON_ID_COUNT] = {
+    {ICON_ID_HOUSE, "house", icon_house_48x32px, Vector(48, 32)},
+    {ICON_ID_MAN, "man", icon_man_7x16, Vector(7, 16)},
+    {ICON_ID_PLANT, "plant", icon_plant_16x16, Vector(16, 16)},
+    {ICON_ID_TREE, "tree", icon_tree_16x16, Vector(16, 16)},
+    {ICON_ID_WOMAN, "woman", icon_woman_9x16, Vector(9, 16)},
+    {ICON_ID_FENCE, "fence", icon_fence_16x8px, Vector(16, 8)},
+    {ICON_ID_FENCE_END, "fence_end", icon_fence_end_16x8px, Vector(16, 8)},
+    {ICON_ID_FENCE_VERTICAL_END, "fence_vertical_end", icon_fence_vertical_end_6x8px, Vector(6, 8)},
+    {ICON_ID_FENCE_VERTICAL_START, "fence_vertical_start", icon_fence_vertical_start_6x15px, Vector(6, 15)},
+    {ICON_ID_FLOWER, "flower", icon_flower_16x16, Vector(16, 16)},
+    {ICON_ID_LAKE_BOTTOM, "lake_bottom", icon_lake_bottom_31x12px, Vector(31, 12)},
+    {ICON_ID_LAKE_BOTTOM_LEFT, "lake_bottom_left", icon_lake_bottom_left_24x22px, Vector(24, 22)},
+    {ICON_ID_LAKE_BOTTOM_RIGHT, "lake_bottom_right", icon_lake_bottom_right_24x22px, Vector(24, 22)},
+    {ICON_ID_LAKE_LEFT, "lake_left", icon_lake_left_11x31px, Vector(11, 31)},
+    {ICON_ID_LAKE_RIGHT, "lake_right", icon_lake_right_11x31, Vector(11, 31)},
+    {ICON_ID_LAKE_TOP, "lake_top", icon_lake_top_31x12px, Vector(31, 12)},
+    {ICON_ID_LAKE_TOP_LEFT, "lake_top_left", icon_lake_top_left_24x22px, Vector(24, 22)},
+    {ICON_ID_LAKE_TOP_RIGHT, "lake_top_right", icon_lake_top_right_24x22px, Vector(24, 22)},
+    {ICON_ID_ROCK_LARGE, "rock_large", icon_rock_large_18x19px, Vector(18, 19)},
+    {ICON_ID_ROCK_MEDIUM, "rock_medium", icon_rock_medium_16x14px, Vector(16, 14)},
+    {ICON_ID_ROCK_SMALL, "rock_small", icon_rock_small_10x8px, Vector(10, 8)},
+};
+
+static const IconContext icon_none = {ICON_ID_NONE, NULL, NULL, Vector(0, 0)};
+
+static IconID icon_id_get(const char *name)
+{
+    if (name == NULL)
+        return ICON_ID_NONE;
+
+    IconID id;
+    switch (asset_hash(name))
+    {
+    case asset_hash("house"):
+        id = ICON_ID_HOUSE;
+        break;
+    case asset_hash("man"):
+        id = ICON_ID_MAN;
+        break;
+    case asset_hash("plant"):
+        id = ICON_ID_PLANT;
+        break;
+    case asset_hash("tree"):
+        id = ICON_ID_TREE;
+        break;
+    case asset_hash("woman"):
+        id = ICON_ID_WOMAN;
+        break;
+    case asset_hash("fence"):
+        id = ICON_ID_FENCE;
+        break;
+    case asset_hash("fence_end"):
+        id = ICON_ID_FENCE_END;
+        break;
+    case asset_hash("fence_vertical_end"):
+        id = ICON_ID_FENCE_VERTICAL_END;
+        break;
+    case asset_hash("fence_vertical_start"):
+        id = ICON_ID_FENCE_VERTICAL_START;
+        break;
+    case asset_hash("flower"):
+        id = ICON_ID_FLOWER;
+        break;
+    case asset_hash("lake_bottom"):
+        id = ICON_ID_LAKE_BOTTOM;
+        break;
+    case asset_hash("lake_bottom_left"):
+        id = ICON_ID_LAKE_BOTTOM_LEFT;
+        break;
+    case asset_hash("lake_bottom_right"):
+        id = ICON_ID_LAKE_BOTTOM_RIGHT;
+        break;
+    case asset_hash("lake_left"):
+        id = ICON_ID_LAKE_LEFT;
+        break;
+    case asset_hash("lake_right"):
+        id = ICON_ID_LAKE_RIGHT;
+        break;
+    case asset_hash("lake_top"):
+        id = ICON_ID_LAKE_TOP;
+        break;
+    case asset_hash("lake_top_left"):
+        id = ICON_ID_LAKE_TOP_LEFT;
+        break;
+    case asset_hash("lake_top_right"):
+        id = ICON_ID_LAKE_TOP_RIGHT;
+        break;
+    case asset_hash("rock_large"):
+        id = ICON_ID_ROCK_LARGE;
+        break;
+    case asset_hash("rock_medium"):
+        id = ICON_ID_ROCK_MEDIUM;
+        break;
+    case asset_hash("rock_small"):
+        id = ICON_ID_ROCK_SMALL;
+        break;
+    default:
+        return ICON_ID_NONE;
+    }
+
+    return asset_name_matches(name, icon_registry[id].name) ? id : ICON_ID_NONE;
+}
+
+static const IconContext &icon_context_get(IconID id)
 {
-    if (strcmp(name, "tree") == 0)
-        return {ICON_ID_TREE, icon_tree_16x16, Vector(16, 16)};
-    if (strcmp(name, "fence") == 0)
-        return {ICON_ID_FENCE, icon_fence_16x8px, Vector(16, 8)};
-    if (strcmp(name, "fence_end") == 0)
-        return {ICON_ID_FENCE_END, icon_fence_end_16x8px, Vector(16, 8)};
-    if (strcmp(name, "fence_vertical_end") == 0)
-        return {ICON_ID_FENCE_VERTICAL_END, icon_fence_vertical_end_6x8px, Vector(6, 8)};
-    if (strcmp(name, "fence_vertical_start") == 0)
-        return {ICON_ID_FENCE_VERTICAL_START, icon_fence_vertical_start_6x15px, Vector(6, 15)};
-    if (strcmp(name, "rock_small") == 0)
-        return {ICON_ID_ROCK_SMALL, icon_rock_small_10x8px, Vector(10, 8)};
-    if (strcmp(name, "rock_medium") == 0)
-        return {ICON_ID_ROCK_MEDIUM, icon_rock_medium_16x14px, Vector(16, 14)};
-    if (strcmp(name, "rock_large") == 0)
-        return {ICON_ID_ROCK_LARGE, icon_rock_large_18x19px, Vector(18, 19)};
-    if (strcmp(name, "flower") == 0)
-        return {ICON_ID_FLOWER, icon_flower_16x16, Vector(16, 16)};
-    if (strcmp(name, "plant") == 0)
-        return {ICON_ID_PLANT, icon_plant_16x16, Vector(16, 16)};
-    if (strcmp(name, "man") == 0)
-        return {ICON_ID_MAN, icon_man_7x16, Vector(7, 16)};
-    if (strcmp(name, "woman") == 0)
-        return {ICON_ID_WOMAN, icon_woman_9x16, Vector(9, 16)};
-    if (strcmp(name, "lake_bottom") == 0)
-        return {ICON_ID_LAKE_BOTTOM, icon_lake_bottom_31x12px, Vector(31, 12)};
-    if (strcmp(name, "lake_bottom_left") == 0)
-        return {ICON_ID_LAKE_BOTTOM_LEFT, icon_lake_bottom_left_24x22px, Vector(24, 22)};
-    if (strcmp(name, "lake_bottom_right") == 0)
-        return {ICON_ID_LAKE_BOTTOM_RIGHT, icon_lake_bottom_right_24x22px, Vector(24, 22)};
-    if (strcmp(name, "lake_left") == 0)
-        return {ICON_ID_LAKE_LEFT, icon_lake_left_11x31px, Vector(11, 31)};
-    if (strcmp(name, "lake_right") == 0)
-        return {ICON_ID_LAKE_RIGHT, icon_lake_right_11x31, Vector(11, 31)};
-    if (strcmp(name, "lake_top") == 0)
-        return {ICON_ID_LAKE_TOP, icon_lake_top_31x12px, Vector(31, 12)};
-    if (strcmp(name, "lake_top_left") == 0)
-        return {ICON_ID_LAKE_TOP_LEFT, icon_lake_top_left_24x22px, Vector(24, 22)};
-    if (strcmp(name, "lake_top_right") == 0)
-        return {ICON_ID_LAKE_TOP_RIGHT, icon_lake_top_right_24x22px, Vector(24, 22)};
-    if (strcmp(name, "house") == 0)
-        return {ICON_ID_HOUSE, icon_house_48x32px, Vector(48, 32)};
-
-    return {ICON_ID_NONE, NULL, Vector(0, 0)};
+    if (id <= ICON_ID_NONE || id >= ICON_ID_COUNT)
+        return icon_none;
+    return icon_registry[id];
 }
 
 static void icon_collision(Entity *self, Entity *other, Game *game)
@@ -92,10 +159,10 @@ static void icon_collision(Entity *self, Entity *other, Game *game)
     }
 }
 
-static void icon_spawn(Level *level, const char *name, Vector pos)
+static void icon_spawn(Level *level, IconID id, Vector pos)
 {
     // Get the icon context
-    IconContext icon = icon_context_get(name);
+    const IconContext &icon = icon_context_get(id);
 
     // Check if the icon is valid
     if (icon.data == NULL)
@@ -104,7 +171,7 @@ static void icon_spawn(Level *level, const char *name, Vector pos)
     }
 
     // Retrieve shared Image instance
-    Image *sharedImage = ImageManager::getInstance().getImage(name, icon.data, icon.size, true);
+    Image *sharedImage = ImageManager::getInstance().getImage(icon.name, icon.data, icon.size, true);
     if (sharedImage == nullptr)
     {
         return;
@@ -133,7 +200,7 @@ static void icon_spawn(Level *level, const char *name, Vector pos)
     level->entity_add(newEntity);
 }
 
-static void icon_spawn_line(Level *level, const char *name, Vector pos, int amount, bool horizontal, int spacing = 17)
+static void icon_spawn_line(Level *level, IconID id, Vector pos, int amount, bool horizontal, int spacing = 17)
 {
     for (int i = 0; i < amount; i++)
     {
@@ -143,7 +210,7 @@ static void icon_spawn_line(Level *level, const char *name, Vector pos, int amou
         else
             newPos.y += i * spacing;
 
-        icon_spawn(level, name, newPos);
+        icon_spawn(level, id, newPos);
     }
 }
 
@@ -168,9 +235,11 @@ void icon_spawn_json(Level *level, const char *json)
 
     // Loop through the json data
     int index = 0;
-    while (doc["json_data"][index]["icon"])
+    while (!doc["json_data"][index]["icon"].isNull())
     {
-        const char *icon = doc["json_data"][index]["icon"];
+        // "icon" is either a registry ID or an icon name
+        JsonVariant icon_value = doc["json_data"][index]["icon"];
+        IconID icon = icon_value.is<int>() ? (IconID)icon_value.as<int>() : icon_id_get(icon_value.as<const char *>());
         float x = doc["json_data"][index]["x"];
         float y = doc["json_data"][index]["y"];
         int amount = doc["json_data"][index]["amount"];
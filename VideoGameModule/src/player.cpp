@@ -1,33 +1,76 @@
 #include <ArduinoJson.h>
 #include "player.h"
 #include "sprites.h"
+#include "registry.h"
+
+typedef enum
+{
+    PLAYER_ID_NONE = -1,  // None
+    PLAYER_ID_NAKED = 0,  // Naked player
+    PLAYER_ID_SWORD,      // Player with sword
+    PLAYER_ID_AXE,        // Player with axe
+    PLAYER_ID_BOW,        // Player with bow
+    PLAYER_ID_CYCLOPS,    // Cyclops enemy
+    PLAYER_ID_GHOST,      // Ghost enemy
+    PLAYER_ID_OGRE,       // Ogre enemy
+    PLAYER_ID_COUNT,      // Number of registered players/enemies
+} PlayerID;
+
 typedef struct
 {
     const char *name;
-    uint8_t *data;
+    uint8_t *left;
+    uint8_t *right;
     Vector size;
 } PlayerContext;
 
-static PlayerContext player_context_get(const char *name, bool is_left)
-{
+// Player/enemy registry indexed by PlayerID
+static const PlayerContext player_registry[PLAYER_ID_COUNT] = {
     // players
-    if (strcmp(name, "naked") == 0)
-        return {name, is_left ? player_left_naked_10x10px : player_right_naked_10x10px, Vector(10, 10)};
-    if (strcmp(name, "sword") == 0)
-        return {name, is_left ? player_left_sword_15x11px : player_right_sword_15x11px, Vector(15, 11)};
-    if (strcmp(name, "axe") == 0)
-        return {name, is_left ? player_left_axe_15x11px : player_right_axe_15x11px, Vector(15, 11)};
-    if (strcmp(name, "bow") == 0)
-        return {name, is_left ? player_left_bow_13x11px : player_right_bow_13x11px, Vector(13, 11)};
+    {"naked", player_left_naked_10x10px, player_right_naked_10x10px, Vector(10, 10)},
+    {"sword", player_left_sword_15x11px, player_right_sword_15x11px, Vector(15, 11)},
+    {"axe", player_left_axe_15x11px, player_right_axe_15x11px, Vector(15, 11)},
+    {"bow", player_left_bow_13x11px, player_right_bow_13x11px, Vector(13, 11)},
     // enemies
-    if (strcmp(name, "cyclops") == 0)
-        return {name, is_left ? enemy_left_cyclops_10x11px : enemy_right_cyclops_10x11px, Vector(10, 11)};
-    if (strcmp(name, "ghost") == 0)
-        return {name, is_left ? enemy_left_ghost_15x15px : enemy_right_ghost_15x15px, Vector(15, 15)};
-    if (strcmp(name, "ogre") == 0)
-        return {name, is_left ? enemy_left_ogre_10x13px : enemy_right_ogre_10x13px, Vector(10, 13)};
-
-    return {NULL, NULL, Vector(0, 0)};
+    {"cyclops", enemy_left_cyclops_10x11px, enemy_right_cyclops_10x11px, Vector(10, 11)},
+    {"ghost", enemy_left_ghost_15x15px, enemy_right_ghost_15x15px, Vector(15, 15)},
+    {"ogre", enemy_left_ogre_10x13px, enemy_right_ogre_10x13px, Vector(10, 13)},
+};
+
+static const PlayerContext *player_context_get(const char *name)
+{
+    if (name == NULL)
+        return NULL;
+
+    PlayerID id;
+    switch (asset_hash(name))
+    {
+    case asset_hash("naked"):
+        id = PLAYER_ID_NAKED;
+        break;
+    case asset_hash("sword"):
+        id = PLAYER_ID_SWORD;
+        break;
+    case asset_hash("axe"):
+        id = PLAYER_ID_AXE;
+        break;
+    case asset_hash("bow"):
+        id = PLAYER_ID_BOW;
+        break;
+    case asset_hash("cyclops"):
+        id = PLAYER_ID_CYCLOPS;
+        break;
+    case asset_hash("ghost"):
+        id = PLAYER_ID_GHOST;
+        break;
+    case asset_hash("ogre"):
+        id = PLAYER_ID_OGRE;
+        break;
+    default:
+        return NULL;
+    }
+
+    return asset_name_matches(name, player_registry[id].name) ? &player_registry[id] : NULL;
 }
 
 static void enemy_update(Entity *self, Game *game)
@@ -319,14 +362,13 @@ static void enemy_spawn(
     float health)
 {
     // Get the enemy context
-    PlayerContext enemy_left = player_context_get(name, true);
-    PlayerContext enemy_right = player_context_get(name, false);
+    const PlayerContext *enemy = player_context_get(name);
 
     // check if enemy context is valid
-    if (enemy_left.data != NULL && enemy_right.data != NULL)
+    if (enemy != NULL)
     {
         // Create the enemy entity
-        Entity *entity = new Entity(name, ENTITY_ENEMY, start_position, enemy_left.size, enemy_left.data, enemy_left.data, enemy_right.data, NULL, NULL, enemy_update, enemy_render, enemy_collision, true);
+        Entity *entity = new Entity(name, ENTITY_ENEMY, start_position, enemy->size, enemy->left, enemy->left, enemy->right, NULL, NULL, enemy_update, enemy_render, enemy_collision, true);
         entity->direction = direction;
         entity->start_position = start_position;
         entity->end_position = end_position;
@@ -528,14 +570,13 @@ static void player_render(Entity *self, Draw *draw, Game *game)
 void player_spawn(Level *level, const char *name, Vector position)
 {
     // Get the player context
-    PlayerContext player_left = player_context_get(name, true);
-    PlayerContext player_right = player_context_get(name, false);
+    const PlayerContext *context = player_context_get(name);
 
     // check if player context is valid
-    if (player_left.data != NULL && player_right.data != NULL)
+    if (context != NULL)
     {
         // Create the player entity
-        Entity *player = new Entity("Player", ENTITY_PLAYER, position, player_left.size, player_left.data, player_left.data, player_right.data, NULL, NULL, player_update, player_render, NULL, true);
+        Entity *player = new Entity("Player", ENTITY_PLAYER, position, context->size, context->left, context->left, context->right, NULL, NULL, player_update, player_render, NULL, true);
         player->level = 1;
         player->health = 100;
         player->max_health = 100;
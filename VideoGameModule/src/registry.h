@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// FNV-1a hash used by the asset registries so name lookups can switch on a compile-time constant
+constexpr uint32_t asset_hash(const char *name, uint32_t hash = 2166136261u)
+{
+    return *name ? asset_hash(name + 1, (hash ^ (uint8_t)*name) * 16777619u) : hash;
+}
+
+// A hash match only picks a candidate; different names can share a hash, so confirm it by name
+inline bool asset_name_matches(const char *name, const char *registered)
+{
+    return strcmp(name, registered) == 0;
+}